@@ -2,10 +2,24 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
 #include <string.h>
-#include <ctype.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/uio.h>
 #include <sys/stat.h>
 #include <unistd.h>
+#include <poll.h>
+#include <time.h>
+#ifdef __linux__
+#include <sys/inotify.h>
+#endif
+#include <pthread.h>
+#include <dlfcn.h>
+#include <sys/resource.h>
 
 #define throw(error) do { \
     fprintf(stderr, #error ":\n"); \
@@ -14,16 +28,59 @@
 
 char const* MAIN_FILE_NAME = "main.ind";
 
-typedef struct Parser {
-    FILE* pFile;
-    size_t lineNumber;
-    size_t columnNumber;
-    int next;
-} Parser;
-bool createParserFromFile(char const* pFileName, Parser* pParser);
-void destroyParser(Parser parser);
-void parser_advance(Parser* pParser);
-void parser_skipWhitespace(Parser* pParser);
+typedef enum EvaluationEngine {
+    TREE_ENGINE,
+    BYTECODE_ENGINE
+} EvaluationEngine;
+typedef struct Options {
+    char const* pLoadImageFileName;
+    char const* pSaveImageFileName;
+    bool isImageTrusted;
+    char const* pCacheDirectoryName;
+    bool isStatisticsEnabled;
+    bool isWatchEnabled;
+    long prefetchThreadCount;
+    long memoEntryLimit;
+    long maximumDepth;
+    EvaluationEngine engine;
+    bool isLazy;
+    char const* pEmitNativeFileName;
+    char const* pLoadNativeFileName;
+    long jitThreshold;
+    char const* pOutputFileName;
+} Options;
+bool parseOptions(int argumentCount, char** pArguments, Options* pOptions);
+
+typedef enum CharacterFlag {
+    WORD_CHARACTER = 1,
+    SPACE_CHARACTER = 2
+} CharacterFlag;
+unsigned char const CHARACTER_FLAGS[256] = {
+    ['0' ... '9'] = WORD_CHARACTER,
+    ['A' ... 'Z'] = WORD_CHARACTER,
+    ['a' ... 'z'] = WORD_CHARACTER,
+    ['_'] = WORD_CHARACTER,
+    ['+'] = WORD_CHARACTER,
+    ['-'] = WORD_CHARACTER,
+    ['*'] = WORD_CHARACTER,
+    ['/'] = WORD_CHARACTER,
+    ['%'] = WORD_CHARACTER,
+    ['^'] = WORD_CHARACTER,
+    ['&'] = WORD_CHARACTER,
+    ['='] = WORD_CHARACTER,
+    ['\''] = WORD_CHARACTER,
+    ['"'] = WORD_CHARACTER,
+    ['\\'] = WORD_CHARACTER,
+    [','] = WORD_CHARACTER,
+    ['`'] = WORD_CHARACTER,
+    [' '] = SPACE_CHARACTER,
+    ['\t'] = SPACE_CHARACTER,
+    ['\n'] = SPACE_CHARACTER,
+    ['\v'] = SPACE_CHARACTER,
+    ['\f'] = SPACE_CHARACTER,
+    ['\r'] = SPACE_CHARACTER
+};
+bool isWordCharacter(int character);
 
 typedef struct String {
     size_t length;
@@ -32,24 +89,228 @@ typedef struct String {
 bool createStringFromCString(char const* pCString, String* pString);
 void destroyString(String string);
 bool string_equals(String string, String other);
-bool string_print(String string);
-bool parser_parseWord(Parser* pParser, String* pWord);
-bool parser_parseName(Parser* pParser, String* pName);
+bool string_duplicate(String string, String* pResult);
+uint64_t string_hash(String string);
+uint64_t hash_combine(uint64_t hash, uint64_t value);
+
+typedef enum OutputKind {
+    DESCRIPTOR_OUTPUT,
+    MEMORY_OUTPUT
+} OutputKind;
+typedef struct Output {
+    OutputKind kind;
+    int descriptor;
+    bool isInteractive;
+    size_t blockCount;
+    size_t allocatedBlockCount;
+    size_t blockCapacity;
+    struct iovec* pBlocks;
+} Output;
+Output output;
+size_t const OUTPUT_BLOCK_SIZE = 65536;
+size_t const OUTPUT_BLOCK_LIMIT = 16;
+bool createDescriptorOutput(int descriptor, Output* pOutput);
+bool createFileOutput(char const* pFileName, Output* pOutput);
+bool createMemoryOutput(Output* pOutput);
+void destroyOutput(Output outputState);
+bool output_nextBlock(Output* pOutput);
+bool output_write(Output* pOutput, void const* pData, size_t length);
+bool output_writeCharacter(Output* pOutput, char character);
+bool output_format(Output* pOutput, char const* pFormat, ...);
+bool output_flush(Output* pOutput);
+bool output_sync(Output* pOutput);
+bool output_getString(Output outputState, String* pString);
+bool string_print(String string, Output* pOutput);
+
+typedef struct ArenaChunk {
+    char* pData;
+    size_t capacity;
+} ArenaChunk;
+typedef struct Arena {
+    size_t chunkCount;
+    size_t chunkCapacity;
+    ArenaChunk* pChunks;
+    size_t offset;
+    ArenaChunk spareChunk;
+} Arena;
+typedef struct ArenaMark {
+    size_t chunkCount;
+    size_t offset;
+} ArenaMark;
+Arena const EMPTY_ARENA = {
+    .chunkCount = 0,
+    .chunkCapacity = 0,
+    .pChunks = NULL,
+    .offset = 0,
+    .spareChunk = {
+        .pData = NULL,
+        .capacity = 0
+    }
+};
+size_t const ARENA_CHUNK_SIZE = 65536;
+void destroyArena(Arena arena);
+bool arena_allocate(Arena* pArena, size_t size, void** ppData);
+bool arena_contains(Arena arena, void const* pData);
+ArenaMark arena_mark(Arena arena);
+void arena_rewind(Arena* pArena, ArenaMark mark);
+void arena_reset(Arena* pArena);
+typedef struct NodeTable {
+    size_t nodeCount;
+    size_t capacity;
+    uint64_t* pHashes;
+    void** ppNodes;
+} NodeTable;
+NodeTable const EMPTY_NODE_TABLE = {
+    .nodeCount = 0,
+    .capacity = 0,
+    .pHashes = NULL,
+    .ppNodes = NULL
+};
+void destroyNodeTable(NodeTable table);
+bool nodeTable_grow(NodeTable* pTable);
+bool nodeTable_insert(NodeTable* pTable, uint64_t hash, void* pNode);
+void nodeTable_retain(NodeTable* pTable, Arena arena);
+typedef struct InstantiationTable {
+    size_t instantiationCount;
+    size_t capacity;
+    struct Instantiation* pInstantiations;
+} InstantiationTable;
+InstantiationTable const EMPTY_INSTANTIATION_TABLE = {
+    .instantiationCount = 0,
+    .capacity = 0,
+    .pInstantiations = NULL
+};
+void destroyInstantiationTable(InstantiationTable table);
+typedef struct Region {
+    Arena arena;
+    char* pImage;
+    size_t imageLength;
+    NodeTable constructionTable;
+    NodeTable destructionTable;
+    InstantiationTable instantiationTable;
+    struct Region const* pParent;
+} Region;
+Region const EMPTY_REGION = {
+    .arena = {
+        .chunkCount = 0,
+        .chunkCapacity = 0,
+        .pChunks = NULL,
+        .offset = 0,
+        .spareChunk = {
+            .pData = NULL,
+            .capacity = 0
+        }
+    },
+    .pImage = NULL,
+    .imageLength = 0,
+    .constructionTable = {
+        .nodeCount = 0,
+        .capacity = 0,
+        .pHashes = NULL,
+        .ppNodes = NULL
+    },
+    .destructionTable = {
+        .nodeCount = 0,
+        .capacity = 0,
+        .pHashes = NULL,
+        .ppNodes = NULL
+    },
+    .instantiationTable = {
+        .instantiationCount = 0,
+        .capacity = 0,
+        .pInstantiations = NULL
+    },
+    .pParent = NULL
+};
+void destroyRegion(Region region);
+void region_reset(Region* pRegion);
+void region_prune(Region* pRegion);
+void region_rewind(Region* pRegion, ArenaMark mark);
+bool region_owns(Region const* pRegion, void const* pData);
+
+typedef struct Directory {
+    int descriptor;
+    String path;
+} Directory;
+Directory const CURRENT_DIRECTORY = {
+    .descriptor = AT_FDCWD,
+    .path = {
+        .length = 0,
+        .pData = NULL
+    }
+};
+bool createDirectory(Directory parent, char const* pName, Directory* pDirectory);
+void destroyDirectory(Directory directory);
+bool directory_join(Directory directory, char const* pName, String* pPath);
+bool directory_resolve(Directory directory, char const* pName, char** ppPath);
+
+typedef struct Parser {
+    char* pData;
+    size_t length;
+    bool isMapped;
+    size_t offset;
+    int next;
+    Directory directory;
+} Parser;
+bool file_load(int fileDescriptor, size_t length, char** ppData, bool* pIsMapped);
+bool createParserFromFile(Directory directory, char const* pFileName, Parser* pParser);
+void destroyParser(Parser parser);
+void parser_advance(Parser* pParser);
+void parser_skipWhitespace(Parser* pParser);
+void parser_skipLine(Parser* pParser);
+void parser_getLocation(Parser parser, size_t* pLineNumber, size_t* pColumnNumber);
+void parser_seekFailure(Parser* pParser);
+
+typedef size_t Symbol;
+typedef struct SymbolTable {
+    size_t symbolCount;
+    size_t symbolCapacity;
+    String* pStrings;
+    uint64_t* pHashes;
+    size_t bucketCount;
+    Symbol* pBuckets;
+    size_t bufferLength;
+    char* pBuffer;
+} SymbolTable;
+Symbol const EMPTY_SYMBOL = 0;
+SymbolTable symbols;
+bool createSymbolTable(SymbolTable* pSymbolTable);
+void destroySymbolTable(SymbolTable symbolTable);
+bool symbol_intern(String string, Symbol* pSymbol);
+bool symbol_qualify(Symbol namespace, Symbol name, Symbol* pSymbol);
+String symbol_getString(Symbol symbol);
+bool symbol_print(Symbol symbol, Output* pOutput);
+bool parser_parseWord(Parser* pParser, Symbol* pWord);
+bool parser_parseName(Parser* pParser, Symbol* pName);
 bool parser_parseFileName(Parser* pParser, String* pFileName);
 
+typedef struct NameIndex {
+    size_t entryCount;
+    size_t bucketCount;
+    size_t* pBuckets;
+} NameIndex;
+NameIndex const EMPTY_NAME_INDEX = {.entryCount = 0, .bucketCount = 0, .pBuckets = NULL};
+void destroyNameIndex(NameIndex nameIndex);
+bool nameIndex_find(NameIndex nameIndex, Symbol const* pNames, size_t stride, Symbol name, size_t* pIndex);
+bool nameIndex_insert(NameIndex* pNameIndex, Symbol const* pNames, size_t stride, size_t index);
+bool nameIndex_rebuild(NameIndex* pNameIndex, Symbol const* pNames, size_t stride, size_t count);
+
 typedef enum ExpressionKind {
     UNSPECIFIED_EXPRESSION,
     CONSTRUCTION_EXPRESSION,
-    EVALUATION_EXPRESSION
+    EVALUATION_EXPRESSION,
+    DEFERRED_EXPRESSION,
+    THUNK_EXPRESSION
 } ExpressionKind;
 typedef struct Expression {
     ExpressionKind kind;
     void* pData;
 } Expression;
 typedef struct Construction {
-    size_t index;
-    size_t argumentCount;
-    Expression* pArguments;
+    uint32_t index;
+    uint32_t argumentCount : 31;
+    uint32_t isClosed : 1;
+    uint64_t hash;
 } Construction;
 typedef enum EvaluationKind {
     REFERENCE_EVALUATION,
@@ -61,154 +322,1318 @@ typedef struct Evaluation {
 } Evaluation;
 typedef struct Destruction {
     Evaluation caller;
-    size_t index;
-    size_t argumentCount;
+    uint32_t index;
+    uint32_t argumentCount;
     Expression* pArguments;
+    uint64_t hash;
 } Destruction;
-bool createConstructionExpression(Construction construction, Expression* pExpression);
+bool createConstructionExpression(Construction construction, Expression const* pArguments, Expression* pExpression);
 bool createEvaluationExpression(Evaluation evaluation, Expression* pExpression);
-void destroyExpression(Expression expression);
 bool createReferenceEvaluation(size_t index, Evaluation* pEvaluation);
 bool createDestructionEvaluation(Destruction destruction, Evaluation* pEvaluation);
-void destroyEvaluation(Evaluation evaluation);
 bool expression_equals(Expression expression, Expression other);
 bool evaluation_equals(Evaluation evaluation, Evaluation other);
 bool expression_duplicate(Expression expression, Expression* pResult);
 bool evaluation_duplicate(Evaluation evaluation, Evaluation* pResult);
+uint64_t expression_hash(Expression expression);
+uint64_t evaluation_hash(Evaluation evaluation);
+bool construction_equals(Construction construction, Expression const* pArguments, Construction const* pOther);
+bool destruction_equals(Destruction destruction, Destruction other);
+uint64_t construction_hash(Construction construction, Expression const* pArguments);
+uint64_t destruction_hash(Destruction destruction);
+bool construction_isClosed(Construction construction, Expression const* pArguments);
+static inline Expression* construction_getArguments(Construction const* pConstruction);
+Region scratchRegion;
+Region* pExpressionRegion = &scratchRegion;
+bool expression_allocate(size_t size, void** ppData);
+bool region_findConstruction(
+    Region const* pRegion, Construction construction, Expression const* pArguments, Construction** ppResult
+);
+bool region_findDestruction(Region const* pRegion, Destruction destruction, Destruction** ppResult);
 
 typedef struct Constructor {
     size_t depth;
-    String name;
+    Symbol name;
     size_t parameterCount;
     Expression* pParameterTypes;
 } Constructor;
 typedef struct Destructor {
     size_t depth;
-    String name;
+    Symbol name;
     size_t parameterCount;
     Expression* pParameterTypes;
     Expression returnType;
-    Expression* pRules;
 } Destructor;
 typedef struct Matrix {
     size_t constructorCount;
+    size_t constructorCapacity;
     Constructor* pConstructors;
     size_t destructorCount;
+    size_t destructorCapacity;
     Destructor* pDestructors;
+    size_t ruleRowCapacity;
+    size_t ruleColumnCapacity;
+    Expression* pRules;
+    NameIndex constructorIndex;
+    NameIndex destructorIndex;
 } Matrix;
+typedef enum OperationKind {
+    CONSTRUCTOR_OPERATION,
+    DESTRUCTOR_OPERATION,
+    RULE_OPERATION,
+    NAMESPACE_OPERATION
+} OperationKind;
+typedef struct Operation {
+    OperationKind kind;
+    size_t typeIndex;
+    size_t destructorIndex;
+    size_t constructorIndex;
+    size_t depth;
+    Symbol name;
+    size_t renameStart;
+    ArenaMark arenaMark;
+} Operation;
+typedef struct Rename {
+    OperationKind kind;
+    size_t typeIndex;
+    size_t index;
+    size_t depth;
+    Symbol name;
+} Rename;
 typedef struct Module {
     size_t matrixCount;
+    size_t matrixCapacity;
     Matrix* pMatrices;
+    size_t operationCount;
+    size_t operationCapacity;
+    Operation* pOperations;
+    size_t renameCount;
+    size_t renameCapacity;
+    Rename* pRenames;
+    uint64_t fingerprint;
+    Region region;
 } Module;
+uint64_t const EMPTY_MODULE_FINGERPRINT = 0x494E44494D4F4455u;
 typedef struct Parameter {
-    String name;
+    Symbol name;
     Expression type;
 } Parameter;
 typedef struct Substitution {
     Expression type;
     Expression value;
 } Substitution;
+typedef struct DeferredType {
+    Expression type;
+    Construction* pTypeConstruction;
+    Substitution const* pSubstitutions;
+} DeferredType;
+typedef struct Thunk {
+    Expression expression;
+    size_t substitutionCount;
+    Substitution* pSubstitutions;
+    Expression value;
+    size_t epoch;
+    size_t offset;
+} Thunk;
+typedef struct Instantiation {
+    Construction const* pTypeConstruction;
+    void const* pType;
+    Expression result;
+} Instantiation;
+bool instantiationTable_find(
+    InstantiationTable table, Construction const* pTypeConstruction, void const* pType, size_t* pIndex
+);
+bool instantiationTable_insert(InstantiationTable* pTable, Instantiation instantiation);
+bool expression_isBounded(Expression expression, size_t count);
+bool evaluation_isBounded(Evaluation evaluation, size_t count);
+size_t expression_getBound(Expression expression);
+size_t evaluation_getBound(Evaluation evaluation);
+typedef struct Allocation {
+    void* pData;
+    size_t size;
+} Allocation;
+typedef struct MarkItem {
+    bool isEvaluation;
+    int kind;
+    void* pData;
+} MarkItem;
+typedef struct NodeSet {
+    size_t capacity;
+    void** ppNodes;
+    bool* pIsMarked;
+} NodeSet;
+typedef struct Collector {
+    size_t depth;
+    bool isActive;
+    size_t allocationCount;
+    size_t allocationCapacity;
+    Allocation* pAllocations;
+    size_t itemCount;
+    size_t itemCapacity;
+    MarkItem* pItems;
+    void* ppFreeLists[64];
+    size_t epoch;
+    size_t rememberedCount;
+    size_t rememberedCapacity;
+    Thunk** ppRememberedThunks;
+    size_t allocatedBytes;
+    size_t liveBytes;
+    size_t threshold;
+    size_t peakBytes;
+    size_t collectionCount;
+    size_t reclaimedBytes;
+    double pauseMilliseconds;
+    double longestPauseMilliseconds;
+} Collector;
+Collector collector;
+size_t const COLLECTOR_SIZE_CLASS_COUNT = 64;
+size_t const COLLECTOR_MINIMUM_THRESHOLD = 4194304;
+void destroyCollector(Collector* pCollector);
+void collector_enter(void);
+void collector_leave(void);
+bool collector_poll(void);
+bool collector_pushItem(MarkItem item);
+bool collector_pushExpression(Expression expression);
+bool collector_pushSubstitutions(Substitution const* pSubstitutions, size_t count);
+bool collector_record(void* pData, size_t size);
+bool collector_remember(Thunk* pThunk);
+bool collector_pushStack(NodeSet set);
+bool collector_pushStackRange(size_t count, Construction* const* ppConstructions);
+int collector_compareConstructions(void const* pLeft, void const* pRight);
+bool collector_collect(void);
+size_t nodeSet_find(NodeSet set, void const* pNode);
+void nodeTable_discard(NodeTable* pTable, NodeSet set);
+void collector_printStatistics(void);
+typedef struct MemoEntry {
+    uint64_t hash;
+    Construction const* pTypeConstruction;
+    size_t index;
+    Expression caller;
+    size_t argumentCount;
+    Expression* pArguments;
+    Expression value;
+    size_t nextInBucket;
+    size_t newerEntry;
+    size_t olderEntry;
+} MemoEntry;
+typedef struct Memo {
+    size_t entryLimit;
+    size_t entryCount;
+    size_t entryCapacity;
+    MemoEntry* pEntries;
+    size_t bucketCount;
+    size_t* pBuckets;
+    size_t newestEntry;
+    size_t oldestEntry;
+    size_t hitCount;
+    size_t missCount;
+    size_t evictionCount;
+} Memo;
+Memo memo;
+size_t const NO_MEMO_ENTRY = SIZE_MAX;
+void destroyMemo(Memo* pMemo);
+void memo_clear(void);
+uint64_t memo_hash(
+    Construction const* pTypeConstruction, size_t index, Expression caller, size_t argumentCount,
+    Expression const* pArguments
+);
+bool memo_find(
+    Construction const* pTypeConstruction, size_t index, Expression caller, size_t argumentCount,
+    Expression const* pArguments, uint64_t hash, Expression* pValue
+);
+bool memo_insert(
+    Construction const* pTypeConstruction, size_t index, Expression caller, size_t argumentCount,
+    Expression const* pArguments, uint64_t hash, Expression value
+);
+bool memo_grow(void);
+void memo_unlink(size_t entryIndex);
+void memo_touch(size_t entryIndex);
+bool memo_pushRoots(void);
+void memo_printStatistics(void);
 bool createEmptyModule(Module* pModule);
 void destroyModule(Module module);
+bool matrix_findConstructor(Matrix matrix, Symbol name, size_t* pIndex);
+bool matrix_findDestructor(Matrix matrix, Symbol name, size_t* pIndex);
+bool matrix_reserveConstructor(Matrix* pMatrix);
+bool matrix_reserveDestructor(Matrix* pMatrix);
+bool matrix_reserveRules(Matrix* pMatrix, size_t rowCount, size_t columnCount);
+Expression* matrix_getRules(Matrix matrix, size_t destructorIndex);
+bool module_reserveMatrix(Module* pModule);
+bool module_reserveOperation(Module* pModule);
+void module_appendOperation(Module* pModule, Operation operation, uint64_t hash);
+bool module_adoptExpression(Module* pModule, Expression expression, Expression* pResult);
+bool module_adoptExpressions(Module* pModule, size_t count, Expression const* pExpressions, Expression** ppResults);
+bool module_addConstructor(Module* pModule, size_t typeIndex, Constructor constructor);
+bool module_addDestructor(Module* pModule, size_t typeIndex, Destructor destructor);
+bool module_setRule(
+    Module* pModule, size_t typeIndex, size_t destructorIndex, size_t constructorIndex, Expression rule
+);
+bool module_recordRename(Module* pModule, OperationKind kind, size_t typeIndex, size_t index);
+bool module_rollback(Module* pModule, size_t operationCount, uint64_t fingerprint);
+typedef struct ConstructionFrame {
+    Construction* pTypeConstruction;
+    size_t index;
+    Constructor constructor;
+    Expression const* pArguments;
+    Substitution* pSubstitutions;
+    size_t typeSubstitutionCount;
+    size_t constructorSubstitutionCount;
+} ConstructionFrame;
+typedef struct ConstructionStack {
+    size_t frameCount;
+    size_t frameCapacity;
+    ConstructionFrame* pFrames;
+} ConstructionStack;
+void destroyConstructionStack(ConstructionStack stack);
+bool constructionStack_push(
+    ConstructionStack* pStack, Module module, Construction* pTypeConstruction, size_t index,
+    Expression const* pArguments
+);
+void constructionStack_pop(ConstructionStack* pStack);
+bool constructionStack_substitute(ConstructionStack* pStack, Module module, Expression* pType);
 bool expression_substitute(
     Expression expression, Module module, Substitution const* pSubstitutions,
     Expression* pResult
 );
 bool expression_print(
-    Expression expression, Module module, size_t parameterCount, Parameter const* pParameters, Expression type
+    Expression expression, Module module, size_t parameterCount, Parameter const* pParameters, Expression type,
+    Output* pOutput
 );
 bool type_print(
-    Expression expression, Module module, size_t parameterCount, Parameter const* pParameters
+    Expression expression, Module module, size_t parameterCount, Parameter const* pParameters, Output* pOutput
 );
 bool evaluation_print(
-    Evaluation evaluation, Module module, size_t parameterCount, Parameter const* pParameters, Expression* pType
+    Evaluation evaluation, Module module, size_t parameterCount, Parameter const* pParameters, Output* pOutput,
+    Expression* pType
 );
 bool evaluation_substitute(
-    Evaluation evaluation, Module module, Substitution const* pSubstitutions,
+    Evaluation evaluation, Module module, Substitution const* pSubstitutions, bool isTypeNeeded,
     Substitution* pResult
 );
+bool expression_instantiate(
+    Expression type, Module module, Construction* pTypeConstruction, Substitution const* pSubstitutions,
+    Expression* pResult
+);
+bool substitution_computeType(Substitution substitution, Module module, Expression* pType);
+bool createThunkExpression(
+    Expression expression, Module module, Substitution const* pSubstitutions, Expression* pExpression
+);
+bool expression_capture(
+    Expression expression, Module module, Substitution const* pSubstitutions, Substitution* pCaptured
+);
+bool evaluation_capture(
+    Evaluation evaluation, Module module, Substitution const* pSubstitutions, Substitution* pCaptured
+);
+bool thunk_force(Thunk* pThunk, Module module, Expression* pValue);
+bool thunk_setValue(Thunk* pThunk, Expression value);
+bool expression_normalize(Expression expression, Module module, Expression* pResult);
 bool substitution_destruct(
-    Substitution substitution, Module module, size_t index, Expression const* pArguments,
+    Substitution substitution, Module module, size_t index, Expression const* pArguments, bool isTypeNeeded,
+    Substitution* pResult
+);
+bool substitution_delay(
+    Module module, Construction* pTypeConstruction, size_t index, Substitution const* pSubstitutions, size_t offset,
     Substitution* pResult
 );
+typedef enum EvaluationFrameKind {
+    CONSTRUCTION_FRAME,
+    DESTRUCTION_FRAME,
+    RULE_FRAME,
+    FORCE_FRAME,
+    NORMALIZE_FRAME
+} EvaluationFrameKind;
+typedef struct EvaluationFrame {
+    EvaluationFrameKind kind;
+    Expression expression;
+    Destruction* pDestruction;
+    Substitution const* pSubstitutions;
+    Thunk* pThunk;
+    bool isTypeNeeded;
+    Substitution caller;
+    size_t index;
+    size_t argumentCount;
+    Expression* pArguments;
+    Expression type;
+    size_t destructorSubstitutionCount;
+    Substitution* pDestructorSubstitutions;
+    size_t ruleSubstitutionCount;
+    Substitution* pRuleSubstitutions;
+    bool isMemoized;
+    uint64_t memoHash;
+    size_t const* pWords;
+    size_t programCounter;
+    ArenaMark environmentMark;
+} EvaluationFrame;
+typedef struct Evaluator {
+    EvaluationEngine engine;
+    bool isLazy;
+    size_t frameCount;
+    size_t frameCapacity;
+    EvaluationFrame* pFrames;
+    size_t frameLimit;
+    size_t valueCount;
+    size_t valueCapacity;
+    Expression* pValues;
+    Expression* pValueTypes;
+    Arena environmentArena;
+    size_t failedOffset;
+} Evaluator;
+Evaluator evaluator = {
+    .engine = TREE_ENGINE,
+    .isLazy = false,
+    .frameCount = 0,
+    .frameCapacity = 0,
+    .pFrames = NULL,
+    .frameLimit = SIZE_MAX,
+    .valueCount = 0,
+    .valueCapacity = 0,
+    .pValues = NULL,
+    .pValueTypes = NULL,
+    .environmentArena = {
+        .chunkCount = 0,
+        .chunkCapacity = 0,
+        .pChunks = NULL,
+        .offset = 0,
+        .spareChunk = {
+            .pData = NULL,
+            .capacity = 0
+        }
+    },
+    .failedOffset = SIZE_MAX
+};
+void destroyEvaluator(Evaluator* pEvaluator);
+bool evaluator_push(EvaluationFrame frame);
+void evaluator_pop(void);
+void evaluator_unwind(size_t frameCount);
+bool evaluator_pushRoots(void);
+bool evaluator_beginExpression(
+    Expression expression, Module module, Substitution const* pSubstitutions, bool* pIsReturning,
+    Substitution* pResult
+);
+bool evaluator_beginEvaluation(
+    Evaluation evaluation, Module module, Substitution const* pSubstitutions, bool isTypeNeeded,
+    bool* pIsReturning, Substitution* pResult
+);
+bool evaluator_apply(
+    Substitution caller, Module module, size_t index, Expression* pArguments, bool isTypeNeeded, Expression type,
+    bool* pIsReturning, Substitution* pResult
+);
+bool evaluator_run(Module module, size_t frameCount, bool isReturning, Substitution* pResult);
+bool evaluator_delay(
+    Expression expression, Module module, Substitution const* pSubstitutions, bool* pIsDelayed, Expression* pValue
+);
+bool evaluator_beginNormalization(Expression expression, bool* pIsReturning, Substitution* pResult);
+bool evaluator_pushValue(Expression type, Expression value);
+typedef enum Opcode {
+    CONSTANT_OPCODE,
+    LOAD_OPCODE,
+    LOAD_TYPED_OPCODE,
+    CONSTRUCT_OPCODE,
+    DISPATCH_OPCODE,
+    DISPATCH_TYPED_OPCODE,
+    TAIL_DISPATCH_OPCODE,
+    RETURN_OPCODE
+} Opcode;
+typedef struct Code {
+    size_t wordCount;
+    size_t wordCapacity;
+    size_t* pWords;
+} Code;
+typedef struct CodeTable {
+    size_t codeCount;
+    size_t capacity;
+    void const** ppRules;
+    size_t** ppWords;
+} CodeTable;
+CodeTable codeTable = {
+    .codeCount = 0,
+    .capacity = 0,
+    .ppRules = NULL,
+    .ppWords = NULL
+};
+bool code_append(Code* pCode, size_t word);
+bool code_compileExpression(Code* pCode, Expression expression, bool isTail);
+bool code_compileEvaluation(Code* pCode, Evaluation evaluation, bool isTypeNeeded, bool isTail);
+void destroyCodeTable(CodeTable table);
+void codeTable_clear(CodeTable* pTable);
+bool codeTable_get(CodeTable* pTable, Expression rule, size_t const** ppWords);
+bool machine_execute(Module module, Substitution* pResult);
 bool parser_parseExpression(
     Parser* pParser, Module module,
     size_t parameterCount, Parameter const* pParameters, Expression type,
     Expression* pExpression
 );
+bool parser_parseEvaluation(
+    Parser* pParser, Module module,
+    size_t parameterCount, Parameter const* pParameters, Expression type,
+    Expression* pExpression
+);
 bool parser_parseType(
     Parser* pParser, Module module,
     size_t parameterCount, Parameter const* pParameters,
     Expression* pExpression
 );
 bool parser_parseStatement(Parser* pParser, Module* pModule, size_t depth);
-bool module_endNamespace(Module* pModule, size_t depth, char const* pNamespace);
+bool module_endNamespace(Module* pModule, size_t depth, Symbol namespace);
 bool module_validate(Module module, size_t depth);
+bool createReferenceExpression(size_t index, Expression* pExpression);
+bool expression_check(
+    Expression expression, Module module, size_t parameterCount, Parameter const* pParameters, Expression type
+);
+bool evaluation_check(
+    Evaluation evaluation, Module module, size_t parameterCount, Parameter const* pParameters, Expression* pType
+);
+bool module_check(Module module);
+
+char const IMAGE_MAGIC[8] = "INDCIMG";
+uint64_t const IMAGE_VERSION = 3;
+typedef struct ImageHeader {
+    char pMagic[8];
+    uint64_t version;
+    uint64_t layout;
+    uint64_t length;
+    uint64_t checksum;
+    uint64_t symbolCount;
+    uint64_t symbolsOffset;
+    uint64_t matrixCount;
+    uint64_t matricesOffset;
+} ImageHeader;
+typedef struct ImageString {
+    uint64_t offset;
+    uint64_t length;
+} ImageString;
+typedef struct ImageWriter {
+    size_t length;
+    size_t capacity;
+    char* pData;
+} ImageWriter;
+uint64_t image_getLayout(void);
+uint64_t image_checksum(char const* pData, size_t length);
+bool imageWriter_reserve(ImageWriter* pWriter, size_t size, size_t* pOffset);
+bool imageWriter_write(ImageWriter* pWriter, void const* pData, size_t size, size_t* pOffset);
+bool imageWriter_writeExpression(ImageWriter* pWriter, Expression expression, Expression* pResult);
+bool imageWriter_writeEvaluation(ImageWriter* pWriter, Evaluation evaluation, Evaluation* pResult);
+bool imageWriter_writeExpressions(
+    ImageWriter* pWriter, size_t count, Expression const* pExpressions, size_t* pOffset
+);
+bool image_relocate(char* pImage, size_t limit, size_t count, size_t size, void** ppData);
+bool image_relocateExpression(char* pImage, size_t limit, bool isRule, Expression* pExpression);
+bool image_relocateEvaluation(char* pImage, size_t limit, Evaluation* pEvaluation);
+bool image_relocateExpressions(char* pImage, size_t limit, size_t count, bool isRule, Expression** ppExpressions);
+bool module_saveImage(Module module, char const* pFileName);
+bool createModuleFromImage(char const* pFileName, bool isTrusted, Module* pModule);
+
+uint64_t const NATIVE_VERSION = 2;
+typedef enum NativeStatus {
+    NATIVE_DONE,
+    NATIVE_DECLINED,
+    NATIVE_FAILED
+} NativeStatus;
+typedef struct NativeApi {
+    uint64_t layout;
+    bool (*construct)(size_t index, size_t argumentCount, Expression const* pArguments, Expression* pResult);
+    bool (*destruct)(
+        size_t typeIndex, size_t index, Expression caller, Expression const* pArguments, Expression* pResult
+    );
+    bool const* pIsValid;
+    char const* const* ppStackLimit;
+} NativeApi;
+typedef struct NativeBinding {
+    size_t typeIndex;
+    size_t destructorIndex;
+    uint64_t hash;
+    NativeStatus (*function)(Expression caller, Expression const* pArguments, Expression* pResult);
+} NativeBinding;
+typedef bool (*NativeBind)(NativeApi const* pApi, size_t* pBindingCount, NativeBinding const** ppBindings);
+typedef struct NativeLibrary {
+    void* pHandle;
+    NativeApi api;
+    size_t bindingCount;
+    NativeBinding const* pBindings;
+    bool* pIsValid;
+    size_t slotCapacity;
+    size_t* pSlots;
+    uint64_t fingerprint;
+    Module module;
+    bool isRunning;
+    char const* pStackLimit;
+    char const* pStackBase;
+} NativeLibrary;
+NativeLibrary native = {
+    .pHandle = NULL,
+    .bindingCount = 0,
+    .pBindings = NULL,
+    .pIsValid = NULL,
+    .slotCapacity = 0,
+    .pSlots = NULL,
+    .isRunning = false,
+    .pStackBase = NULL
+};
+size_t const NO_NATIVE_BINDING = SIZE_MAX;
+size_t const NATIVE_STACK_BUDGET_LIMIT = 256 << 20;
+typedef struct NativeEmitter {
+    Output output;
+    Module module;
+    size_t const* pOffsets;
+    bool const* pIsEligible;
+    size_t const* pBindingIndices;
+    size_t typeIndex;
+    size_t constructorIndex;
+    size_t destructorIndex;
+    size_t variableCount;
+} NativeEmitter;
+uint64_t native_getLayout(void);
+uint64_t native_hash(Module module, size_t typeIndex, size_t destructorIndex);
+bool createNativeLibrary(char const* pFileName, NativeLibrary* pLibrary);
+char const* native_getStackLimit(void);
+void destroyNativeLibrary(NativeLibrary library);
+size_t native_find(size_t typeIndex, size_t destructorIndex);
+void native_validate(Module module);
+bool native_apply(
+    Module module, size_t typeIndex, size_t index, Expression caller, Expression const* pArguments,
+    bool* pIsApplied, Expression* pValue
+);
+bool native_construct(size_t index, size_t argumentCount, Expression const* pArguments, Expression* pResult);
+bool native_destruct(
+    size_t typeIndex, size_t index, Expression caller, Expression const* pArguments, Expression* pResult
+);
+bool native_getType(Module module, Expression type, size_t* pTypeIndex);
+bool native_hasEligibleSignature(Module module, size_t typeIndex, size_t destructorIndex);
+bool nativeEmitter_getSlotType(NativeEmitter const* pEmitter, size_t index, size_t* pTypeIndex);
+bool nativeEmitter_checkExpression(NativeEmitter const* pEmitter, Expression expression);
+bool nativeEmitter_checkEvaluation(NativeEmitter const* pEmitter, Evaluation evaluation, size_t* pTypeIndex);
+bool nativeEmitter_emitExpression(NativeEmitter* pEmitter, Expression expression, bool isTail, size_t* pVariable);
+bool nativeEmitter_emitEvaluation(
+    NativeEmitter* pEmitter, Evaluation evaluation, bool isTail, size_t* pTypeIndex, size_t* pVariable
+);
+bool nativeEmitter_emitName(NativeEmitter* pEmitter, size_t typeIndex, size_t destructorIndex);
+bool nativeEmitter_emitSignature(NativeEmitter* pEmitter, size_t typeIndex, size_t destructorIndex);
+bool nativeEmitter_emitFunction(NativeEmitter* pEmitter, size_t typeIndex, size_t destructorIndex);
+bool native_findEligible(Module module, size_t** ppOffsets, bool** ppIsEligible);
+bool module_emitNative(Module module, char const* pFileName);
+typedef NativeStatus (*JitCode)(Expression const* pCaller, Expression const* pArguments, Expression* pResult);
+typedef struct JitFunction {
+    JitCode code;
+    bool isValid;
+    size_t typeIndex;
+    size_t destructorIndex;
+    uint64_t hash;
+} JitFunction;
+typedef struct JitProfile {
+    size_t typeIndex;
+    size_t destructorIndex;
+    size_t callCount;
+    bool isRejected;
+    uint64_t rejectedFingerprint;
+    JitFunction* pFunction;
+} JitProfile;
+typedef struct JitChunk {
+    unsigned char* pData;
+    size_t length;
+} JitChunk;
+typedef struct Jit {
+    size_t threshold;
+    size_t profileCount;
+    size_t profileCapacity;
+    JitProfile* pProfiles;
+    size_t functionCount;
+    size_t functionCapacity;
+    JitFunction** ppFunctions;
+    size_t chunkCount;
+    size_t chunkCapacity;
+    JitChunk* pChunks;
+    uint64_t fingerprint;
+    bool isStackExhausted;
+    size_t compiledFunctionCount;
+    size_t compiledByteCount;
+} Jit;
+Jit jit = {
+    .threshold = 0,
+    .profileCount = 0,
+    .profileCapacity = 0,
+    .pProfiles = NULL,
+    .functionCount = 0,
+    .functionCapacity = 0,
+    .ppFunctions = NULL,
+    .chunkCount = 0,
+    .chunkCapacity = 0,
+    .pChunks = NULL,
+    .fingerprint = 0,
+    .isStackExhausted = false,
+    .compiledFunctionCount = 0,
+    .compiledByteCount = 0
+};
+typedef struct JitFixup {
+    size_t position;
+    size_t label;
+} JitFixup;
+typedef enum JitBase {
+    JIT_FIELDS,
+    JIT_ARGUMENTS,
+    JIT_SLOTS
+} JitBase;
+typedef struct JitAssembler {
+    size_t length;
+    size_t capacity;
+    unsigned char* pData;
+    size_t labelCount;
+    size_t labelCapacity;
+    size_t* pLabels;
+    size_t fixupCount;
+    size_t fixupCapacity;
+    JitFixup* pFixups;
+    size_t batchCount;
+    size_t batchCapacity;
+    JitFunction** ppBatch;
+    size_t* pStarts;
+    JitFunction** ppTargets;
+    NativeEmitter emitter;
+    JitFunction* pFunction;
+    size_t slotCount;
+    size_t frameSlotCount;
+    size_t loopLabel;
+    size_t declineLabel;
+    size_t failedLabel;
+    size_t doneLabel;
+    size_t epilogueLabel;
+} JitAssembler;
+void destroyJit(Jit* pJit);
+JitProfile* jit_findProfile(size_t typeIndex, size_t destructorIndex);
+bool jit_insertProfile(size_t typeIndex, size_t destructorIndex, JitProfile** ppProfile);
+void jit_validate(Module module);
+bool jit_apply(
+    Module module, size_t typeIndex, size_t index, Expression caller, Expression const* pArguments,
+    bool* pIsApplied, Expression* pValue
+);
+bool jit_compile(Module module, size_t typeIndex, size_t destructorIndex, bool* pIsCompiled);
+void jit_printStatistics(void);
+void destroyJitAssembler(JitAssembler assembler);
+bool jitAssembler_emit(JitAssembler* pAssembler, size_t length, unsigned char const* pBytes);
+bool jitAssembler_emitImmediate32(JitAssembler* pAssembler, uint32_t value);
+bool jitAssembler_emitImmediate64(JitAssembler* pAssembler, uint64_t value);
+bool jitAssembler_createLabel(JitAssembler* pAssembler, size_t* pLabel);
+void jitAssembler_placeLabel(JitAssembler* pAssembler, size_t label);
+bool jitAssembler_emitJump(JitAssembler* pAssembler, size_t length, unsigned char const* pOpcode, size_t label);
+bool jitAssembler_emitCall(JitAssembler* pAssembler, void const* pTarget);
+bool jitAssembler_emitCopy(JitAssembler* pAssembler, JitBase base, size_t offset, size_t slot);
+bool jitAssembler_emitSlotAddress(JitAssembler* pAssembler, unsigned char rex, unsigned char modRm, size_t slot);
+size_t jitAssembler_allocateSlots(JitAssembler* pAssembler, size_t count);
+bool jitAssembler_getTarget(
+    JitAssembler* pAssembler, size_t typeIndex, size_t destructorIndex, JitFunction** ppFunction
+);
+bool jitAssembler_emitExpression(JitAssembler* pAssembler, Expression expression, size_t slot);
+bool jitAssembler_emitEvaluation(
+    JitAssembler* pAssembler, Evaluation evaluation, size_t slot, bool isTail, size_t* pTypeIndex
+);
+bool jitAssembler_emitFunction(JitAssembler* pAssembler, JitFunction* pFunction);
+
+typedef struct Dependency {
+    String path;
+    uint64_t contentHash;
+} Dependency;
+typedef struct IncludeCache {
+    char* pDirectoryName;
+    size_t dependencyCount;
+    size_t dependencyCapacity;
+    Dependency* pDependencies;
+    size_t printCount;
+    size_t fileDepth;
+    size_t hitCount;
+    size_t missCount;
+    size_t staleCount;
+    size_t storeCount;
+} IncludeCache;
+IncludeCache includeCache;
+char const CACHE_MAGIC[8] = "INDCACH";
+uint64_t const CACHE_VERSION = 3;
+typedef struct CacheHeader {
+    char pMagic[8];
+    uint64_t version;
+    uint64_t layout;
+    uint64_t length;
+    uint64_t checksum;
+    uint64_t contentHash;
+    uint64_t pathHash;
+    uint64_t fingerprint;
+    uint64_t depth;
+    uint64_t resultFingerprint;
+    uint64_t dependencyCount;
+    uint64_t dependenciesOffset;
+    uint64_t operationCount;
+    uint64_t operationsOffset;
+    uint64_t printedLength;
+    uint64_t printedOffset;
+} CacheHeader;
+typedef struct CacheDependency {
+    ImageString path;
+    uint64_t contentHash;
+} CacheDependency;
+typedef struct CacheOperation {
+    uint64_t kind;
+    size_t typeIndex;
+    size_t destructorIndex;
+    size_t constructorIndex;
+    size_t depth;
+    ImageString name;
+    size_t parameterCount;
+    Expression* pParameterTypes;
+    Expression expression;
+} CacheOperation;
+bool createIncludeCache(char const* pDirectoryName, IncludeCache* pCache);
+void destroyIncludeCache(IncludeCache cache);
+bool includeCache_appendDependency(String path, uint64_t contentHash);
+bool includeCache_getEntryFileName(
+    uint64_t contentHash, uint64_t pathHash, uint64_t fingerprint, size_t depth, char** ppFileName
+);
+bool includeCache_replay(Module* pModule, uint64_t contentHash, uint64_t pathHash, size_t depth, bool* pIsHit);
+bool includeCache_store(
+    Module module, uint64_t contentHash, uint64_t pathHash, uint64_t fingerprint, size_t depth,
+    size_t operationStart, size_t dependencyStart, String printed
+);
+bool includeCache_endCapture(Output parentOutput, String* pPrinted);
+void includeCache_printStatistics(void);
+
+typedef struct Checkpoint {
+    String fileName;
+    String directoryName;
+    String path;
+    uint64_t contentHash;
+    size_t depth;
+    size_t parentIndex;
+    size_t resumeOffset;
+    size_t namespaceCount;
+    Symbol* pNamespaces;
+    size_t operationCount;
+    uint64_t fingerprint;
+} Checkpoint;
+typedef struct WatchedFile {
+    String path;
+    uint64_t contentHash;
+    size_t checkpointIndex;
+    bool isChanged;
+} WatchedFile;
+typedef struct WatchedDirectory {
+    int descriptor;
+    String path;
+} WatchedDirectory;
+typedef struct Watch {
+    bool isEnabled;
+    int inotifyDescriptor;
+    size_t checkpointCount;
+    size_t checkpointCapacity;
+    Checkpoint* pCheckpoints;
+    size_t fileCount;
+    size_t fileCapacity;
+    WatchedFile* pFiles;
+    size_t directoryCount;
+    size_t directoryCapacity;
+    WatchedDirectory* pDirectories;
+    size_t activeCheckpoint;
+    size_t resumeOffset;
+    size_t namespaceCount;
+    size_t namespaceCapacity;
+    Symbol* pNamespaces;
+} Watch;
+Watch watch;
+size_t const NO_CHECKPOINT = SIZE_MAX;
+#ifdef __linux__
+uint32_t const WATCH_EVENT_MASK = IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_DELETE;
+#endif
+int const WATCH_SETTLE_MILLISECONDS = 50;
+bool createWatch(Watch* pWatch);
+void destroyWatch(Watch watchState);
+void destroyCheckpoint(Checkpoint checkpoint);
+bool file_hash(char const* pFileName, uint64_t* pHash);
+bool watch_setNamespaces(size_t namespaceCount, Symbol const* pNamespaces);
+bool watch_pushNamespace(Symbol namespace);
+bool watch_addFile(String path, uint64_t contentHash, size_t checkpointIndex);
+bool watch_addCheckpoint(Directory directory, char const* pFileName, size_t depth, Module module, uint64_t contentHash);
+void watch_truncate(size_t checkpointIndex);
+bool watch_watchDirectories(void);
+bool watch_markChanged(char const* pEvents, size_t length);
+bool watch_waitForChange(size_t* pCheckpointIndex);
+bool watch_resumeFile(Module* pModule, size_t parentIndex, Checkpoint child);
+void watch_printIncludeLocations(Checkpoint child);
+bool watch_reparse(Module* pModule, size_t checkpointIndex);
+bool watch_run(Directory directory, Module* pModule, bool isStatisticsEnabled);
+
+typedef enum PrefetchState {
+    PENDING_PREFETCH,
+    LOADING_PREFETCH,
+    LOADED_PREFETCH,
+    FAILED_PREFETCH,
+    TAKEN_PREFETCH
+} PrefetchState;
+typedef struct Prefetch {
+    String path;
+    uint64_t pathHash;
+    String directoryPath;
+    PrefetchState state;
+    char* pData;
+    size_t length;
+    bool isMapped;
+    struct stat fileStat;
+} Prefetch;
+typedef struct Prefetcher {
+    bool isEnabled;
+    bool isStopping;
+    pthread_mutex_t mutex;
+    pthread_cond_t condition;
+    size_t threadCount;
+    pthread_t* pThreads;
+    size_t prefetchCount;
+    size_t prefetchCapacity;
+    Prefetch** ppPrefetches;
+    size_t nextIndex;
+    size_t bucketCount;
+    Prefetch** ppBuckets;
+} Prefetcher;
+Prefetcher prefetcher;
+size_t const PREFETCH_THREAD_LIMIT = 4;
+size_t const PREFETCH_PAGE_SIZE = 4096;
+bool createPrefetcher(size_t threadCount, Prefetcher* pPrefetcher);
+void destroyPrefetcher(Prefetcher* pPrefetcher);
+void destroyPrefetch(Prefetch* pPrefetch);
+Prefetch* prefetcher_find(String path, uint64_t pathHash);
+bool prefetcher_insert(Prefetch* pPrefetch);
+bool prefetcher_request(String directoryPath, char const* pName, size_t nameLength);
+bool prefetch_load(Prefetch* pPrefetch);
+void prefetch_scan(Prefetch const* pPrefetch);
+bool prefetch_isUnchanged(Prefetch const* pPrefetch, struct stat const* pFileStat);
+void* prefetcher_work(void* pArgument);
+bool prefetcher_take(Directory directory, char const* pFileName, Parser* pParser, bool* pIsTaken);
 
-bool parseFile(char const* pFileName, Module* pModule, size_t depth);
+bool parseFile(Directory directory, char const* pFileName, Module* pModule, size_t depth);
 
 
 
-int main() {
+int main(int argumentCount, char** pArguments) {
+    Options options;
+    if (!parseOptions(argumentCount, pArguments, &options))
+        goto optionsParseError;
+    if (options.pOutputFileName != NULL) {
+        if (!createFileOutput(options.pOutputFileName, &output))
+            goto outputCreateError;
+    } else {
+        if (!createDescriptorOutput(STDOUT_FILENO, &output))
+            goto outputCreateError;
+    }
+    if (!createSymbolTable(&symbols))
+        goto symbolTableCreateError;
+    if (options.pCacheDirectoryName != NULL) {
+        if (!createIncludeCache(options.pCacheDirectoryName, &includeCache))
+            goto includeCacheCreateError;
+    }
+    if (options.isWatchEnabled) {
+        if (!createWatch(&watch))
+            goto watchCreateError;
+    }
     Module module;
-    if (!createEmptyModule(&module))
-        goto moduleCreateError;
-    if (!parseFile(MAIN_FILE_NAME, &module, 0))
+    if (options.pLoadImageFileName != NULL) {
+        if (!createModuleFromImage(options.pLoadImageFileName, options.isImageTrusted, &module))
+            goto moduleCreateError;
+    } else {
+        if (!createEmptyModule(&module))
+            goto moduleCreateError;
+    }
+    scratchRegion.pParent = &module.region;
+    memo = (Memo) {
+        .entryLimit = (size_t) options.memoEntryLimit,
+        .newestEntry = NO_MEMO_ENTRY,
+        .oldestEntry = NO_MEMO_ENTRY
+    };
+    if (options.maximumDepth > 0)
+        evaluator.frameLimit = (size_t) options.maximumDepth;
+    evaluator.engine = options.engine;
+    evaluator.isLazy = options.isLazy;
+    if (options.pLoadNativeFileName != NULL) {
+        if (!createNativeLibrary(options.pLoadNativeFileName, &native))
+            goto nativeLibraryCreateError;
+    }
+    if (options.jitThreshold > 0) {
+        jit.threshold = (size_t) options.jitThreshold;
+        native.pStackLimit = native_getStackLimit();
+    }
+    Directory directory;
+    if (!createDirectory(CURRENT_DIRECTORY, ".", &directory))
+        goto directoryCreateError;
+    if (!createPrefetcher((size_t) options.prefetchThreadCount, &prefetcher))
+        goto prefetcherCreateError;
+    if (!prefetcher_request(directory.path, MAIN_FILE_NAME, strlen(MAIN_FILE_NAME)))
+        goto prefetchRequestError;
+    if (options.isWatchEnabled) {
+        if (!watch_run(directory, &module, options.isStatisticsEnabled))
+            goto watchRunError;
+    }
+    if (!parseFile(directory, MAIN_FILE_NAME, &module, 0))
         goto fileParseError;
     if (!module_validate(module, 0))
         goto moduleValidateError;
+    if (options.pSaveImageFileName != NULL) {
+        if (!module_saveImage(module, options.pSaveImageFileName))
+            goto imageSaveError;
+    }
+    if (options.pEmitNativeFileName != NULL) {
+        if (!module_emitNative(module, options.pEmitNativeFileName))
+            goto nativeEmitError;
+    }
+    if (options.isStatisticsEnabled && includeCache.pDirectoryName != NULL)
+        includeCache_printStatistics();
+    if (options.isStatisticsEnabled)
+        collector_printStatistics();
+    if (options.isStatisticsEnabled && memo.entryLimit > 0)
+        memo_printStatistics();
+    if (options.isStatisticsEnabled && jit.threshold > 0)
+        jit_printStatistics();
+    destroyPrefetcher(&prefetcher);
+    destroyDirectory(directory);
+    destroyJit(&jit);
+    destroyNativeLibrary(native);
     destroyModule(module);
+    destroyRegion(scratchRegion);
+    destroyMemo(&memo);
+    destroyEvaluator(&evaluator);
+    destroyCodeTable(codeTable);
+    destroyCollector(&collector);
+    destroyIncludeCache(includeCache);
+    destroySymbolTable(symbols);
+    if (!output_flush(&output))
+        goto outputFlushError;
+    destroyOutput(output);
     return EXIT_SUCCESS;
     
+nativeEmitError:
+imageSaveError:
 moduleValidateError:
 fileParseError:
+watchRunError:
+prefetchRequestError:
+    destroyPrefetcher(&prefetcher);
+prefetcherCreateError:
+    destroyDirectory(directory);
+directoryCreateError:
+    destroyJit(&jit);
+    destroyNativeLibrary(native);
+nativeLibraryCreateError:
     destroyModule(module);
+    destroyRegion(scratchRegion);
+    destroyMemo(&memo);
+    destroyEvaluator(&evaluator);
+    destroyCodeTable(codeTable);
+    destroyCollector(&collector);
 moduleCreateError:
+    if (watch.isEnabled)
+        destroyWatch(watch);
+watchCreateError:
+    destroyIncludeCache(includeCache);
+includeCacheCreateError:
+    destroySymbolTable(symbols);
+symbolTableCreateError:
+    output_flush(&output);
+outputFlushError:
+    destroyOutput(output);
+outputCreateError:
+optionsParseError:
     return EXIT_FAILURE;
 }
 
 
 
-bool createParserFromFile(char const* pFileName, Parser* pParser) {
-    FILE* pFile = fopen(pFileName, "r");
-    if (pFile == NULL)
+bool parseOptions(int argumentCount, char** pArguments, Options* pOptions) {
+    Options options = {
+        .pLoadImageFileName = NULL,
+        .pSaveImageFileName = NULL,
+        .isImageTrusted = false,
+        .pCacheDirectoryName = NULL,
+        .isStatisticsEnabled = false,
+        .isWatchEnabled = false,
+        .prefetchThreadCount = -1,
+        .memoEntryLimit = 0,
+        .maximumDepth = -1,
+        .engine = TREE_ENGINE,
+        .isLazy = false,
+        .pEmitNativeFileName = NULL,
+        .pLoadNativeFileName = NULL,
+        .jitThreshold = 0,
+        .pOutputFileName = NULL
+    };
+    for (int i = 1; i < argumentCount; i++) {
+        char const* pArgument = pArguments[i];
+        if (strcmp(pArgument, "--load-image") == 0 && i + 1 < argumentCount) {
+            options.pLoadImageFileName = pArguments[++i];
+            continue;
+        }
+        if (strcmp(pArgument, "--save-image") == 0 && i + 1 < argumentCount) {
+            options.pSaveImageFileName = pArguments[++i];
+            continue;
+        }
+        if (strcmp(pArgument, "--trust-image") == 0) {
+            options.isImageTrusted = true;
+            continue;
+        }
+        if (strcmp(pArgument, "--cache") == 0 && i + 1 < argumentCount) {
+            options.pCacheDirectoryName = pArguments[++i];
+            continue;
+        }
+        if (strcmp(pArgument, "--stats") == 0) {
+            options.isStatisticsEnabled = true;
+            continue;
+        }
+        if (strcmp(pArgument, "--emit-c") == 0 && i + 1 < argumentCount) {
+            options.pEmitNativeFileName = pArguments[++i];
+            continue;
+        }
+        if (strcmp(pArgument, "--load-native") == 0 && i + 1 < argumentCount) {
+            options.pLoadNativeFileName = pArguments[++i];
+            continue;
+        }
+        if (strcmp(pArgument, "--watch") == 0) {
+            options.isWatchEnabled = true;
+            continue;
+        }
+        if (strcmp(pArgument, "--output") == 0 && i + 1 < argumentCount) {
+            options.pOutputFileName = pArguments[++i];
+            continue;
+        }
+        if (strcmp(pArgument, "--prefetch-threads") == 0 && i + 1 < argumentCount) {
+            char* pEnd;
+            options.prefetchThreadCount = strtol(pArguments[++i], &pEnd, 10);
+            if (*pEnd == '\0' && options.prefetchThreadCount >= 0)
+                continue;
+            fprintf(stderr, "Invalid value for --prefetch-threads: %s\n", pArguments[i]);
+            return false;
+        }
+        if (strcmp(pArgument, "--memo") == 0 && i + 1 < argumentCount) {
+            char* pEnd;
+            options.memoEntryLimit = strtol(pArguments[++i], &pEnd, 10);
+            if (*pEnd == '\0' && options.memoEntryLimit >= 0)
+                continue;
+            fprintf(stderr, "Invalid value for --memo: %s\n", pArguments[i]);
+            return false;
+        }
+        if (strcmp(pArgument, "--max-depth") == 0 && i + 1 < argumentCount) {
+            char* pEnd;
+            options.maximumDepth = strtol(pArguments[++i], &pEnd, 10);
+            if (*pEnd == '\0' && options.maximumDepth > 0)
+                continue;
+            fprintf(stderr, "Invalid value for --max-depth: %s\n", pArguments[i]);
+            return false;
+        }
+        if (strcmp(pArgument, "--jit") == 0 && i + 1 < argumentCount) {
+            char* pEnd;
+            options.jitThreshold = strtol(pArguments[++i], &pEnd, 10);
+            if (*pEnd == '\0' && options.jitThreshold > 0)
+                continue;
+            fprintf(stderr, "Invalid value for --jit: %s\n", pArguments[i]);
+            return false;
+        }
+        if (strcmp(pArgument, "--lazy") == 0) {
+            options.isLazy = true;
+            continue;
+        }
+        if (strcmp(pArgument, "--engine") == 0 && i + 1 < argumentCount) {
+            pArgument = pArguments[++i];
+            if (strcmp(pArgument, "tree") == 0) {
+                options.engine = TREE_ENGINE;
+                continue;
+            }
+            if (strcmp(pArgument, "bytecode") == 0) {
+                options.engine = BYTECODE_ENGINE;
+                continue;
+            }
+            fprintf(stderr, "Invalid value for --engine: %s\n", pArgument);
+            return false;
+        }
+        fprintf(stderr, "Unrecognized option: %s\n", pArgument);
+        fprintf(stderr, "Usage: %s [--load-image FILE [--trust-image]] [--save-image FILE | --emit-c FILE | --watch] [--load-native FILE] [--cache DIRECTORY] [--stats] [--output FILE] [--prefetch-threads N] [--memo N] [--max-depth N] [--engine tree|bytecode] [--lazy] [--jit N]\n", pArguments[0]);
+        return false;
+    }
+    if (options.isWatchEnabled && (options.pSaveImageFileName != NULL || options.pEmitNativeFileName != NULL)) {
+        fprintf(stderr, "--watch cannot be combined with %s\n", options.pSaveImageFileName != NULL ? "--save-image" : "--emit-c");
+        return false;
+    }
+    if (options.prefetchThreadCount < 0) {
+        long processorCount = sysconf(_SC_NPROCESSORS_ONLN);
+        options.prefetchThreadCount = processorCount > 1 ? processorCount - 1 : 0;
+        if ((size_t) options.prefetchThreadCount > PREFETCH_THREAD_LIMIT)
+            options.prefetchThreadCount = (long) PREFETCH_THREAD_LIMIT;
+    }
+    *pOptions = options;
+    return true;
+}
+
+bool isWordCharacter(int character) {
+    return character != EOF && (CHARACTER_FLAGS[(unsigned char) character] & WORD_CHARACTER) != 0;
+}
+
+bool file_load(int fileDescriptor, size_t length, char** ppData, bool* pIsMapped) {
+    char* pData = NULL;
+    bool isMapped = false;
+    if (length > 0 && !watch.isEnabled) {
+        pData = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+        isMapped = pData != MAP_FAILED;
+    }
+    if (length > 0 && !isMapped) {
+        pData = malloc(length);
+        if (pData == NULL)
+            goto dataMallocError;
+        size_t readLength = 0;
+        while (readLength < length) {
+            ssize_t result = read(fileDescriptor, &pData[readLength], length - readLength);
+            if (result <= 0)
+                goto dataReadError;
+            readLength += (size_t) result;
+        }
+    }
+    *ppData = pData;
+    *pIsMapped = isMapped;
+    return true;
+    
+dataReadError:
+    free(pData);
+dataMallocError:
+    return false;
+}
+bool createParserFromFile(Directory directory, char const* pFileName, Parser* pParser) {
+    int fileDescriptor = openat(directory.descriptor, pFileName, O_RDONLY | O_CLOEXEC);
+    if (fileDescriptor == -1)
         throw(fileOpenError);
-    int next = fgetc(pFile);
+    struct stat fileStat;
+    if (fstat(fileDescriptor, &fileStat) == -1)
+        throw(fileStatError);
+    
+    size_t length = (size_t) fileStat.st_size;
+    char* pData;
+    bool isMapped;
+    if (!file_load(fileDescriptor, length, &pData, &isMapped))
+        throw(fileLoadError);
+    close(fileDescriptor);
     
     *pParser = (Parser) {
-        .pFile = pFile,
-        .lineNumber = 1,
-        .columnNumber = 1,
-        .next = next
+        .pData = pData,
+        .length = length,
+        .isMapped = isMapped,
+        .offset = 0,
+        .next = length > 0 ? (unsigned char) pData[0] : EOF,
+        .directory = directory
     };
     return true;
     
-    fclose(pFile);
+fileLoadError:
+fileStatError:
+    close(fileDescriptor);
 fileOpenError:
     return false;
 }
 void destroyParser(Parser parser) {
-    fclose(parser.pFile);
+    if (parser.isMapped)
+        munmap(parser.pData, parser.length);
+    else
+        free(parser.pData);
 }
 void parser_advance(Parser* pParser) {
-    if (pParser->next == '\n') {
-        pParser->lineNumber++;
-        pParser->columnNumber = 1;
-    } else
-        pParser->columnNumber++;
-    pParser->next = fgetc(pParser->pFile);
+    if (pParser->offset < pParser->length)
+        pParser->offset++;
+    pParser->next = pParser->offset < pParser->length ? (unsigned char) pParser->pData[pParser->offset] : EOF;
 }
 void parser_skipWhitespace(Parser* pParser) {
-    while (isspace(pParser->next))
-        parser_advance(pParser);
+    size_t offset = pParser->offset;
+    while (offset < pParser->length && (CHARACTER_FLAGS[(unsigned char) pParser->pData[offset]] & SPACE_CHARACTER))
+        offset++;
+    pParser->offset = offset;
+    pParser->next = offset < pParser->length ? (unsigned char) pParser->pData[offset] : EOF;
+}
+void parser_skipLine(Parser* pParser) {
+    char const* pEnd = memchr(&pParser->pData[pParser->offset], '\n', pParser->length - pParser->offset);
+    pParser->offset = pEnd == NULL ? pParser->length : (size_t) (pEnd - pParser->pData);
+    pParser->next = pEnd == NULL ? EOF : '\n';
+}
+void parser_getLocation(Parser parser, size_t* pLineNumber, size_t* pColumnNumber) {
+    size_t lineNumber = 1;
+    size_t lineOffset = 0;
+    char const* pEnd = &parser.pData[parser.offset];
+    char const* pLine = parser.offset > 0 ? memchr(parser.pData, '\n', parser.offset) : NULL;
+    while (pLine != NULL) {
+        lineNumber++;
+        lineOffset = (size_t) (pLine - parser.pData) + 1;
+        pLine = memchr(pLine + 1, '\n', (size_t) (pEnd - pLine - 1));
+    }
+    *pLineNumber = lineNumber;
+    *pColumnNumber = parser.offset - lineOffset + 1;
+}
+void parser_seekFailure(Parser* pParser) {
+    if (evaluator.failedOffset <= pParser->length)
+        pParser->offset = evaluator.failedOffset;
+    evaluator.failedOffset = SIZE_MAX;
 }
 
+bool createDirectory(Directory parent, char const* pName, Directory* pDirectory) {
+    int descriptor = openat(parent.descriptor, pName, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (descriptor == -1)
+        throw(directoryOpenError);
+    char* pPath;
+    if (!directory_resolve(parent, pName, &pPath))
+        throw(pathResolveError);
+    
+    *pDirectory = (Directory) {
+        .descriptor = descriptor,
+        .path = {
+            .length = strlen(pPath),
+            .pData = pPath
+        }
+    };
+    return true;
+    
+pathResolveError:
+    close(descriptor);
+directoryOpenError:
+    return false;
+}
+void destroyDirectory(Directory directory) {
+    close(directory.descriptor);
+    free(directory.path.pData);
+}
+bool directory_join(Directory directory, char const* pName, String* pPath) {
+    if (directory.path.pData == NULL || pName[0] == '/')
+        return createStringFromCString(pName, pPath);
+    size_t nameLength = strlen(pName);
+    char* pData = malloc(directory.path.length + 1 + nameLength + 1);
+    if (pData == NULL)
+        throw(dataMallocError);
+    memcpy(pData, directory.path.pData, directory.path.length);
+    pData[directory.path.length] = '/';
+    memcpy(&pData[directory.path.length + 1], pName, nameLength + 1);
+    
+    *pPath = (String) {
+        .length = directory.path.length + 1 + nameLength,
+        .pData = pData
+    };
+    return true;
+    
+dataMallocError:
+    return false;
+}
+bool directory_resolve(Directory directory, char const* pName, char** ppPath) {
+    String path;
+    if (!directory_join(directory, pName, &path))
+        throw(pathJoinError);
+    char* pPath = realpath(path.pData, NULL);
+    destroyString(path);
+    if (pPath == NULL)
+        throw(pathResolveError);
+    *ppPath = pPath;
+    return true;
+    
+pathResolveError:
+pathJoinError:
+    return false;
+}
 bool createStringFromCString(char const* pCString, String* pString) {
     size_t length = strlen(pCString);
-    char* pData = malloc(length);
+    char* pData = malloc(length + 1);
     if (pData == NULL)
         throw(dataMallocError);
-    memcpy(pData, pCString, length);
+    memcpy(pData, pCString, length + 1);
     
     *pString = (String) {
         .length = length,
@@ -226,138 +1651,718 @@ void destroyString(String string) {
 bool string_equals(String string, String other) {
     return string.length == other.length && memcmp(string.pData, other.pData, string.length) == 0;
 }
-bool string_print(String string) {
-    for (size_t i = 0; i < string.length; i++) {
-        if (fputc(string.pData[i], stdout) == EOF)
-            return false;
-    }
-    return true;
-}
-bool parser_parseWord(Parser* pParser, String* pWord) {
-    size_t length = 0;
-    char* pData = malloc(1);
+bool string_duplicate(String string, String* pResult) {
+    char* pData = malloc(string.length + 1);
     if (pData == NULL)
-        throw(dataReallocError);
-    while (
-        isalnum(pParser->next) ||
-        pParser->next == '_' ||
-        pParser->next == '+' ||
-        pParser->next == '-' ||
-        pParser->next == '*' ||
-        pParser->next == '/' ||
-        pParser->next == '%' ||
-        pParser->next == '^' ||
-        pParser->next == '&' ||
-        pParser->next == '=' ||
-        pParser->next == '\'' ||
-        pParser->next == '"' ||
-        pParser->next == '\\' ||
-        pParser->next == ',' ||
-        pParser->next == '`'
-    ) {
-        char* pNewData = realloc(pData, length + 2);
-        if (pNewData == NULL)
-            throw(dataReallocError);
-        pData = pNewData;
-        pData[length] = (char) pParser->next;
-        length++;
-        parser_advance(pParser);
-    }
-    pData[length] = 0;
-    parser_skipWhitespace(pParser);
-    *pWord = (String) {
-        .length = length,
+        throw(dataMallocError);
+    memcpy(pData, string.pData, string.length);
+    pData[string.length] = 0;
+    
+    *pResult = (String) {
+        .length = string.length,
         .pData = pData
     };
     return true;
     
-dataReallocError:
     free(pData);
+dataMallocError:
     return false;
 }
-bool parser_parseName(Parser* pParser, String* pName) {
-    size_t length = 0;
-    char* pData = malloc(1);
+bool createDescriptorOutput(int descriptor, Output* pOutput) {
+    struct iovec* pBlocks = malloc(OUTPUT_BLOCK_LIMIT * sizeof(struct iovec));
+    if (pBlocks == NULL)
+        throw(blocksMallocError);
+    char* pData = malloc(OUTPUT_BLOCK_SIZE);
     if (pData == NULL)
-        throw(dataReallocError);
-    do {
-        while (
-            isalnum(pParser->next) ||
-            pParser->next == '_' ||
-            pParser->next == '+' ||
-            pParser->next == '-' ||
-            pParser->next == '*' ||
-            pParser->next == '/' ||
-            pParser->next == '%' ||
-            pParser->next == '^' ||
-            pParser->next == '&' ||
-            pParser->next == '=' ||
-            pParser->next == '\'' ||
-            pParser->next == '"' ||
-            pParser->next == '\\' ||
-            pParser->next == ',' ||
-            pParser->next == '`'
-        ) {
-            char* pNewData = realloc(pData, length + 2);
-            if (pNewData == NULL)
-                throw(dataReallocError);
-            pData = pNewData;
-            pData[length] = (char) pParser->next;
-            length++;
-            parser_advance(pParser);
-        }
-        pData[length] = 0;
-        parser_skipWhitespace(pParser);
-        if (pParser->next != ':')
-            break;
-        char* pNewData = realloc(pData, length + 1);
-        if (pNewData == NULL)
-            throw(dataReallocError);
-        pData = pNewData;
-        pData[length] = (char) pParser->next;
-        length++;
-        parser_advance(pParser);
-        parser_skipWhitespace(pParser);
-    } while (true);
-    *pName = (String) {
-        .length = length,
-        .pData = pData
+        throw(dataMallocError);
+    pBlocks[0] = (struct iovec) {.iov_base = pData, .iov_len = 0};
+    
+    *pOutput = (Output) {
+        .kind = DESCRIPTOR_OUTPUT,
+        .descriptor = descriptor,
+        .isInteractive = isatty(descriptor) == 1,
+        .blockCount = 1,
+        .allocatedBlockCount = 1,
+        .blockCapacity = OUTPUT_BLOCK_LIMIT,
+        .pBlocks = pBlocks
     };
     return true;
-
-dataReallocError:
+    
     free(pData);
+dataMallocError:
+    free(pBlocks);
+blocksMallocError:
     return false;
 }
-bool parser_parseFileName(Parser* pParser, String* pFileName) {
+bool createFileOutput(char const* pFileName, Output* pOutput) {
+    int descriptor = open(pFileName, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (descriptor == -1)
+        throw(fileOpenError);
+    if (!createDescriptorOutput(descriptor, pOutput))
+        throw(outputCreateError);
+    return true;
+    
+outputCreateError:
+    close(descriptor);
+fileOpenError:
+    fprintf(stderr, "Could not open output file %s\n", pFileName);
+    return false;
+}
+bool createMemoryOutput(Output* pOutput) {
+    if (!createDescriptorOutput(-1, pOutput))
+        throw(outputCreateError);
+    pOutput->kind = MEMORY_OUTPUT;
+    pOutput->isInteractive = false;
+    return true;
+    
+outputCreateError:
+    return false;
+}
+void destroyOutput(Output outputState) {
+    if (outputState.pBlocks == NULL)
+        return;
+    if (outputState.kind == DESCRIPTOR_OUTPUT && outputState.descriptor > STDERR_FILENO)
+        close(outputState.descriptor);
+    for (size_t i = 0; i < outputState.allocatedBlockCount; i++)
+        free(outputState.pBlocks[i].iov_base);
+    free(outputState.pBlocks);
+}
+bool output_nextBlock(Output* pOutput) {
+    if (pOutput->kind == DESCRIPTOR_OUTPUT && pOutput->blockCount == OUTPUT_BLOCK_LIMIT)
+        return output_flush(pOutput);
+    if (pOutput->blockCount == pOutput->blockCapacity) {
+        size_t blockCapacity = pOutput->blockCapacity * 2;
+        struct iovec* pBlocks = realloc(pOutput->pBlocks, blockCapacity * sizeof(struct iovec));
+        if (pBlocks == NULL)
+            throw(blocksReallocError);
+        pOutput->pBlocks = pBlocks;
+        pOutput->blockCapacity = blockCapacity;
+    }
+    if (pOutput->blockCount == pOutput->allocatedBlockCount) {
+        char* pData = malloc(OUTPUT_BLOCK_SIZE);
+        if (pData == NULL)
+            throw(dataMallocError);
+        pOutput->pBlocks[pOutput->allocatedBlockCount] = (struct iovec) {.iov_base = pData, .iov_len = 0};
+        pOutput->allocatedBlockCount++;
+    }
+    pOutput->pBlocks[pOutput->blockCount].iov_len = 0;
+    pOutput->blockCount++;
+    return true;
+    
+dataMallocError:
+blocksReallocError:
+    return false;
+}
+bool output_write(Output* pOutput, void const* pData, size_t length) {
+    char const* pCharacters = pData;
+    while (length > 0) {
+        struct iovec* pBlock = &pOutput->pBlocks[pOutput->blockCount - 1];
+        size_t available = OUTPUT_BLOCK_SIZE - pBlock->iov_len;
+        if (available == 0) {
+            if (!output_nextBlock(pOutput))
+                return false;
+            continue;
+        }
+        size_t chunkLength = length < available ? length : available;
+        memcpy((char*) pBlock->iov_base + pBlock->iov_len, pCharacters, chunkLength);
+        pBlock->iov_len += chunkLength;
+        pCharacters += chunkLength;
+        length -= chunkLength;
+    }
+    return true;
+}
+bool output_writeCharacter(Output* pOutput, char character) {
+    struct iovec* pBlock = &pOutput->pBlocks[pOutput->blockCount - 1];
+    if (pBlock->iov_len == OUTPUT_BLOCK_SIZE)
+        return output_write(pOutput, &character, 1);
+    ((char*) pBlock->iov_base)[pBlock->iov_len] = character;
+    pBlock->iov_len++;
+    return true;
+}
+bool output_format(Output* pOutput, char const* pFormat, ...) {
+    va_list arguments;
+    va_start(arguments, pFormat);
+    int length = vsnprintf(NULL, 0, pFormat, arguments);
+    va_end(arguments);
+    if (length < 0)
+        throw(formatError);
+    
+    char* pData = malloc((size_t) length + 1);
+    if (pData == NULL)
+        throw(dataMallocError);
+    va_start(arguments, pFormat);
+    vsnprintf(pData, (size_t) length + 1, pFormat, arguments);
+    va_end(arguments);
+    if (!output_write(pOutput, pData, (size_t) length))
+        throw(dataWriteError);
+    free(pData);
+    return true;
+    
+dataWriteError:
+    free(pData);
+dataMallocError:
+formatError:
+    return false;
+}
+bool output_flush(Output* pOutput) {
+    if (pOutput->kind != DESCRIPTOR_OUTPUT)
+        return true;
+    size_t blockIndex = 0;
+    size_t blockOffset = 0;
+    while (blockIndex < pOutput->blockCount) {
+        struct iovec* pBlock = &pOutput->pBlocks[blockIndex];
+        struct iovec block = *pBlock;
+        pBlock->iov_base = (char*) block.iov_base + blockOffset;
+        pBlock->iov_len = block.iov_len - blockOffset;
+        ssize_t writtenLength = writev(pOutput->descriptor, pBlock, (int) (pOutput->blockCount - blockIndex));
+        *pBlock = block;
+        if (writtenLength == -1) {
+            if (errno == EINTR)
+                continue;
+            throw(writeError);
+        }
+        
+        size_t remainingLength = blockOffset + (size_t) writtenLength;
+        while (blockIndex < pOutput->blockCount && remainingLength >= pOutput->pBlocks[blockIndex].iov_len) {
+            remainingLength -= pOutput->pBlocks[blockIndex].iov_len;
+            blockIndex++;
+        }
+        blockOffset = remainingLength;
+    }
+    pOutput->blockCount = 1;
+    pOutput->pBlocks[0].iov_len = 0;
+    return true;
+    
+writeError:
+    fprintf(stderr, "Could not write output: %s\n", strerror(errno));
+    return false;
+}
+bool output_sync(Output* pOutput) {
+    if (!pOutput->isInteractive)
+        return true;
+    return output_flush(pOutput);
+}
+bool output_getString(Output outputState, String* pString) {
     size_t length = 0;
-    char* pData = malloc(1);
-    while (pParser->next != '<' && pParser->next != '>') {
-        char* pNewData = realloc(pData, length + 2);
-        if (pNewData == NULL)
-            throw(dataReallocError);
-        pData = pNewData;
-        pData[length] = (char) pParser->next;
-        length++;
-        parser_advance(pParser);
+    for (size_t i = 0; i < outputState.blockCount; i++)
+        length += outputState.pBlocks[i].iov_len;
+    char* pData = malloc(length + 1);
+    if (pData == NULL)
+        throw(dataMallocError);
+    
+    size_t offset = 0;
+    for (size_t i = 0; i < outputState.blockCount; i++) {
+        memcpy(&pData[offset], outputState.pBlocks[i].iov_base, outputState.pBlocks[i].iov_len);
+        offset += outputState.pBlocks[i].iov_len;
     }
     pData[length] = 0;
-    *pFileName = (String) {
+    
+    *pString = (String) {
         .length = length,
         .pData = pData
     };
     return true;
+    
+dataMallocError:
+    return false;
+}
+bool string_print(String string, Output* pOutput) {
+    return output_write(pOutput, string.pData, string.length);
+}
 
-dataReallocError:
-    free(pData);
+void destroyArena(Arena arena) {
+    for (size_t i = 0; i < arena.chunkCount; i++)
+        free(arena.pChunks[i].pData);
+    free(arena.pChunks);
+    free(arena.spareChunk.pData);
+}
+bool arena_allocate(Arena* pArena, size_t size, void** ppData) {
+    size = size == 0 ? 8 : (size + 7) & ~(size_t) 7;
+    if (pArena->chunkCount == 0 || pArena->offset + size > pArena->pChunks[pArena->chunkCount - 1].capacity) {
+        if (pArena->chunkCount == pArena->chunkCapacity) {
+            size_t chunkCapacity = pArena->chunkCapacity == 0 ? 8 : 2 * pArena->chunkCapacity;
+            ArenaChunk* pNewChunks = realloc(pArena->pChunks, chunkCapacity * sizeof(ArenaChunk));
+            if (pNewChunks == NULL)
+                throw(chunksReallocError);
+            pArena->pChunks = pNewChunks;
+            pArena->chunkCapacity = chunkCapacity;
+        }
+        if (pArena->spareChunk.pData != NULL && pArena->spareChunk.capacity >= size) {
+            pArena->pChunks[pArena->chunkCount] = pArena->spareChunk;
+            pArena->spareChunk = (ArenaChunk) {
+                .pData = NULL,
+                .capacity = 0
+            };
+        } else {
+            size_t capacity = pArena->chunkCount == 0
+                ? ARENA_CHUNK_SIZE
+                : 2 * pArena->pChunks[pArena->chunkCount - 1].capacity;
+            while (capacity < size)
+                capacity *= 2;
+            char* pData = malloc(capacity);
+            if (pData == NULL)
+                throw(chunkMallocError);
+            pArena->pChunks[pArena->chunkCount] = (ArenaChunk) {
+                .pData = pData,
+                .capacity = capacity
+            };
+        }
+        pArena->chunkCount++;
+        pArena->offset = 0;
+    }
+    *ppData = &pArena->pChunks[pArena->chunkCount - 1].pData[pArena->offset];
+    pArena->offset += size;
+    return true;
+    
+chunkMallocError:
+chunksReallocError:
+    return false;
+}
+bool arena_contains(Arena arena, void const* pData) {
+    char const* pBytes = pData;
+    for (size_t i = arena.chunkCount; i > 0; i--) {
+        ArenaChunk chunk = arena.pChunks[i - 1];
+        size_t length = i == arena.chunkCount ? arena.offset : chunk.capacity;
+        if (pBytes >= chunk.pData && pBytes < chunk.pData + length)
+            return true;
+    }
+    return false;
+}
+ArenaMark arena_mark(Arena arena) {
+    return (ArenaMark) {
+        .chunkCount = arena.chunkCount,
+        .offset = arena.offset
+    };
+}
+void arena_rewind(Arena* pArena, ArenaMark mark) {
+    while (pArena->chunkCount > mark.chunkCount) {
+        pArena->chunkCount--;
+        free(pArena->spareChunk.pData);
+        pArena->spareChunk = pArena->pChunks[pArena->chunkCount];
+    }
+    pArena->offset = mark.offset;
+}
+void arena_reset(Arena* pArena) {
+    if (pArena->chunkCount == 0)
+        return;
+    pArena->chunkCount--;
+    ArenaChunk lastChunk = pArena->pChunks[pArena->chunkCount];
+    while (pArena->chunkCount > 0) {
+        pArena->chunkCount--;
+        free(pArena->pChunks[pArena->chunkCount].pData);
+    }
+    pArena->pChunks[0] = lastChunk;
+    pArena->chunkCount = 1;
+    pArena->offset = 0;
+}
+void destroyNodeTable(NodeTable table) {
+    free(table.pHashes);
+    free(table.ppNodes);
+}
+bool nodeTable_grow(NodeTable* pTable) {
+    size_t capacity = pTable->capacity == 0 ? 64 : 2 * pTable->capacity;
+    uint64_t* pHashes = malloc(capacity * sizeof(uint64_t));
+    if (pHashes == NULL)
+        throw(hashesMallocError);
+    void** ppNodes = calloc(capacity, sizeof(void*));
+    if (ppNodes == NULL)
+        throw(nodesCallocError);
+    for (size_t i = 0; i < pTable->capacity; i++) {
+        if (pTable->ppNodes[i] == NULL)
+            continue;
+        size_t j = pTable->pHashes[i] & (capacity - 1);
+        while (ppNodes[j] != NULL)
+            j = (j + 1) & (capacity - 1);
+        pHashes[j] = pTable->pHashes[i];
+        ppNodes[j] = pTable->ppNodes[i];
+    }
+    destroyNodeTable(*pTable);
+    pTable->capacity = capacity;
+    pTable->pHashes = pHashes;
+    pTable->ppNodes = ppNodes;
+    return true;
+    
+nodesCallocError:
+    free(pHashes);
+hashesMallocError:
+    return false;
+}
+bool nodeTable_insert(NodeTable* pTable, uint64_t hash, void* pNode) {
+    if (2 * (pTable->nodeCount + 1) > pTable->capacity) {
+        if (!nodeTable_grow(pTable))
+            throw(tableGrowError);
+    }
+    size_t i = hash & (pTable->capacity - 1);
+    while (pTable->ppNodes[i] != NULL)
+        i = (i + 1) & (pTable->capacity - 1);
+    pTable->pHashes[i] = hash;
+    pTable->ppNodes[i] = pNode;
+    pTable->nodeCount++;
+    return true;
+    
+tableGrowError:
+    return false;
+}
+void nodeTable_retain(NodeTable* pTable, Arena arena) {
+    NodeTable table = EMPTY_NODE_TABLE;
+    for (size_t i = 0; i < pTable->capacity; i++) {
+        if (pTable->ppNodes[i] == NULL || !arena_contains(arena, pTable->ppNodes[i]))
+            continue;
+        if (!nodeTable_insert(&table, pTable->pHashes[i], pTable->ppNodes[i]))
+            throw(nodeInsertError);
+    }
+    destroyNodeTable(*pTable);
+    *pTable = table;
+    return;
+    
+nodeInsertError:
+    destroyNodeTable(table);
+    destroyNodeTable(*pTable);
+    *pTable = EMPTY_NODE_TABLE;
+}
+void destroyInstantiationTable(InstantiationTable table) {
+    free(table.pInstantiations);
+}
+void destroyRegion(Region region) {
+    destroyArena(region.arena);
+    destroyNodeTable(region.constructionTable);
+    destroyNodeTable(region.destructionTable);
+    destroyInstantiationTable(region.instantiationTable);
+    if (region.pImage != NULL)
+        munmap(region.pImage, region.imageLength);
+}
+void region_reset(Region* pRegion) {
+    arena_reset(&pRegion->arena);
+    destroyNodeTable(pRegion->constructionTable);
+    destroyNodeTable(pRegion->destructionTable);
+    pRegion->constructionTable = EMPTY_NODE_TABLE;
+    pRegion->destructionTable = EMPTY_NODE_TABLE;
+    destroyInstantiationTable(pRegion->instantiationTable);
+    pRegion->instantiationTable = EMPTY_INSTANTIATION_TABLE;
+    if (pRegion == &scratchRegion)
+        memo_clear();
+}
+void region_prune(Region* pRegion) {
+    nodeTable_retain(&pRegion->constructionTable, pRegion->arena);
+    nodeTable_retain(&pRegion->destructionTable, pRegion->arena);
+    destroyInstantiationTable(pRegion->instantiationTable);
+    pRegion->instantiationTable = EMPTY_INSTANTIATION_TABLE;
+}
+void region_rewind(Region* pRegion, ArenaMark mark) {
+    arena_rewind(&pRegion->arena, mark);
+    region_prune(pRegion);
+}
+bool region_owns(Region const* pRegion, void const* pData) {
+    char const* pBytes = pData;
+    for (; pRegion != NULL; pRegion = pRegion->pParent) {
+        if (arena_contains(pRegion->arena, pData))
+            return true;
+        if (pRegion->pImage != NULL && pBytes >= pRegion->pImage && pBytes < pRegion->pImage + pRegion->imageLength)
+            return true;
+    }
+    return false;
+}
+uint64_t string_hash(String string) {
+    uint64_t hash = 14695981039346656037u;
+    for (size_t i = 0; i < string.length; i++) {
+        hash ^= (unsigned char) string.pData[i];
+        hash *= 1099511628211u;
+    }
+    return hash;
+}
+uint64_t hash_combine(uint64_t hash, uint64_t value) {
+    hash = (hash ^ value) * 0x9E3779B97F4A7C15u;
+    return hash ^ (hash >> 32);
+}
+
+bool createSymbolTable(SymbolTable* pSymbolTable) {
+    size_t bucketCount = 1024;
+    Symbol* pBuckets = calloc(bucketCount, sizeof(Symbol));
+    if (pBuckets == NULL)
+        throw(bucketsCallocError);
+    
+    *pSymbolTable = (SymbolTable) {
+        .symbolCount = 0,
+        .symbolCapacity = 0,
+        .pStrings = NULL,
+        .pHashes = NULL,
+        .bucketCount = bucketCount,
+        .pBuckets = pBuckets,
+        .bufferLength = 0,
+        .pBuffer = NULL
+    };
+    Symbol emptySymbol;
+    if (!symbol_intern((String) {.length = 0, .pData = ""}, &emptySymbol))
+        throw(emptySymbolInternError);
+    return true;
+    
+emptySymbolInternError:
+    destroySymbolTable(*pSymbolTable);
+bucketsCallocError:
+    return false;
+}
+void destroySymbolTable(SymbolTable symbolTable) {
+    for (size_t i = 0; i < symbolTable.symbolCount; i++)
+        destroyString(symbolTable.pStrings[i]);
+    free(symbolTable.pStrings);
+    free(symbolTable.pHashes);
+    free(symbolTable.pBuckets);
+    free(symbolTable.pBuffer);
+}
+bool symbol_intern(String string, Symbol* pSymbol) {
+    uint64_t hash = string_hash(string);
+    size_t mask = symbols.bucketCount - 1;
+    size_t bucket;
+    for (bucket = hash & mask; symbols.pBuckets[bucket] != 0; bucket = (bucket + 1) & mask) {
+        Symbol symbol = symbols.pBuckets[bucket] - 1;
+        if (symbols.pHashes[symbol] == hash && string_equals(symbols.pStrings[symbol], string)) {
+            *pSymbol = symbol;
+            return true;
+        }
+    }
+    
+    if (symbols.symbolCount == symbols.symbolCapacity) {
+        size_t symbolCapacity = symbols.symbolCapacity == 0 ? 256 : 2 * symbols.symbolCapacity;
+        String* pNewStrings = realloc(symbols.pStrings, symbolCapacity * sizeof(String));
+        if (pNewStrings == NULL)
+            throw(stringsReallocError);
+        symbols.pStrings = pNewStrings;
+        uint64_t* pNewHashes = realloc(symbols.pHashes, symbolCapacity * sizeof(uint64_t));
+        if (pNewHashes == NULL)
+            throw(hashesReallocError);
+        symbols.pHashes = pNewHashes;
+        symbols.symbolCapacity = symbolCapacity;
+    }
+    String copy;
+    if (!string_duplicate(string, &copy))
+        throw(stringDuplicateError);
+    Symbol symbol = symbols.symbolCount;
+    symbols.pStrings[symbol] = copy;
+    symbols.pHashes[symbol] = hash;
+    symbols.pBuckets[bucket] = symbol + 1;
+    symbols.symbolCount++;
+    
+    if (2 * symbols.symbolCount > symbols.bucketCount) {
+        size_t bucketCount = 2 * symbols.bucketCount;
+        Symbol* pBuckets = calloc(bucketCount, sizeof(Symbol));
+        if (pBuckets == NULL)
+            throw(bucketsCallocError);
+        for (Symbol i = 0; i < symbols.symbolCount; i++) {
+            size_t newBucket = symbols.pHashes[i] & (bucketCount - 1);
+            while (pBuckets[newBucket] != 0)
+                newBucket = (newBucket + 1) & (bucketCount - 1);
+            pBuckets[newBucket] = i + 1;
+        }
+        free(symbols.pBuckets);
+        symbols.pBuckets = pBuckets;
+        symbols.bucketCount = bucketCount;
+    }
+    *pSymbol = symbol;
+    return true;
+    
+bucketsCallocError:
+    symbols.symbolCount--;
+    symbols.pBuckets[bucket] = 0;
+    destroyString(copy);
+stringDuplicateError:
+hashesReallocError:
+stringsReallocError:
+    return false;
+}
+bool symbol_qualify(Symbol namespace, Symbol name, Symbol* pSymbol) {
+    String namespaceString = symbols.pStrings[namespace];
+    String nameString = symbols.pStrings[name];
+    size_t length = namespaceString.length + 1 + nameString.length;
+    if (length > symbols.bufferLength) {
+        char* pNewBuffer = realloc(symbols.pBuffer, length);
+        if (pNewBuffer == NULL)
+            throw(bufferReallocError);
+        symbols.pBuffer = pNewBuffer;
+        symbols.bufferLength = length;
+    }
+    memcpy(symbols.pBuffer, namespaceString.pData, namespaceString.length);
+    symbols.pBuffer[namespaceString.length] = ':';
+    memcpy(&symbols.pBuffer[namespaceString.length + 1], nameString.pData, nameString.length);
+    return symbol_intern((String) {.length = length, .pData = symbols.pBuffer}, pSymbol);
+    
+bufferReallocError:
+    return false;
+}
+String symbol_getString(Symbol symbol) {
+    return symbols.pStrings[symbol];
+}
+bool symbol_print(Symbol symbol, Output* pOutput) {
+    return string_print(symbols.pStrings[symbol], pOutput);
+}
+
+size_t nameIndex_hash(Symbol name, size_t bucketCount) {
+    return (size_t) (((uint64_t) name * 0x9E3779B97F4A7C15u) >> 32) & (bucketCount - 1);
+}
+void destroyNameIndex(NameIndex nameIndex) {
+    free(nameIndex.pBuckets);
+}
+bool nameIndex_find(NameIndex nameIndex, Symbol const* pNames, size_t stride, Symbol name, size_t* pIndex) {
+    if (nameIndex.bucketCount == 0)
+        return false;
+    size_t mask = nameIndex.bucketCount - 1;
+    for (size_t bucket = nameIndex_hash(name, nameIndex.bucketCount); nameIndex.pBuckets[bucket] != 0; bucket = (bucket + 1) & mask) {
+        size_t index = nameIndex.pBuckets[bucket] - 1;
+        if (*(Symbol const*) ((char const*) pNames + index * stride) == name) {
+            *pIndex = index;
+            return true;
+        }
+    }
+    return false;
+}
+bool nameIndex_insert(NameIndex* pNameIndex, Symbol const* pNames, size_t stride, size_t index) {
+    if (2 * (pNameIndex->entryCount + 1) > pNameIndex->bucketCount) {
+        size_t bucketCount = pNameIndex->bucketCount == 0 ? 16 : 2 * pNameIndex->bucketCount;
+        size_t* pBuckets = calloc(bucketCount, sizeof(size_t));
+        if (pBuckets == NULL)
+            throw(bucketsCallocError);
+        for (size_t i = 0; i < pNameIndex->bucketCount; i++) {
+            size_t entry = pNameIndex->pBuckets[i];
+            if (entry == 0)
+                continue;
+            Symbol name = *(Symbol const*) ((char const*) pNames + (entry - 1) * stride);
+            size_t bucket = nameIndex_hash(name, bucketCount);
+            while (pBuckets[bucket] != 0)
+                bucket = (bucket + 1) & (bucketCount - 1);
+            pBuckets[bucket] = entry;
+        }
+        free(pNameIndex->pBuckets);
+        pNameIndex->pBuckets = pBuckets;
+        pNameIndex->bucketCount = bucketCount;
+    }
+    
+    Symbol name = *(Symbol const*) ((char const*) pNames + index * stride);
+    size_t mask = pNameIndex->bucketCount - 1;
+    size_t bucket;
+    for (bucket = nameIndex_hash(name, pNameIndex->bucketCount); pNameIndex->pBuckets[bucket] != 0; bucket = (bucket + 1) & mask) {
+        size_t other = pNameIndex->pBuckets[bucket] - 1;
+        if (*(Symbol const*) ((char const*) pNames + other * stride) == name)
+            return true;
+    }
+    pNameIndex->pBuckets[bucket] = index + 1;
+    pNameIndex->entryCount++;
+    return true;
+    
+bucketsCallocError:
+    return false;
+}
+bool nameIndex_rebuild(NameIndex* pNameIndex, Symbol const* pNames, size_t stride, size_t count) {
+    NameIndex nameIndex = EMPTY_NAME_INDEX;
+    for (size_t i = 0; i < count; i++) {
+        if (!nameIndex_insert(&nameIndex, pNames, stride, i))
+            throw(nameInsertError);
+    }
+    destroyNameIndex(*pNameIndex);
+    *pNameIndex = nameIndex;
+    return true;
+    
+nameInsertError:
+    destroyNameIndex(nameIndex);
     return false;
 }
 
-bool createConstructionExpression(Construction construction, Expression* pExpression) {
-    Construction* pData = malloc(sizeof(Construction));
+bool parser_parseWord(Parser* pParser, Symbol* pWord) {
+    size_t start = pParser->offset;
+    size_t offset = start;
+    while (offset < pParser->length && (CHARACTER_FLAGS[(unsigned char) pParser->pData[offset]] & WORD_CHARACTER))
+        offset++;
+    pParser->offset = offset;
+    parser_skipWhitespace(pParser);
+    return symbol_intern((String) {.length = offset - start, .pData = &pParser->pData[start]}, pWord);
+}
+bool parser_parseName(Parser* pParser, Symbol* pName) {
+    size_t start = pParser->offset;
+    size_t end;
+    bool isContiguous = true;
+    do {
+        while (
+            pParser->offset < pParser->length &&
+            (CHARACTER_FLAGS[(unsigned char) pParser->pData[pParser->offset]] & WORD_CHARACTER)
+        )
+            pParser->offset++;
+        end = pParser->offset;
+        parser_skipWhitespace(pParser);
+        if (pParser->next != ':')
+            break;
+        if (pParser->offset != end)
+            isContiguous = false;
+        parser_advance(pParser);
+        if (pParser->next != EOF && (CHARACTER_FLAGS[(unsigned char) pParser->next] & SPACE_CHARACTER))
+            isContiguous = false;
+        parser_skipWhitespace(pParser);
+    } while (true);
+    if (isContiguous)
+        return symbol_intern((String) {.length = end - start, .pData = &pParser->pData[start]}, pName);
+    
+    char* pData = malloc(end - start);
     if (pData == NULL)
         throw(dataMallocError);
-    *pData = construction;
+    size_t length = 0;
+    for (size_t i = start; i < end; i++) {
+        if (!(CHARACTER_FLAGS[(unsigned char) pParser->pData[i]] & SPACE_CHARACTER))
+            pData[length++] = pParser->pData[i];
+    }
+    if (!symbol_intern((String) {.length = length, .pData = pData}, pName))
+        throw(nameInternError);
+    free(pData);
+    return true;
+
+nameInternError:
+    free(pData);
+dataMallocError:
+    return false;
+}
+bool parser_parseFileName(Parser* pParser, String* pFileName) {
+    size_t start = pParser->offset;
+    while (pParser->next != EOF && pParser->next != '<' && pParser->next != '>')
+        parser_advance(pParser);
+    *pFileName = (String) {
+        .length = pParser->offset - start,
+        .pData = &pParser->pData[start]
+    };
+    return true;
+}
+
+bool expression_allocate(size_t size, void** ppData) {
+    if (size == 0) {
+        *ppData = NULL;
+        return true;
+    }
+    if (!collector.isActive)
+        return arena_allocate(&pExpressionRegion->arena, size, ppData);
+    
+    size = (size + 7) & ~(size_t) 7;
+    void* pData = size / 8 < COLLECTOR_SIZE_CLASS_COUNT ? collector.ppFreeLists[size / 8] : NULL;
+    if (pData != NULL)
+        collector.ppFreeLists[size / 8] = *(void**) pData;
+    else if (!arena_allocate(&pExpressionRegion->arena, size, &pData))
+        throw(dataAllocateError);
+    if (!collector_record(pData, size))
+        throw(allocationRecordError);
+    *ppData = pData;
+    return true;
+    
+allocationRecordError:
+dataAllocateError:
+    return false;
+}
+bool createConstructionExpression(Construction construction, Expression const* pArguments, Expression* pExpression) {
+    construction.hash = construction_hash(construction, pArguments);
+    construction.isClosed = construction_isClosed(construction, pArguments);
+    Construction* pData;
+    if (!region_findConstruction(pExpressionRegion, construction, pArguments, &pData)) {
+        if (!expression_allocate(sizeof(Construction) + construction.argumentCount * sizeof(Expression), (void**) &pData))
+            throw(dataAllocateError);
+        *pData = construction;
+        for (size_t i = 0; i < construction.argumentCount; i++)
+            construction_getArguments(pData)[i] = pArguments[i];
+        if (!nodeTable_insert(&pExpressionRegion->constructionTable, construction.hash, pData))
+            throw(dataInsertError);
+    }
     
     *pExpression = (Expression) {
         .kind = CONSTRUCTION_EXPRESSION,
@@ -365,14 +2370,14 @@ bool createConstructionExpression(Construction construction, Expression* pExpres
     };
     return true;
     
-    free(pData);
-dataMallocError:
+dataInsertError:
+dataAllocateError:
     return false;
 }
 bool createEvaluationExpression(Evaluation evaluation, Expression* pExpression) {
-    Evaluation* pData = malloc(sizeof(Evaluation));
-    if (pData == NULL)
-        throw(dataMallocError);
+    Evaluation* pData;
+    if (!expression_allocate(sizeof(Evaluation), (void**) &pData))
+        throw(dataAllocateError);
     *pData = evaluation;
     
     *pExpression = (Expression) {
@@ -381,27 +2386,13 @@ bool createEvaluationExpression(Evaluation evaluation, Expression* pExpression)
     };
     return true;
     
-    free(pData);
-dataMallocError:
+dataAllocateError:
     return false;
 }
-void destroyExpression(Expression expression) {
-    if (expression.kind == CONSTRUCTION_EXPRESSION) {
-        Construction* pConstruction = expression.pData;
-        for (size_t i = 0; i < pConstruction->argumentCount; i++)
-            destroyExpression(pConstruction->pArguments[i]);
-        free(pConstruction->pArguments);
-    }
-    if (expression.kind == EVALUATION_EXPRESSION) {
-        Evaluation* pEvaluation = expression.pData;
-        destroyEvaluation(*pEvaluation);
-    }
-    free(expression.pData);
-}
 bool createReferenceEvaluation(size_t index, Evaluation* pEvaluation) {
-    size_t* pData = malloc(sizeof(size_t));
-    if (pData == NULL)
-        throw(dataMallocError);
+    size_t* pData;
+    if (!expression_allocate(sizeof(size_t), (void**) &pData))
+        throw(dataAllocateError);
     *pData = index;
     
     *pEvaluation = (Evaluation) {
@@ -410,15 +2401,22 @@ bool createReferenceEvaluation(size_t index, Evaluation* pEvaluation) {
     };
     return true;
     
-    free(pData);
-dataMallocError:
+dataAllocateError:
     return false;
 }
 bool createDestructionEvaluation(Destruction destruction, Evaluation* pEvaluation) {
-    Destruction* pData = malloc(sizeof(Destruction));
-    if (pData == NULL)
-        throw(dataMallocError);
-    *pData = destruction;
+    destruction.hash = destruction_hash(destruction);
+    Destruction* pData;
+    if (!region_findDestruction(pExpressionRegion, destruction, &pData)) {
+        if (!expression_allocate(sizeof(Destruction) + destruction.argumentCount * sizeof(Expression), (void**) &pData))
+            throw(dataAllocateError);
+        *pData = destruction;
+        pData->pArguments = (Expression*) (pData + 1);
+        for (size_t i = 0; i < destruction.argumentCount; i++)
+            pData->pArguments[i] = destruction.pArguments[i];
+        if (!nodeTable_insert(&pExpressionRegion->destructionTable, destruction.hash, pData))
+            throw(dataInsertError);
+    }
     
     *pEvaluation = (Evaluation) {
         .kind = DESTRUCTION_EVALUATION,
@@ -426,33 +2424,49 @@ bool createDestructionEvaluation(Destruction destruction, Evaluation* pEvaluatio
     };
     return true;
     
-    free(pData);
-dataMallocError:
+dataInsertError:
+dataAllocateError:
     return false;
 }
-void destroyEvaluation(Evaluation evaluation) {
-    if (evaluation.kind == DESTRUCTION_EVALUATION) {
-        Destruction* pDestruction = evaluation.pData;
-        for (size_t i = 0; i < pDestruction->argumentCount; i++)
-            destroyExpression(pDestruction->pArguments[i]);
-        free(pDestruction->pArguments);
-        destroyEvaluation(pDestruction->caller);
+bool region_findConstruction(
+    Region const* pRegion, Construction construction, Expression const* pArguments, Construction** ppResult
+) {
+    for (; pRegion != NULL; pRegion = pRegion->pParent) {
+        NodeTable table = pRegion->constructionTable;
+        if (table.capacity == 0)
+            continue;
+        for (size_t i = construction.hash & (table.capacity - 1); table.ppNodes[i] != NULL; i = (i + 1) & (table.capacity - 1)) {
+            if (table.pHashes[i] == construction.hash && construction_equals(construction, pArguments, table.ppNodes[i])) {
+                *ppResult = table.ppNodes[i];
+                return true;
+            }
+        }
+    }
+    return false;
+}
+bool region_findDestruction(Region const* pRegion, Destruction destruction, Destruction** ppResult) {
+    for (; pRegion != NULL; pRegion = pRegion->pParent) {
+        NodeTable table = pRegion->destructionTable;
+        if (table.capacity == 0)
+            continue;
+        for (size_t i = destruction.hash & (table.capacity - 1); table.ppNodes[i] != NULL; i = (i + 1) & (table.capacity - 1)) {
+            if (table.pHashes[i] == destruction.hash && destruction_equals(*(Destruction*) table.ppNodes[i], destruction)) {
+                *ppResult = table.ppNodes[i];
+                return true;
+            }
+        }
     }
-    free(evaluation.pData);
+    return false;
 }
 bool expression_equals(Expression expression, Expression other) {
     if (expression.kind != other.kind)
         return false;
     if (expression.kind == CONSTRUCTION_EXPRESSION) {
+        if (expression.pData == other.pData)
+            return true;
         Construction* pConstruction = expression.pData;
         Construction* pOther = other.pData;
-        if (pConstruction->index != pOther->index)
-            return false;
-        for (size_t i = 0; i < pConstruction->argumentCount; i++) {
-            if (!expression_equals(pConstruction->pArguments[i], pOther->pArguments[i]))
-                return false;
-        }
-        return true;
+        return construction_equals(*pConstruction, construction_getArguments(pConstruction), pOther);
     }
     if (expression.kind == EVALUATION_EXPRESSION) {
         Evaluation* pEvaluation = expression.pData;
@@ -461,6 +2475,8 @@ bool expression_equals(Expression expression, Expression other) {
             return false;
         return true;
     }
+    if (expression.kind == THUNK_EXPRESSION)
+        return expression.pData == other.pData;
     return false;
 }
 bool evaluation_equals(Evaluation evaluation, Evaluation other) {
@@ -474,21 +2490,43 @@ bool evaluation_equals(Evaluation evaluation, Evaluation other) {
         return true;
     }
     if (evaluation.kind == DESTRUCTION_EVALUATION) {
+        if (evaluation.pData == other.pData)
+            return true;
         Destruction* pDestruction = evaluation.pData;
         Destruction* pOther = other.pData;
-        if (!evaluation_equals(pDestruction->caller, pOther->caller))
+        return destruction_equals(*pDestruction, *pOther);
+    }
+    return false;
+}
+bool construction_equals(Construction construction, Expression const* pArguments, Construction const* pOther) {
+    if (construction.hash != pOther->hash)
+        return false;
+    if (construction.index != pOther->index || construction.argumentCount != pOther->argumentCount)
+        return false;
+    for (size_t i = 0; i < construction.argumentCount; i++) {
+        if (!expression_equals(pArguments[i], construction_getArguments(pOther)[i]))
             return false;
-        if (pDestruction->index != pOther->index)
+    }
+    return true;
+}
+bool destruction_equals(Destruction destruction, Destruction other) {
+    if (destruction.hash != other.hash)
+        return false;
+    if (destruction.index != other.index || destruction.argumentCount != other.argumentCount)
+        return false;
+    if (!evaluation_equals(destruction.caller, other.caller))
+        return false;
+    for (size_t i = 0; i < destruction.argumentCount; i++) {
+        if (!expression_equals(destruction.pArguments[i], other.pArguments[i]))
             return false;
-        for (size_t i = 0; i < pDestruction->argumentCount; i++) {
-            if (!expression_equals(pDestruction->pArguments[i], pOther->pArguments[i]))
-                return false;
-        }
-        return true;
     }
-    return false;
+    return true;
 }
 bool expression_duplicate(Expression expression, Expression* pResult) {
+    if (region_owns(pExpressionRegion, expression.pData)) {
+        *pResult = expression;
+        return true;
+    }
     if (expression.kind == CONSTRUCTION_EXPRESSION) {
         Construction* pData = expression.pData;
         
@@ -497,27 +2535,24 @@ bool expression_duplicate(Expression expression, Expression* pResult) {
             throw(constructionArgumentsMallocError);
         size_t argumentCount;
         for (argumentCount = 0; argumentCount < pData->argumentCount; argumentCount++) {
-            if (!expression_duplicate(pData->pArguments[argumentCount], &pArguments[argumentCount]))
+            if (!expression_duplicate(construction_getArguments(pData)[argumentCount], &pArguments[argumentCount]))
                 throw(constructionArgumentDuplicateError);
         }
         
         Construction construction = {
             .index = pData->index,
-            .argumentCount = argumentCount,
-            .pArguments = pArguments
+            .argumentCount = argumentCount
         };
         Expression result;
-        if (!createConstructionExpression(construction, &result))
+        if (!createConstructionExpression(construction, pArguments, &result))
             throw(constructionExpressionCreateError);
         
         *pResult = result;
+        free(pArguments);
         return true;
     
-        destroyExpression(result);
     constructionExpressionCreateError:
     constructionArgumentDuplicateError:
-        for (size_t i = 0; i < argumentCount; i++)
-            destroyExpression(pArguments[i]);
         free(pArguments);
     constructionArgumentsMallocError:
         return false;
@@ -536,15 +2571,17 @@ bool expression_duplicate(Expression expression, Expression* pResult) {
         *pResult = result;
         return true;
     
-        destroyExpression(result);
     evaluationExpressionCreateError:
-        destroyEvaluation(evaluation);
     evaluationDuplicateError:
         return false;
     }
     return false;
 }
 bool evaluation_duplicate(Evaluation evaluation, Evaluation* pResult) {
+    if (region_owns(pExpressionRegion, evaluation.pData)) {
+        *pResult = evaluation;
+        return true;
+    }
     if (evaluation.kind == REFERENCE_EVALUATION) {
         size_t* pData = evaluation.pData;
         
@@ -555,7 +2592,6 @@ bool evaluation_duplicate(Evaluation evaluation, Evaluation* pResult) {
         *pResult = result;
         return true;
     
-        destroyEvaluation(result);
     referenceEvaluationCreateError:
         return false;
     }
@@ -586,23 +2622,675 @@ bool evaluation_duplicate(Evaluation evaluation, Evaluation* pResult) {
             throw(destructionEvaluationCreateError);
         
         *pResult = result;
+        free(pArguments);
         return true;
     
-        destroyEvaluation(result);
     destructionEvaluationCreateError:
     destructionArgumentDuplicateError:
-        for (size_t i = 0; i < argumentCount; i++)
-            destroyExpression(pArguments[i]);
         free(pArguments);
     destructionArgumentsMallocError:
-        destroyEvaluation(caller);
     destructionCallerDuplicateError:
         return false;
     }
     return false;
 }
 
-bool createEmptyModule(Module* pModule) {
+uint64_t expression_hash(Expression expression) {
+    if (expression.kind == CONSTRUCTION_EXPRESSION) {
+        Construction* pData = expression.pData;
+        return pData->hash;
+    }
+    uint64_t hash = hash_combine(0, expression.kind);
+    if (expression.kind == EVALUATION_EXPRESSION) {
+        Evaluation* pData = expression.pData;
+        hash = hash_combine(hash, evaluation_hash(*pData));
+    }
+    if (expression.kind == THUNK_EXPRESSION)
+        hash = hash_combine(hash, (uintptr_t) expression.pData);
+    return hash;
+}
+uint64_t evaluation_hash(Evaluation evaluation) {
+    if (evaluation.kind == DESTRUCTION_EVALUATION) {
+        Destruction* pData = evaluation.pData;
+        return pData->hash;
+    }
+    uint64_t hash = hash_combine(0, evaluation.kind);
+    if (evaluation.kind == REFERENCE_EVALUATION) {
+        size_t* pData = evaluation.pData;
+        hash = hash_combine(hash, *pData);
+    }
+    return hash;
+}
+uint64_t construction_hash(Construction construction, Expression const* pArguments) {
+    uint64_t hash = hash_combine(0, CONSTRUCTION_EXPRESSION);
+    hash = hash_combine(hash, construction.index);
+    hash = hash_combine(hash, construction.argumentCount);
+    for (size_t i = 0; i < construction.argumentCount; i++)
+        hash = hash_combine(hash, expression_hash(pArguments[i]));
+    return hash;
+}
+uint64_t destruction_hash(Destruction destruction) {
+    uint64_t hash = hash_combine(0, DESTRUCTION_EVALUATION);
+    hash = hash_combine(hash, evaluation_hash(destruction.caller));
+    hash = hash_combine(hash, destruction.index);
+    hash = hash_combine(hash, destruction.argumentCount);
+    for (size_t i = 0; i < destruction.argumentCount; i++)
+        hash = hash_combine(hash, expression_hash(destruction.pArguments[i]));
+    return hash;
+}
+bool construction_isClosed(Construction construction, Expression const* pArguments) {
+    for (size_t i = 0; i < construction.argumentCount; i++) {
+        Expression argument = pArguments[i];
+        if (argument.kind != CONSTRUCTION_EXPRESSION || !((Construction*) argument.pData)->isClosed)
+            return false;
+    }
+    return true;
+}
+static inline Expression* construction_getArguments(Construction const* pConstruction) {
+    return (Expression*) (pConstruction + 1);
+}
+bool instantiationTable_find(
+    InstantiationTable table, Construction const* pTypeConstruction, void const* pType, size_t* pIndex
+) {
+    if (table.capacity == 0)
+        return false;
+    size_t i = hash_combine((uintptr_t) pTypeConstruction, (uintptr_t) pType) & (table.capacity - 1);
+    while (table.pInstantiations[i].pTypeConstruction != NULL) {
+        Instantiation instantiation = table.pInstantiations[i];
+        if (instantiation.pTypeConstruction == pTypeConstruction && instantiation.pType == pType) {
+            *pIndex = i;
+            return true;
+        }
+        i = (i + 1) & (table.capacity - 1);
+    }
+    return false;
+}
+bool instantiationTable_insert(InstantiationTable* pTable, Instantiation instantiation) {
+    if (2 * (pTable->instantiationCount + 1) > pTable->capacity) {
+        size_t capacity = pTable->capacity == 0 ? 64 : 2 * pTable->capacity;
+        Instantiation* pInstantiations = calloc(capacity, sizeof(Instantiation));
+        if (pInstantiations == NULL)
+            throw(instantiationsCallocError);
+        for (size_t i = 0; i < pTable->capacity; i++) {
+            Instantiation oldInstantiation = pTable->pInstantiations[i];
+            if (oldInstantiation.pTypeConstruction == NULL)
+                continue;
+            size_t j = hash_combine((uintptr_t) oldInstantiation.pTypeConstruction, (uintptr_t) oldInstantiation.pType) & (capacity - 1);
+            while (pInstantiations[j].pTypeConstruction != NULL)
+                j = (j + 1) & (capacity - 1);
+            pInstantiations[j] = oldInstantiation;
+        }
+        free(pTable->pInstantiations);
+        pTable->capacity = capacity;
+        pTable->pInstantiations = pInstantiations;
+    }
+    size_t i = hash_combine((uintptr_t) instantiation.pTypeConstruction, (uintptr_t) instantiation.pType) & (pTable->capacity - 1);
+    while (pTable->pInstantiations[i].pTypeConstruction != NULL)
+        i = (i + 1) & (pTable->capacity - 1);
+    pTable->pInstantiations[i] = instantiation;
+    pTable->instantiationCount++;
+    return true;
+    
+instantiationsCallocError:
+    return false;
+}
+bool expression_isBounded(Expression expression, size_t count) {
+    if (expression.kind == CONSTRUCTION_EXPRESSION) {
+        Construction* pData = expression.pData;
+        if (pData->isClosed)
+            return true;
+        for (size_t i = 0; i < pData->argumentCount; i++) {
+            if (!expression_isBounded(construction_getArguments(pData)[i], count))
+                return false;
+        }
+        return true;
+    }
+    if (expression.kind == EVALUATION_EXPRESSION)
+        return evaluation_isBounded(*(Evaluation*) expression.pData, count);
+    return false;
+}
+bool evaluation_isBounded(Evaluation evaluation, size_t count) {
+    if (evaluation.kind == REFERENCE_EVALUATION)
+        return *(size_t*) evaluation.pData < count;
+    if (evaluation.kind == DESTRUCTION_EVALUATION) {
+        Destruction* pData = evaluation.pData;
+        if (!evaluation_isBounded(pData->caller, count))
+            return false;
+        for (size_t i = 0; i < pData->argumentCount; i++) {
+            if (!expression_isBounded(pData->pArguments[i], count))
+                return false;
+        }
+        return true;
+    }
+    return false;
+}
+size_t expression_getBound(Expression expression) {
+    if (expression.kind == CONSTRUCTION_EXPRESSION) {
+        Construction* pData = expression.pData;
+        if (pData->isClosed)
+            return 0;
+        size_t bound = 0;
+        for (size_t i = 0; i < pData->argumentCount; i++) {
+            size_t argumentBound = expression_getBound(construction_getArguments(pData)[i]);
+            if (argumentBound > bound)
+                bound = argumentBound;
+        }
+        return bound;
+    }
+    if (expression.kind == EVALUATION_EXPRESSION)
+        return evaluation_getBound(*(Evaluation*) expression.pData);
+    return 0;
+}
+size_t evaluation_getBound(Evaluation evaluation) {
+    if (evaluation.kind == REFERENCE_EVALUATION)
+        return *(size_t*) evaluation.pData + 1;
+    if (evaluation.kind == DESTRUCTION_EVALUATION) {
+        Destruction* pData = evaluation.pData;
+        size_t bound = evaluation_getBound(pData->caller);
+        for (size_t i = 0; i < pData->argumentCount; i++) {
+            size_t argumentBound = expression_getBound(pData->pArguments[i]);
+            if (argumentBound > bound)
+                bound = argumentBound;
+        }
+        return bound;
+    }
+    return 0;
+}
+void destroyCollector(Collector* pCollector) {
+    free(pCollector->pAllocations);
+    free(pCollector->pItems);
+    free(pCollector->ppRememberedThunks);
+}
+void collector_enter(void) {
+    if (collector.depth++ > 0)
+        return;
+    collector.epoch++;
+    collector.isActive = pExpressionRegion == &scratchRegion;
+    collector.allocationCount = 0;
+    collector.allocatedBytes = 0;
+    collector.liveBytes = 0;
+    collector.threshold = COLLECTOR_MINIMUM_THRESHOLD;
+}
+void collector_leave(void) {
+    if (--collector.depth > 0)
+        return;
+    collector.isActive = false;
+    collector.allocationCount = 0;
+    collector.rememberedCount = 0;
+    for (size_t i = 0; i < COLLECTOR_SIZE_CLASS_COUNT; i++)
+        collector.ppFreeLists[i] = NULL;
+}
+bool collector_poll(void) {
+    if (!collector.isActive || collector.allocatedBytes < collector.threshold)
+        return true;
+    return collector_collect();
+}
+bool collector_pushItem(MarkItem item) {
+    if (collector.itemCount == collector.itemCapacity) {
+        size_t itemCapacity = collector.itemCapacity == 0 ? 1024 : 2 * collector.itemCapacity;
+        MarkItem* pItems = realloc(collector.pItems, itemCapacity * sizeof(MarkItem));
+        if (pItems == NULL)
+            throw(itemsReallocError);
+        collector.pItems = pItems;
+        collector.itemCapacity = itemCapacity;
+    }
+    collector.pItems[collector.itemCount++] = item;
+    return true;
+    
+itemsReallocError:
+    return false;
+}
+bool collector_pushExpression(Expression expression) {
+    if (expression.kind == UNSPECIFIED_EXPRESSION || expression.kind == DEFERRED_EXPRESSION)
+        return true;
+    return collector_pushItem((MarkItem) {
+        .isEvaluation = false,
+        .kind = expression.kind,
+        .pData = expression.pData
+    });
+}
+bool collector_pushSubstitutions(Substitution const* pSubstitutions, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        if (!collector_pushExpression(pSubstitutions[i].type) || !collector_pushExpression(pSubstitutions[i].value))
+            return false;
+    }
+    return true;
+}
+bool collector_record(void* pData, size_t size) {
+    if (collector.allocationCount == collector.allocationCapacity) {
+        size_t allocationCapacity = collector.allocationCapacity == 0 ? 4096 : 2 * collector.allocationCapacity;
+        Allocation* pAllocations = realloc(collector.pAllocations, allocationCapacity * sizeof(Allocation));
+        if (pAllocations == NULL)
+            throw(allocationsReallocError);
+        collector.pAllocations = pAllocations;
+        collector.allocationCapacity = allocationCapacity;
+    }
+    collector.pAllocations[collector.allocationCount++] = (Allocation) {
+        .pData = pData,
+        .size = size
+    };
+    collector.allocatedBytes += size;
+    if (collector.liveBytes + collector.allocatedBytes > collector.peakBytes)
+        collector.peakBytes = collector.liveBytes + collector.allocatedBytes;
+    return true;
+    
+allocationsReallocError:
+    return false;
+}
+bool collector_remember(Thunk* pThunk) {
+    if (collector.rememberedCount == collector.rememberedCapacity) {
+        size_t rememberedCapacity = collector.rememberedCapacity == 0 ? 64 : 2 * collector.rememberedCapacity;
+        Thunk** ppRememberedThunks = realloc(collector.ppRememberedThunks, rememberedCapacity * sizeof(Thunk*));
+        if (ppRememberedThunks == NULL)
+            throw(rememberedThunksReallocError);
+        collector.ppRememberedThunks = ppRememberedThunks;
+        collector.rememberedCapacity = rememberedCapacity;
+    }
+    collector.ppRememberedThunks[collector.rememberedCount++] = pThunk;
+    return true;
+    
+rememberedThunksReallocError:
+    return false;
+}
+bool collector_pushStack(NodeSet set) {
+    __builtin_unwind_init();
+    NodeTable table = scratchRegion.constructionTable;
+    Construction** ppConstructions = malloc((table.capacity + 1) * sizeof(Construction*));
+    if (ppConstructions == NULL)
+        throw(constructionsMallocError);
+    size_t count = 0;
+    for (size_t i = 0; i < table.capacity; i++) {
+        if (table.ppNodes[i] != NULL && set.ppNodes[nodeSet_find(set, table.ppNodes[i])] != NULL)
+            ppConstructions[count++] = table.ppNodes[i];
+    }
+    qsort(ppConstructions, count, sizeof(Construction*), collector_compareConstructions);
+    if (!collector_pushStackRange(count, ppConstructions))
+        throw(rangePushError);
+    free(ppConstructions);
+    return true;
+    
+rangePushError:
+    free(ppConstructions);
+constructionsMallocError:
+    return false;
+}
+__attribute__((noinline, no_sanitize_address))
+bool collector_pushStackRange(size_t count, Construction* const* ppConstructions) {
+    for (uintptr_t const* pWord = __builtin_frame_address(0); (char const*) pWord < native.pStackBase; pWord++) {
+        size_t low = 0;
+        size_t high = count;
+        while (low < high) {
+            size_t middle = low + (high - low) / 2;
+            if ((uintptr_t) ppConstructions[middle] <= *pWord)
+                low = middle + 1;
+            else
+                high = middle;
+        }
+        if (low == 0)
+            continue;
+        Construction* pData = ppConstructions[low - 1];
+        if (*pWord >= (uintptr_t) (construction_getArguments(pData) + pData->argumentCount))
+            continue;
+        if (!collector_pushItem((MarkItem) {
+            .isEvaluation = false,
+            .kind = CONSTRUCTION_EXPRESSION,
+            .pData = pData
+        }))
+            return false;
+    }
+    return true;
+}
+int collector_compareConstructions(void const* pLeft, void const* pRight) {
+    uintptr_t left = (uintptr_t) *(Construction* const*) pLeft;
+    uintptr_t right = (uintptr_t) *(Construction* const*) pRight;
+    return (left > right) - (left < right);
+}
+bool collector_collect(void) {
+    struct timespec startTime;
+    clock_gettime(CLOCK_MONOTONIC, &startTime);
+    
+    size_t capacity = 64;
+    while (capacity < 2 * collector.allocationCount)
+        capacity *= 2;
+    NodeSet set = {
+        .capacity = capacity,
+        .ppNodes = calloc(capacity, sizeof(void*)),
+        .pIsMarked = calloc(capacity, sizeof(bool))
+    };
+    if (set.ppNodes == NULL || set.pIsMarked == NULL)
+        throw(setCallocError);
+    for (size_t i = 0; i < collector.allocationCount; i++)
+        set.ppNodes[nodeSet_find(set, collector.pAllocations[i].pData)] = collector.pAllocations[i].pData;
+    
+    collector.itemCount = 0;
+    if (!evaluator_pushRoots())
+        throw(rootPushError);
+    if (!memo_pushRoots())
+        throw(rootPushError);
+    if (native.pStackBase != NULL && !collector_pushStack(set))
+        throw(rootPushError);
+    for (size_t i = 0; i < collector.rememberedCount; i++) {
+        if (!collector_pushExpression(collector.ppRememberedThunks[i]->value))
+            throw(rootPushError);
+    }
+    while (collector.itemCount > 0) {
+        MarkItem item = collector.pItems[--collector.itemCount];
+        size_t slot = nodeSet_find(set, item.pData);
+        if (set.ppNodes[slot] == NULL || set.pIsMarked[slot])
+            continue;
+        set.pIsMarked[slot] = true;
+        
+        size_t argumentCount = 0;
+        Expression const* pArguments = NULL;
+        if (!item.isEvaluation && item.kind == CONSTRUCTION_EXPRESSION) {
+            Construction* pData = item.pData;
+            argumentCount = pData->argumentCount;
+            pArguments = construction_getArguments(pData);
+        } else if (!item.isEvaluation && item.kind == EVALUATION_EXPRESSION) {
+            Evaluation* pData = item.pData;
+            if (!collector_pushItem((MarkItem) {
+                .isEvaluation = true,
+                .kind = pData->kind,
+                .pData = pData->pData
+            }))
+                throw(itemPushError);
+        } else if (item.isEvaluation && item.kind == DESTRUCTION_EVALUATION) {
+            Destruction* pData = item.pData;
+            if (!collector_pushItem((MarkItem) {
+                .isEvaluation = true,
+                .kind = pData->caller.kind,
+                .pData = pData->caller.pData
+            }))
+                throw(itemPushError);
+            argumentCount = pData->argumentCount;
+            pArguments = pData->pArguments;
+        } else if (!item.isEvaluation && item.kind == THUNK_EXPRESSION) {
+            Thunk* pData = item.pData;
+            if (pData->value.kind != UNSPECIFIED_EXPRESSION) {
+                argumentCount = 1;
+                pArguments = &pData->value;
+            } else if (!collector_pushSubstitutions(pData->pSubstitutions, pData->substitutionCount))
+                throw(itemPushError);
+        }
+        for (size_t i = 0; i < argumentCount; i++) {
+            if (!collector_pushItem((MarkItem) {
+                .isEvaluation = false,
+                .kind = pArguments[i].kind,
+                .pData = pArguments[i].pData
+            }))
+                throw(itemPushError);
+        }
+    }
+    
+    nodeTable_discard(&scratchRegion.constructionTable, set);
+    nodeTable_discard(&scratchRegion.destructionTable, set);
+    destroyInstantiationTable(scratchRegion.instantiationTable);
+    scratchRegion.instantiationTable = EMPTY_INSTANTIATION_TABLE;
+    size_t allocationCount = 0;
+    size_t liveBytes = 0;
+    for (size_t i = 0; i < collector.allocationCount; i++) {
+        Allocation allocation = collector.pAllocations[i];
+        if (set.pIsMarked[nodeSet_find(set, allocation.pData)]) {
+            collector.pAllocations[allocationCount++] = allocation;
+            liveBytes += allocation.size;
+            continue;
+        }
+        collector.reclaimedBytes += allocation.size;
+        if (allocation.size / 8 < COLLECTOR_SIZE_CLASS_COUNT) {
+            *(void**) allocation.pData = collector.ppFreeLists[allocation.size / 8];
+            collector.ppFreeLists[allocation.size / 8] = allocation.pData;
+        }
+    }
+    collector.allocationCount = allocationCount;
+    collector.liveBytes = liveBytes;
+    collector.allocatedBytes = 0;
+    collector.threshold = liveBytes > COLLECTOR_MINIMUM_THRESHOLD ? liveBytes : COLLECTOR_MINIMUM_THRESHOLD;
+    free(set.ppNodes);
+    free(set.pIsMarked);
+    
+    struct timespec endTime;
+    clock_gettime(CLOCK_MONOTONIC, &endTime);
+    double milliseconds = (endTime.tv_sec - startTime.tv_sec) * 1e3 + (endTime.tv_nsec - startTime.tv_nsec) / 1e6;
+    collector.collectionCount++;
+    collector.pauseMilliseconds += milliseconds;
+    if (milliseconds > collector.longestPauseMilliseconds)
+        collector.longestPauseMilliseconds = milliseconds;
+    return true;
+    
+itemPushError:
+rootPushError:
+setCallocError:
+    free(set.ppNodes);
+    free(set.pIsMarked);
+    return false;
+}
+size_t nodeSet_find(NodeSet set, void const* pNode) {
+    size_t i = hash_combine(0, (uintptr_t) pNode) & (set.capacity - 1);
+    while (set.ppNodes[i] != NULL && set.ppNodes[i] != pNode)
+        i = (i + 1) & (set.capacity - 1);
+    return i;
+}
+void nodeTable_discard(NodeTable* pTable, NodeSet set) {
+    NodeTable table = EMPTY_NODE_TABLE;
+    for (size_t i = 0; i < pTable->capacity; i++) {
+        if (pTable->ppNodes[i] == NULL)
+            continue;
+        size_t slot = nodeSet_find(set, pTable->ppNodes[i]);
+        if (set.ppNodes[slot] != NULL && !set.pIsMarked[slot])
+            continue;
+        if (!nodeTable_insert(&table, pTable->pHashes[i], pTable->ppNodes[i]))
+            throw(nodeInsertError);
+    }
+    destroyNodeTable(*pTable);
+    *pTable = table;
+    return;
+    
+nodeInsertError:
+    destroyNodeTable(table);
+    destroyNodeTable(*pTable);
+    *pTable = EMPTY_NODE_TABLE;
+}
+void collector_printStatistics(void) {
+    fprintf(
+        stderr, "Collector: %lu collections, %.3f ms paused (longest %.3f ms), %lu KB reclaimed, %lu KB peak heap\n",
+        collector.collectionCount, collector.pauseMilliseconds, collector.longestPauseMilliseconds,
+        collector.reclaimedBytes / 1024, collector.peakBytes / 1024
+    );
+}
+void destroyMemo(Memo* pMemo) {
+    for (size_t i = 0; i < pMemo->entryCount; i++)
+        free(pMemo->pEntries[i].pArguments);
+    free(pMemo->pEntries);
+    free(pMemo->pBuckets);
+}
+void memo_clear(void) {
+    if (memo.entryCount == 0)
+        return;
+    for (size_t i = 0; i < memo.entryCount; i++)
+        free(memo.pEntries[i].pArguments);
+    for (size_t i = 0; i < memo.bucketCount; i++)
+        memo.pBuckets[i] = NO_MEMO_ENTRY;
+    memo.entryCount = 0;
+    memo.newestEntry = NO_MEMO_ENTRY;
+    memo.oldestEntry = NO_MEMO_ENTRY;
+}
+uint64_t memo_hash(
+    Construction const* pTypeConstruction, size_t index, Expression caller, size_t argumentCount,
+    Expression const* pArguments
+) {
+    uint64_t hash = hash_combine(pTypeConstruction->hash, index);
+    hash = hash_combine(hash, expression_hash(caller));
+    for (size_t i = 0; i < argumentCount; i++)
+        hash = hash_combine(hash, expression_hash(pArguments[i]));
+    return hash;
+}
+bool memo_find(
+    Construction const* pTypeConstruction, size_t index, Expression caller, size_t argumentCount,
+    Expression const* pArguments, uint64_t hash, Expression* pValue
+) {
+    if (memo.bucketCount == 0) {
+        memo.missCount++;
+        return false;
+    }
+    for (size_t i = memo.pBuckets[hash & (memo.bucketCount - 1)]; i != NO_MEMO_ENTRY; i = memo.pEntries[i].nextInBucket) {
+        MemoEntry entry = memo.pEntries[i];
+        if (entry.hash != hash || entry.index != index || entry.argumentCount != argumentCount)
+            continue;
+        bool isEqual = entry.pTypeConstruction == pTypeConstruction || construction_equals(
+            *pTypeConstruction, construction_getArguments(pTypeConstruction), entry.pTypeConstruction
+        );
+        isEqual = isEqual && expression_equals(entry.caller, caller);
+        for (size_t j = 0; isEqual && j < argumentCount; j++)
+            isEqual = expression_equals(entry.pArguments[j], pArguments[j]);
+        if (!isEqual)
+            continue;
+        memo_touch(i);
+        memo.hitCount++;
+        *pValue = entry.value;
+        return true;
+    }
+    memo.missCount++;
+    return false;
+}
+bool memo_insert(
+    Construction const* pTypeConstruction, size_t index, Expression caller, size_t argumentCount,
+    Expression const* pArguments, uint64_t hash, Expression value
+) {
+    if (memo.entryCount == memo.entryCapacity && memo.entryCapacity < memo.entryLimit) {
+        if (!memo_grow())
+            throw(growError);
+    }
+    Expression* pArgumentCopies = NULL;
+    if (argumentCount > 0) {
+        pArgumentCopies = malloc(argumentCount * sizeof(Expression));
+        if (pArgumentCopies == NULL)
+            throw(argumentCopiesMallocError);
+        memcpy(pArgumentCopies, pArguments, argumentCount * sizeof(Expression));
+    }
+    
+    size_t entryIndex;
+    if (memo.entryCount < memo.entryCapacity) {
+        entryIndex = memo.entryCount++;
+    } else {
+        entryIndex = memo.oldestEntry;
+        memo_unlink(entryIndex);
+        free(memo.pEntries[entryIndex].pArguments);
+        memo.evictionCount++;
+    }
+    size_t bucket = hash & (memo.bucketCount - 1);
+    memo.pEntries[entryIndex] = (MemoEntry) {
+        .hash = hash,
+        .pTypeConstruction = pTypeConstruction,
+        .index = index,
+        .caller = caller,
+        .argumentCount = argumentCount,
+        .pArguments = pArgumentCopies,
+        .value = value,
+        .nextInBucket = memo.pBuckets[bucket],
+        .newerEntry = NO_MEMO_ENTRY,
+        .olderEntry = memo.newestEntry
+    };
+    memo.pBuckets[bucket] = entryIndex;
+    if (memo.newestEntry != NO_MEMO_ENTRY)
+        memo.pEntries[memo.newestEntry].newerEntry = entryIndex;
+    else
+        memo.oldestEntry = entryIndex;
+    memo.newestEntry = entryIndex;
+    return true;
+    
+argumentCopiesMallocError:
+growError:
+    return false;
+}
+bool memo_grow(void) {
+    size_t entryCapacity = memo.entryCapacity == 0 ? 64 : 2 * memo.entryCapacity;
+    if (entryCapacity > memo.entryLimit)
+        entryCapacity = memo.entryLimit;
+    MemoEntry* pEntries = realloc(memo.pEntries, entryCapacity * sizeof(MemoEntry));
+    if (pEntries == NULL)
+        throw(entriesReallocError);
+    memo.pEntries = pEntries;
+    memo.entryCapacity = entryCapacity;
+    
+    size_t bucketCount = 64;
+    while (bucketCount < entryCapacity)
+        bucketCount *= 2;
+    if (bucketCount == memo.bucketCount)
+        return true;
+    size_t* pBuckets = realloc(memo.pBuckets, bucketCount * sizeof(size_t));
+    if (pBuckets == NULL)
+        throw(bucketsReallocError);
+    memo.pBuckets = pBuckets;
+    memo.bucketCount = bucketCount;
+    for (size_t i = 0; i < bucketCount; i++)
+        pBuckets[i] = NO_MEMO_ENTRY;
+    for (size_t i = 0; i < memo.entryCount; i++) {
+        size_t bucket = memo.pEntries[i].hash & (bucketCount - 1);
+        memo.pEntries[i].nextInBucket = pBuckets[bucket];
+        pBuckets[bucket] = i;
+    }
+    return true;
+    
+bucketsReallocError:
+entriesReallocError:
+    return false;
+}
+void memo_unlink(size_t entryIndex) {
+    MemoEntry entry = memo.pEntries[entryIndex];
+    size_t* pLink = &memo.pBuckets[entry.hash & (memo.bucketCount - 1)];
+    while (*pLink != entryIndex)
+        pLink = &memo.pEntries[*pLink].nextInBucket;
+    *pLink = entry.nextInBucket;
+    if (entry.newerEntry != NO_MEMO_ENTRY)
+        memo.pEntries[entry.newerEntry].olderEntry = entry.olderEntry;
+    else
+        memo.newestEntry = entry.olderEntry;
+    if (entry.olderEntry != NO_MEMO_ENTRY)
+        memo.pEntries[entry.olderEntry].newerEntry = entry.newerEntry;
+    else
+        memo.oldestEntry = entry.newerEntry;
+}
+void memo_touch(size_t entryIndex) {
+    MemoEntry* pEntry = &memo.pEntries[entryIndex];
+    if (pEntry->newerEntry == NO_MEMO_ENTRY)
+        return;
+    memo.pEntries[pEntry->newerEntry].olderEntry = pEntry->olderEntry;
+    if (pEntry->olderEntry != NO_MEMO_ENTRY)
+        memo.pEntries[pEntry->olderEntry].newerEntry = pEntry->newerEntry;
+    else
+        memo.oldestEntry = pEntry->newerEntry;
+    pEntry->newerEntry = NO_MEMO_ENTRY;
+    pEntry->olderEntry = memo.newestEntry;
+    memo.pEntries[memo.newestEntry].newerEntry = entryIndex;
+    memo.newestEntry = entryIndex;
+}
+bool memo_pushRoots(void) {
+    for (size_t i = 0; i < memo.entryCount; i++) {
+        MemoEntry entry = memo.pEntries[i];
+        Expression typeConstruction = {.kind = CONSTRUCTION_EXPRESSION, .pData = (void*) entry.pTypeConstruction};
+        if (!collector_pushExpression(typeConstruction))
+            throw(itemPushError);
+        if (!collector_pushExpression(entry.caller) || !collector_pushExpression(entry.value))
+            throw(itemPushError);
+        for (size_t j = 0; j < entry.argumentCount; j++) {
+            if (!collector_pushExpression(entry.pArguments[j]))
+                throw(itemPushError);
+        }
+    }
+    return true;
+    
+itemPushError:
+    return false;
+}
+void memo_printStatistics(void) {
+    size_t lookupCount = memo.hitCount + memo.missCount;
+    fprintf(
+        stderr, "Memo: %lu hits, %lu misses (%.1f%% hit rate), %lu evictions\n",
+        memo.hitCount, memo.missCount, lookupCount == 0 ? 0.0 : 100.0 * memo.hitCount / lookupCount,
+        memo.evictionCount
+    );
+}
+bool createEmptyModule(Module* pModule) {
     size_t matrixCount = 1;
     Matrix* pMatrices = malloc(sizeof(Matrix));
     if (pMatrices == NULL)
@@ -613,9 +3301,9 @@ bool createEmptyModule(Module* pModule) {
     if (pTypeConstructors == NULL)
         throw(typeConstructorsMallocError);
     
-    String universeTypeName;
-    if (!createStringFromCString("Type", &universeTypeName))
-        throw(universeTypeNameCreateError);
+    Symbol universeTypeName;
+    if (!symbol_intern((String) {.length = 4, .pData = "Type"}, &universeTypeName))
+        throw(universeTypeNameInternError);
     
     pTypeConstructors[0] = (Constructor) {
         .depth = 0,
@@ -625,18 +3313,36 @@ bool createEmptyModule(Module* pModule) {
     };
     pMatrices[0] = (Matrix) {
         .constructorCount = typeConstructorCount,
+        .constructorCapacity = typeConstructorCount,
         .pConstructors = pTypeConstructors,
         .destructorCount = 0,
-        .pDestructors = NULL
+        .destructorCapacity = 0,
+        .pDestructors = NULL,
+        .ruleRowCapacity = 0,
+        .ruleColumnCapacity = 0,
+        .pRules = NULL,
+        .constructorIndex = EMPTY_NAME_INDEX,
+        .destructorIndex = EMPTY_NAME_INDEX
     };
+    if (!nameIndex_rebuild(&pMatrices[0].constructorIndex, &pTypeConstructors->name, sizeof(Constructor), typeConstructorCount))
+        throw(typeIndexBuildError);
     *pModule = (Module) {
         .matrixCount = matrixCount,
-        .pMatrices = pMatrices
+        .matrixCapacity = matrixCount,
+        .pMatrices = pMatrices,
+        .operationCount = 0,
+        .operationCapacity = 0,
+        .pOperations = NULL,
+        .renameCount = 0,
+        .renameCapacity = 0,
+        .pRenames = NULL,
+        .fingerprint = EMPTY_MODULE_FINGERPRINT,
+        .region = EMPTY_REGION
     };
     return true;
     
-    destroyString(universeTypeName);
-universeTypeNameCreateError:
+typeIndexBuildError:
+universeTypeNameInternError:
     free(pTypeConstructors);
 typeConstructorsMallocError:
     free(pMatrices);
@@ -646,289 +3352,623 @@ matricesMallocError:
 void destroyModule(Module module) {
     for (size_t i = 0; i < module.matrixCount; i++) {
         Matrix matrix = module.pMatrices[i];
-        for (size_t j = 0; j < matrix.destructorCount; j++) {
-            Destructor destructor = matrix.pDestructors[j];
-            for (size_t k = 0; k < matrix.constructorCount; k++)
-                destroyExpression(destructor.pRules[k]);
-            free(destructor.pRules);
-            destroyExpression(destructor.returnType);
-            for (size_t k = 0; k < destructor.parameterCount; k++)
-                destroyExpression(destructor.pParameterTypes[k]);
-            free(destructor.pParameterTypes);
-            destroyString(destructor.name);
-        }
+        free(matrix.pRules);
         free(matrix.pDestructors);
-        for (size_t j = 0; j < matrix.constructorCount; j++) {
-            Constructor constructor = matrix.pConstructors[j];
-            for (size_t k = 0; k < constructor.parameterCount; k++)
-                destroyExpression(constructor.pParameterTypes[k]);
-            free(constructor.pParameterTypes);
-            destroyString(constructor.name);
-        }
         free(matrix.pConstructors);
+        destroyNameIndex(matrix.constructorIndex);
+        destroyNameIndex(matrix.destructorIndex);
     }
     free(module.pMatrices);
+    free(module.pOperations);
+    free(module.pRenames);
+    destroyRegion(module.region);
 }
-bool expression_substitute(
-    Expression expression, Module module, Substitution const* pSubstitutions,
-    Expression* pResult
-) {
-    if (expression.kind == CONSTRUCTION_EXPRESSION) {
-        Construction* pData = expression.pData;
-        
-        Expression* pArguments = malloc(pData->argumentCount * sizeof(Expression));
-        if (pArguments == NULL)
-            throw(constructionArgumentsMallocError);
-        size_t argumentCount;
-        for (argumentCount = 0; argumentCount < pData->argumentCount; argumentCount++) {
-            if (!expression_substitute(
-                pData->pArguments[argumentCount], module, pSubstitutions,
-                &pArguments[argumentCount]
-            ))
-                throw(constructionArgumentSubstituteError);
-        }
-        
-        Construction construction = {
-            .index = pData->index,
-            .argumentCount = argumentCount,
-            .pArguments = pArguments
-        };
-        Expression result;
-        if (!createConstructionExpression(construction, &result))
-            throw(constructionExpressionCreateError);
-        
-        *pResult = result;
+bool matrix_findConstructor(Matrix matrix, Symbol name, size_t* pIndex) {
+    if (matrix.constructorCount == 0)
+        return false;
+    return nameIndex_find(matrix.constructorIndex, &matrix.pConstructors->name, sizeof(Constructor), name, pIndex);
+}
+bool matrix_findDestructor(Matrix matrix, Symbol name, size_t* pIndex) {
+    if (matrix.destructorCount == 0)
+        return false;
+    return nameIndex_find(matrix.destructorIndex, &matrix.pDestructors->name, sizeof(Destructor), name, pIndex);
+}
+bool matrix_reserveConstructor(Matrix* pMatrix) {
+    if (pMatrix->constructorCount < pMatrix->constructorCapacity)
         return true;
+    size_t constructorCapacity = pMatrix->constructorCapacity == 0 ? 8 : 2 * pMatrix->constructorCapacity;
+    Constructor* pNewConstructors = realloc(pMatrix->pConstructors, constructorCapacity * sizeof(Constructor));
+    if (pNewConstructors == NULL)
+        throw(constructorsReallocError);
+    pMatrix->pConstructors = pNewConstructors;
+    pMatrix->constructorCapacity = constructorCapacity;
+    return true;
     
-        destroyExpression(result);
-    constructionExpressionCreateError:
-    constructionArgumentSubstituteError:
-        for (size_t i = 0; i < argumentCount; i++)
-            destroyExpression(pArguments[i]);
-        free(pArguments);
-    constructionArgumentsMallocError:
-        return false;
-    }
-    if (expression.kind == EVALUATION_EXPRESSION) {
-        Evaluation* pData = expression.pData;
-        
-        Substitution substitution;
-        if (!evaluation_substitute(*pData, module, pSubstitutions, &substitution))
-            throw(evaluationSubstituteError);
-        
-        *pResult = substitution.value;
-        destroyExpression(substitution.type);
+constructorsReallocError:
+    return false;
+}
+bool matrix_reserveDestructor(Matrix* pMatrix) {
+    if (pMatrix->destructorCount < pMatrix->destructorCapacity)
         return true;
+    size_t destructorCapacity = pMatrix->destructorCapacity == 0 ? 8 : 2 * pMatrix->destructorCapacity;
+    Destructor* pNewDestructors = realloc(pMatrix->pDestructors, destructorCapacity * sizeof(Destructor));
+    if (pNewDestructors == NULL)
+        throw(destructorsReallocError);
+    pMatrix->pDestructors = pNewDestructors;
+    pMatrix->destructorCapacity = destructorCapacity;
+    return true;
     
-        destroyExpression(substitution.value);
-        destroyExpression(substitution.type);
-    evaluationSubstituteError:
-        return false;
+destructorsReallocError:
+    return false;
+}
+bool matrix_reserveRules(Matrix* pMatrix, size_t rowCount, size_t columnCount) {
+    if (rowCount <= pMatrix->ruleRowCapacity && columnCount <= pMatrix->ruleColumnCapacity)
+        return true;
+    size_t rowCapacity = pMatrix->ruleRowCapacity == 0 ? 8 : pMatrix->ruleRowCapacity;
+    while (rowCapacity < rowCount)
+        rowCapacity *= 2;
+    size_t columnCapacity = pMatrix->ruleColumnCapacity == 0 ? 8 : pMatrix->ruleColumnCapacity;
+    while (columnCapacity < columnCount)
+        columnCapacity *= 2;
+    Expression* pRules = malloc(rowCapacity * columnCapacity * sizeof(Expression));
+    if (pRules == NULL)
+        throw(rulesMallocError);
+    for (size_t i = 0; i < pMatrix->destructorCount; i++) {
+        Expression* pRow = matrix_getRules(*pMatrix, i);
+        for (size_t j = 0; j < pMatrix->constructorCount; j++)
+            pRules[i * columnCapacity + j] = pRow[j];
     }
+    free(pMatrix->pRules);
+    pMatrix->pRules = pRules;
+    pMatrix->ruleRowCapacity = rowCapacity;
+    pMatrix->ruleColumnCapacity = columnCapacity;
+    return true;
+    
+rulesMallocError:
     return false;
 }
-bool evaluation_substitute(
-    Evaluation evaluation, Module module, Substitution const* pSubstitutions,
-    Substitution* pResult
-) {
-    if (evaluation.kind == REFERENCE_EVALUATION) {
-        size_t* pData = evaluation.pData;
-        
-        Expression type;
-        if (!expression_duplicate(pSubstitutions[*pData].type, &type))
-            throw(referenceTypeDuplicateError);
-        Expression value;
-        if (!expression_duplicate(pSubstitutions[*pData].value, &value))
-            throw(referenceValueDuplicateError);
-        
-        *pResult = (Substitution) {
-            .type = type,
-            .value = value
-        };
+Expression* matrix_getRules(Matrix matrix, size_t destructorIndex) {
+    return &matrix.pRules[destructorIndex * matrix.ruleColumnCapacity];
+}
+bool module_reserveMatrix(Module* pModule) {
+    if (pModule->matrixCount < pModule->matrixCapacity)
         return true;
+    size_t matrixCapacity = pModule->matrixCapacity == 0 ? 8 : 2 * pModule->matrixCapacity;
+    Matrix* pNewMatrices = realloc(pModule->pMatrices, matrixCapacity * sizeof(Matrix));
+    if (pNewMatrices == NULL)
+        throw(matricesReallocError);
+    pModule->pMatrices = pNewMatrices;
+    pModule->matrixCapacity = matrixCapacity;
+    return true;
     
-        destroyExpression(value);
-    referenceValueDuplicateError:
-        destroyExpression(type);
-    referenceTypeDuplicateError:
+matricesReallocError:
+    return false;
+}
+bool module_reserveOperation(Module* pModule) {
+    if (pModule->operationCount < pModule->operationCapacity)
+        return true;
+    size_t operationCapacity = pModule->operationCapacity == 0 ? 64 : 2 * pModule->operationCapacity;
+    Operation* pNewOperations = realloc(pModule->pOperations, operationCapacity * sizeof(Operation));
+    if (pNewOperations == NULL)
+        throw(operationsReallocError);
+    pModule->pOperations = pNewOperations;
+    pModule->operationCapacity = operationCapacity;
+    return true;
+    
+operationsReallocError:
+    return false;
+}
+void module_appendOperation(Module* pModule, Operation operation, uint64_t hash) {
+    uint64_t fingerprint = hash_combine(pModule->fingerprint, operation.kind);
+    fingerprint = hash_combine(fingerprint, operation.typeIndex);
+    fingerprint = hash_combine(fingerprint, operation.destructorIndex);
+    fingerprint = hash_combine(fingerprint, operation.constructorIndex);
+    fingerprint = hash_combine(fingerprint, operation.depth);
+    fingerprint = hash_combine(fingerprint, symbols.pHashes[operation.name]);
+    pModule->fingerprint = hash_combine(fingerprint, hash);
+    pModule->pOperations[pModule->operationCount] = operation;
+    pModule->operationCount++;
+}
+bool module_adoptExpression(Module* pModule, Expression expression, Expression* pResult) {
+    if (evaluator.isLazy && !expression_normalize(expression, *pModule, &expression))
         return false;
+    Region* pPreviousRegion = pExpressionRegion;
+    pExpressionRegion = &pModule->region;
+    bool isDuplicated = expression_duplicate(expression, pResult);
+    pExpressionRegion = pPreviousRegion;
+    return isDuplicated;
+}
+bool module_adoptExpressions(Module* pModule, size_t count, Expression const* pExpressions, Expression** ppResults) {
+    Expression* pResults;
+    if (!arena_allocate(&pModule->region.arena, count * sizeof(Expression), (void**) &pResults))
+        throw(resultsAllocateError);
+    for (size_t i = 0; i < count; i++) {
+        if (!module_adoptExpression(pModule, pExpressions[i], &pResults[i]))
+            throw(expressionAdoptError);
     }
-    if (evaluation.kind == DESTRUCTION_EVALUATION) {
-        Destruction* pData = evaluation.pData;
-        
-        Substitution caller;
-        if (!evaluation_substitute(pData->caller, module, pSubstitutions, &caller))
-            throw(destructionCallerSubstituteError);
+    *ppResults = pResults;
+    return true;
     
-        Expression* pArguments = malloc(pData->argumentCount * sizeof(Expression));
-        if (pArguments == NULL)
-            throw(destructionArgumentsMallocError);
-        size_t argumentCount;
-        for (argumentCount = 0; argumentCount < pData->argumentCount; argumentCount++) {
-            if (!expression_substitute(
-                pData->pArguments[argumentCount], module, pSubstitutions,
-                &pArguments[argumentCount]
-            ))
-                throw(destructionArgumentSubstituteError);
-        }
-        
-        Substitution result;
-        if (!substitution_destruct(caller, module, pData->index, pArguments, &result))
-            throw(destructionDestructError);
+expressionAdoptError:
+resultsAllocateError:
+    return false;
+}
+bool module_addConstructor(Module* pModule, size_t typeIndex, Constructor constructor) {
+    ArenaMark arenaMark = arena_mark(pModule->region.arena);
+    if (!module_reserveOperation(pModule))
+        throw(operationReserveError);
+    Expression* pParameterTypes;
+    if (!module_adoptExpressions(pModule, constructor.parameterCount, constructor.pParameterTypes, &pParameterTypes))
+        throw(parameterTypesAdoptError);
+    if (typeIndex == 0 && !module_reserveMatrix(pModule))
+        throw(matrixReserveError);
+    Matrix* pMatrix = &pModule->pMatrices[typeIndex];
+    if (!matrix_reserveConstructor(pMatrix))
+        throw(constructorReserveError);
+    if (pMatrix->destructorCount > 0 && !matrix_reserveRules(pMatrix, pMatrix->destructorCount, pMatrix->constructorCount + 1))
+        throw(rulesReserveError);
+    for (size_t i = 0; i < pMatrix->destructorCount; i++) {
+        matrix_getRules(*pMatrix, i)[pMatrix->constructorCount] = (Expression) {
+            .kind = UNSPECIFIED_EXPRESSION,
+            .pData = NULL
+        };
+    }
+    size_t constructorIndex = pMatrix->constructorCount;
+    pMatrix->pConstructors[constructorIndex] = constructor;
+    pMatrix->pConstructors[constructorIndex].pParameterTypes = pParameterTypes;
+    if (!nameIndex_insert(&pMatrix->constructorIndex, &pMatrix->pConstructors->name, sizeof(Constructor), constructorIndex))
+        throw(constructorIndexInsertError);
+    pMatrix->constructorCount++;
+    if (typeIndex == 0) {
+        pModule->pMatrices[pModule->matrixCount] = (Matrix) {
+            .constructorCount = 0,
+            .constructorCapacity = 0,
+            .pConstructors = NULL,
+            .destructorCount = 0,
+            .destructorCapacity = 0,
+            .pDestructors = NULL,
+            .ruleRowCapacity = 0,
+            .ruleColumnCapacity = 0,
+            .pRules = NULL,
+            .constructorIndex = EMPTY_NAME_INDEX,
+            .destructorIndex = EMPTY_NAME_INDEX
+        };
+        pModule->matrixCount++;
+    }
     
-        *pResult = result;
-        for (size_t i = 0; i < argumentCount; i++)
-            destroyExpression(pArguments[i]);
-        free(pArguments);
-        destroyExpression(caller.value);
-        destroyExpression(caller.type);
-        return true;
+    uint64_t hash = hash_combine(0, constructor.parameterCount);
+    for (size_t i = 0; i < constructor.parameterCount; i++)
+        hash = hash_combine(hash, expression_hash(constructor.pParameterTypes[i]));
+    module_appendOperation(pModule, (Operation) {
+        .kind = CONSTRUCTOR_OPERATION,
+        .typeIndex = typeIndex,
+        .destructorIndex = 0,
+        .constructorIndex = constructorIndex,
+        .depth = constructor.depth,
+        .name = constructor.name,
+        .arenaMark = arenaMark
+    }, hash);
+    free(constructor.pParameterTypes);
+    return true;
     
-    destructionDestructError:
-    destructionArgumentSubstituteError:
-        for (size_t i = 0; i < argumentCount; i++)
-            destroyExpression(pArguments[i]);
-        free(pArguments);
-    destructionArgumentsMallocError:
-        destroyExpression(caller.value);
-        destroyExpression(caller.type);
-    destructionCallerSubstituteError:
-        return false;
-    }
+constructorIndexInsertError:
+rulesReserveError:
+constructorReserveError:
+matrixReserveError:
+parameterTypesAdoptError:
+    region_rewind(&pModule->region, arenaMark);
+operationReserveError:
     return false;
 }
-bool expression_print(
-    Expression expression, Module module, size_t parameterCount, Parameter const* pParameters, Expression type
+bool module_addDestructor(Module* pModule, size_t typeIndex, Destructor destructor) {
+    ArenaMark arenaMark = arena_mark(pModule->region.arena);
+    if (!module_reserveOperation(pModule))
+        throw(operationReserveError);
+    Expression* pParameterTypes;
+    if (!module_adoptExpressions(pModule, destructor.parameterCount, destructor.pParameterTypes, &pParameterTypes))
+        throw(parameterTypesAdoptError);
+    Expression returnType;
+    if (!module_adoptExpression(pModule, destructor.returnType, &returnType))
+        throw(returnTypeAdoptError);
+    Matrix* pMatrix = &pModule->pMatrices[typeIndex];
+    if (!matrix_reserveDestructor(pMatrix))
+        throw(destructorReserveError);
+    if (!matrix_reserveRules(pMatrix, pMatrix->destructorCount + 1, pMatrix->constructorCount))
+        throw(rulesReserveError);
+    size_t destructorIndex = pMatrix->destructorCount;
+    Expression* pRules = matrix_getRules(*pMatrix, destructorIndex);
+    for (size_t i = 0; i < pMatrix->constructorCount; i++)
+        pRules[i] = (Expression) {.kind = UNSPECIFIED_EXPRESSION, .pData = NULL};
+    
+    pMatrix->pDestructors[destructorIndex] = destructor;
+    pMatrix->pDestructors[destructorIndex].pParameterTypes = pParameterTypes;
+    pMatrix->pDestructors[destructorIndex].returnType = returnType;
+    if (!nameIndex_insert(&pMatrix->destructorIndex, &pMatrix->pDestructors->name, sizeof(Destructor), destructorIndex))
+        throw(destructorIndexInsertError);
+    pMatrix->destructorCount++;
+    
+    uint64_t hash = hash_combine(0, destructor.parameterCount);
+    for (size_t i = 0; i < destructor.parameterCount; i++)
+        hash = hash_combine(hash, expression_hash(destructor.pParameterTypes[i]));
+    hash = hash_combine(hash, expression_hash(destructor.returnType));
+    module_appendOperation(pModule, (Operation) {
+        .kind = DESTRUCTOR_OPERATION,
+        .typeIndex = typeIndex,
+        .destructorIndex = destructorIndex,
+        .constructorIndex = 0,
+        .depth = destructor.depth,
+        .name = destructor.name,
+        .arenaMark = arenaMark
+    }, hash);
+    free(destructor.pParameterTypes);
+    return true;
+    
+destructorIndexInsertError:
+rulesReserveError:
+destructorReserveError:
+returnTypeAdoptError:
+parameterTypesAdoptError:
+    region_rewind(&pModule->region, arenaMark);
+operationReserveError:
+    return false;
+}
+bool module_setRule(
+    Module* pModule, size_t typeIndex, size_t destructorIndex, size_t constructorIndex, Expression rule
 ) {
-    if (expression.kind == CONSTRUCTION_EXPRESSION) {
-        Construction* pData = expression.pData;
-        if (type.kind != CONSTRUCTION_EXPRESSION)
-            throw(constructionTypeError);
-        Construction* pTypeConstruction = type.pData;
-        Constructor typeConstructor = module.pMatrices[0].pConstructors[pTypeConstruction->index];
-        Matrix matrix = module.pMatrices[pTypeConstruction->index];
+    ArenaMark arenaMark = arena_mark(pModule->region.arena);
+    if (!module_reserveOperation(pModule))
+        throw(operationReserveError);
+    Expression adoptedRule;
+    if (!module_adoptExpression(pModule, rule, &adoptedRule))
+        throw(ruleAdoptError);
+    matrix_getRules(pModule->pMatrices[typeIndex], destructorIndex)[constructorIndex] = adoptedRule;
+    module_appendOperation(pModule, (Operation) {
+        .kind = RULE_OPERATION,
+        .typeIndex = typeIndex,
+        .destructorIndex = destructorIndex,
+        .constructorIndex = constructorIndex,
+        .depth = 0,
+        .name = EMPTY_SYMBOL,
+        .arenaMark = arenaMark
+    }, expression_hash(rule));
+    return true;
     
-        Constructor constructor = matrix.pConstructors[pData->index];
-        if (!string_print(constructor.name))
-            throw(constructionNamePrintError);
+ruleAdoptError:
+    region_rewind(&pModule->region, arenaMark);
+operationReserveError:
+    return false;
+}
+bool module_recordRename(Module* pModule, OperationKind kind, size_t typeIndex, size_t index) {
+    if (pModule->renameCount == pModule->renameCapacity) {
+        size_t renameCapacity = pModule->renameCapacity == 0 ? 64 : 2 * pModule->renameCapacity;
+        Rename* pNewRenames = realloc(pModule->pRenames, renameCapacity * sizeof(Rename));
+        if (pNewRenames == NULL)
+            throw(renamesReallocError);
+        pModule->pRenames = pNewRenames;
+        pModule->renameCapacity = renameCapacity;
+    }
+    Matrix matrix = pModule->pMatrices[typeIndex];
+    Rename rename = {
+        .kind = kind,
+        .typeIndex = typeIndex,
+        .index = index
+    };
+    if (kind == CONSTRUCTOR_OPERATION) {
+        rename.depth = matrix.pConstructors[index].depth;
+        rename.name = matrix.pConstructors[index].name;
+    } else {
+        rename.depth = matrix.pDestructors[index].depth;
+        rename.name = matrix.pDestructors[index].name;
+    }
+    pModule->pRenames[pModule->renameCount] = rename;
+    pModule->renameCount++;
+    return true;
     
-        Substitution* pSubstitutions = malloc(
-            (typeConstructor.parameterCount + constructor.parameterCount) * sizeof(Substitution)
-        );
-        if (pSubstitutions == NULL)
-            throw(constructionSubstitutionsMallocError);
-        size_t typeSubstitutionCount;
-        for (
-            typeSubstitutionCount = 0;
-            typeSubstitutionCount < typeConstructor.parameterCount;
-            typeSubstitutionCount++
-        ) {
-            Expression parameterType;
-            if (!expression_substitute(
-                typeConstructor.pParameterTypes[typeSubstitutionCount], module, pSubstitutions, &parameterType
-            ))
-                throw(constructionParameterTypeSubstituteError);
-        
-            pSubstitutions[typeSubstitutionCount] = (Substitution) {
-                .type = parameterType,
-                .value = pTypeConstruction->pArguments[typeSubstitutionCount]
+renamesReallocError:
+    return false;
+}
+bool module_rollback(Module* pModule, size_t operationCount, uint64_t fingerprint) {
+    bool* pIsTouched = calloc(pModule->matrixCount, sizeof(bool));
+    if (pIsTouched == NULL)
+        throw(touchedMallocError);
+    while (pModule->operationCount > operationCount) {
+        pModule->operationCount--;
+        Operation operation = pModule->pOperations[pModule->operationCount];
+        Matrix* pMatrix = &pModule->pMatrices[operation.typeIndex];
+        pIsTouched[operation.typeIndex] = true;
+        arena_rewind(&pModule->region.arena, operation.arenaMark);
+        if (operation.kind == CONSTRUCTOR_OPERATION) {
+            pMatrix->constructorCount--;
+            if (operation.typeIndex == 0) {
+                pModule->matrixCount--;
+                Matrix matrix = pModule->pMatrices[pModule->matrixCount];
+                free(matrix.pConstructors);
+                free(matrix.pDestructors);
+                free(matrix.pRules);
+                destroyNameIndex(matrix.constructorIndex);
+                destroyNameIndex(matrix.destructorIndex);
+            }
+        } else if (operation.kind == DESTRUCTOR_OPERATION) {
+            pMatrix->destructorCount--;
+        } else if (operation.kind == RULE_OPERATION) {
+            Expression* pRule = &matrix_getRules(*pMatrix, operation.destructorIndex)[operation.constructorIndex];
+            *pRule = (Expression) {
+                .kind = UNSPECIFIED_EXPRESSION,
+                .pData = NULL
             };
-            continue;
-        
-            destroyExpression(parameterType);
-        constructionParameterTypeSubstituteError:
-            throw(constructionTypeSubstitutionsError);
+        } else {
+            while (pModule->renameCount > operation.renameStart) {
+                pModule->renameCount--;
+                Rename rename = pModule->pRenames[pModule->renameCount];
+                Matrix matrix = pModule->pMatrices[rename.typeIndex];
+                pIsTouched[rename.typeIndex] = true;
+                if (rename.kind == CONSTRUCTOR_OPERATION) {
+                    matrix.pConstructors[rename.index].depth = rename.depth;
+                    matrix.pConstructors[rename.index].name = rename.name;
+                } else {
+                    matrix.pDestructors[rename.index].depth = rename.depth;
+                    matrix.pDestructors[rename.index].name = rename.name;
+                }
+            }
         }
-        size_t constructorSubstitutionCount;
-        for (
-            constructorSubstitutionCount = 0;
-            constructorSubstitutionCount < constructor.parameterCount;
-            constructorSubstitutionCount++
-        ) {
-            Expression parameterType;
-            if (!expression_substitute(
-                constructor.pParameterTypes[constructorSubstitutionCount], module, pSubstitutions, &parameterType
-            ))
-                throw(constructionParameterConstructorSubstituteError);
-            
-            if (fputc(' ', stdout) == EOF)
-                throw(constructionParameterConstructorArgumentPrintError);
-            if (!expression_print(
-                pData->pArguments[constructorSubstitutionCount], module, parameterCount, pParameters, parameterType
-            ))
-                throw(constructionParameterConstructorArgumentPrintError);
-            pSubstitutions[typeSubstitutionCount + constructorSubstitutionCount] = (Substitution) {
-                .type = parameterType,
-                .value = pData->pArguments[constructorSubstitutionCount]
-            };
+    }
+    pModule->fingerprint = fingerprint;
+    region_prune(&pModule->region);
+    codeTable_clear(&codeTable);
+    
+    for (size_t i = 0; i < pModule->matrixCount; i++) {
+        if (!pIsTouched[i])
             continue;
-
-        constructionParameterConstructorArgumentPrintError:
-            destroyExpression(parameterType);
-        constructionParameterConstructorSubstituteError:
-            throw(constructionConstructorSubstitutionsError);
-        }
+        Matrix* pMatrix = &pModule->pMatrices[i];
+        if (!nameIndex_rebuild(&pMatrix->constructorIndex, &pMatrix->pConstructors->name, sizeof(Constructor), pMatrix->constructorCount))
+            throw(nameIndexRebuildError);
+        if (!nameIndex_rebuild(&pMatrix->destructorIndex, &pMatrix->pDestructors->name, sizeof(Destructor), pMatrix->destructorCount))
+            throw(nameIndexRebuildError);
+    }
+    free(pIsTouched);
+    return true;
     
-        for (size_t i = 0; i < constructorSubstitutionCount; i++)
-            destroyExpression(pSubstitutions[typeSubstitutionCount + i].type);
-        for (size_t i = 0; i < typeSubstitutionCount; i++)
-            destroyExpression(pSubstitutions[i].type);
-        free(pSubstitutions);
-        return true;
-
-    constructionConstructorSubstitutionsError:
-        for (size_t i = 0; i < constructorSubstitutionCount; i++)
-            destroyExpression(pSubstitutions[typeSubstitutionCount + i].type);
-    constructionTypeSubstitutionsError:
-        for (size_t i = 0; i < typeSubstitutionCount; i++)
-            destroyExpression(pSubstitutions[i].type);
-        free(pSubstitutions);
-    constructionSubstitutionsMallocError:
-    constructionNamePrintError:
-    constructionTypeError:
-        return false;
+nameIndexRebuildError:
+    free(pIsTouched);
+touchedMallocError:
+    return false;
+}
+bool expression_substitute(
+    Expression expression, Module module, Substitution const* pSubstitutions,
+    Expression* pResult
+) {
+    if (expression.kind == CONSTRUCTION_EXPRESSION && ((Construction*) expression.pData)->isClosed)
+        return expression_duplicate(expression, pResult);
+    size_t frameCount = evaluator.frameCount;
+    ArenaMark environmentMark = arena_mark(evaluator.environmentArena);
+    collector_enter();
+    Substitution result;
+    bool isReturning;
+    if (!evaluator_beginExpression(expression, module, pSubstitutions, &isReturning, &result))
+        throw(beginError);
+    if (!evaluator_run(module, frameCount, isReturning, &result))
+        throw(runError);
+    
+    *pResult = result.value;
+    arena_rewind(&evaluator.environmentArena, environmentMark);
+    collector_leave();
+    return true;
+    
+runError:
+beginError:
+    evaluator_unwind(frameCount);
+    arena_rewind(&evaluator.environmentArena, environmentMark);
+    collector_leave();
+    return false;
+}
+bool evaluation_substitute(
+    Evaluation evaluation, Module module, Substitution const* pSubstitutions, bool isTypeNeeded,
+    Substitution* pResult
+) {
+    size_t frameCount = evaluator.frameCount;
+    ArenaMark environmentMark = arena_mark(evaluator.environmentArena);
+    collector_enter();
+    Substitution result;
+    bool isReturning;
+    if (!evaluator_beginEvaluation(evaluation, module, pSubstitutions, isTypeNeeded, &isReturning, &result))
+        throw(beginError);
+    if (!evaluator_run(module, frameCount, isReturning, &result))
+        throw(runError);
+    
+    *pResult = result;
+    arena_rewind(&evaluator.environmentArena, environmentMark);
+    collector_leave();
+    return true;
+    
+runError:
+beginError:
+    evaluator_unwind(frameCount);
+    arena_rewind(&evaluator.environmentArena, environmentMark);
+    collector_leave();
+    return false;
+}
+void destroyConstructionStack(ConstructionStack stack) {
+    while (stack.frameCount > 0)
+        constructionStack_pop(&stack);
+    free(stack.pFrames);
+}
+bool constructionStack_push(
+    ConstructionStack* pStack, Module module, Construction* pTypeConstruction, size_t index,
+    Expression const* pArguments
+) {
+    if (pStack->frameCount == pStack->frameCapacity) {
+        size_t frameCapacity = pStack->frameCapacity == 0 ? 16 : pStack->frameCapacity * 2;
+        ConstructionFrame* pFrames = realloc(pStack->pFrames, frameCapacity * sizeof(ConstructionFrame));
+        if (pFrames == NULL)
+            throw(framesReallocError);
+        pStack->pFrames = pFrames;
+        pStack->frameCapacity = frameCapacity;
     }
-    if (expression.kind == EVALUATION_EXPRESSION) {
-        Evaluation* pData = expression.pData;
-        if (fputc('(', stdout) == EOF)
-            throw(evaluationDollarSignPrintError);
-        Expression evaluationType;
-        if (!evaluation_print(*pData, module, parameterCount, pParameters, &evaluationType))
-            throw(evaluationPrintError);
-        if (fputc(')', stdout) == EOF)
-            throw(evaluationEndError);
-        destroyExpression(evaluationType);
-        return true;
+    Constructor typeConstructor = module.pMatrices[0].pConstructors[pTypeConstruction->index];
+    Constructor constructor = module.pMatrices[pTypeConstruction->index].pConstructors[index];
     
-    evaluationEndError:
-        destroyExpression(evaluationType);
-    evaluationDollarSignPrintError:
-    evaluationPrintError:
-        return false;
+    Substitution* pSubstitutions = malloc(
+        (typeConstructor.parameterCount + constructor.parameterCount) * sizeof(Substitution)
+    );
+    if (pSubstitutions == NULL)
+        throw(substitutionsMallocError);
+    size_t typeSubstitutionCount;
+    for (
+        typeSubstitutionCount = 0;
+        typeSubstitutionCount < typeConstructor.parameterCount;
+        typeSubstitutionCount++
+    ) {
+        Expression parameterType;
+        if (!expression_instantiate(
+            typeConstructor.pParameterTypes[typeSubstitutionCount], module, pTypeConstruction, pSubstitutions, &parameterType
+        ))
+            throw(parameterTypeSubstituteError);
+        
+        pSubstitutions[typeSubstitutionCount] = (Substitution) {
+            .type = parameterType,
+            .value = construction_getArguments(pTypeConstruction)[typeSubstitutionCount]
+        };
+    }
+    
+    pStack->pFrames[pStack->frameCount] = (ConstructionFrame) {
+        .pTypeConstruction = pTypeConstruction,
+        .index = index,
+        .constructor = constructor,
+        .pArguments = pArguments,
+        .pSubstitutions = pSubstitutions,
+        .typeSubstitutionCount = typeSubstitutionCount,
+        .constructorSubstitutionCount = 0
+    };
+    pStack->frameCount++;
+    return true;
+    
+parameterTypeSubstituteError:
+    free(pSubstitutions);
+substitutionsMallocError:
+framesReallocError:
+    return false;
+}
+void constructionStack_pop(ConstructionStack* pStack) {
+    ConstructionFrame frame = pStack->pFrames[pStack->frameCount - 1];
+    free(frame.pSubstitutions);
+    pStack->frameCount--;
+}
+bool constructionStack_substitute(ConstructionStack* pStack, Module module, Expression* pType) {
+    ConstructionFrame* pFrame = &pStack->pFrames[pStack->frameCount - 1];
+    size_t argumentIndex = pFrame->constructorSubstitutionCount;
+    Expression parameterType;
+    if (!expression_instantiate(
+        pFrame->constructor.pParameterTypes[argumentIndex], module, pFrame->pTypeConstruction, pFrame->pSubstitutions, &parameterType
+    ))
+        throw(parameterTypeSubstituteError);
+    
+    Expression value = {
+        .kind = UNSPECIFIED_EXPRESSION,
+        .pData = NULL
+    };
+    if (pFrame->pArguments != NULL)
+        value = pFrame->pArguments[argumentIndex];
+    pFrame->pSubstitutions[pFrame->typeSubstitutionCount + argumentIndex] = (Substitution) {
+        .type = parameterType,
+        .value = value
+    };
+    pFrame->constructorSubstitutionCount++;
+    *pType = parameterType;
+    return true;
+    
+parameterTypeSubstituteError:
+    return false;
+}
+bool expression_print(
+    Expression expression, Module module, size_t parameterCount, Parameter const* pParameters, Expression type,
+    Output* pOutput
+) {
+    ConstructionStack stack = {
+        .frameCount = 0,
+        .frameCapacity = 0,
+        .pFrames = NULL
+    };
+    while (true) {
+        if (expression.kind == CONSTRUCTION_EXPRESSION) {
+            Construction* pData = expression.pData;
+            if (type.kind != CONSTRUCTION_EXPRESSION)
+                throw(constructionTypeError);
+            Construction* pTypeConstruction = type.pData;
+            Matrix matrix = module.pMatrices[pTypeConstruction->index];
+            
+            Constructor constructor = matrix.pConstructors[pData->index];
+            if (!symbol_print(constructor.name, pOutput))
+                throw(constructionNamePrintError);
+            if (constructor.parameterCount > 0) {
+                if (!constructionStack_push(
+                    &stack, module, pTypeConstruction, pData->index, construction_getArguments(pData)
+                ))
+                    throw(constructionPushError);
+            }
+        } else if (expression.kind == EVALUATION_EXPRESSION) {
+            Evaluation* pData = expression.pData;
+            if (!output_writeCharacter(pOutput, '('))
+                throw(evaluationDollarSignPrintError);
+            Expression evaluationType;
+            if (!evaluation_print(*pData, module, parameterCount, pParameters, pOutput, &evaluationType))
+                throw(evaluationPrintError);
+            if (!output_writeCharacter(pOutput, ')'))
+                throw(evaluationEndError);
+        } else
+            throw(expressionKindError);
+        
+        while (
+            stack.frameCount > 0
+            && stack.pFrames[stack.frameCount - 1].constructorSubstitutionCount
+                == stack.pFrames[stack.frameCount - 1].constructor.parameterCount
+        )
+            constructionStack_pop(&stack);
+        if (stack.frameCount == 0)
+            break;
+        
+        if (!constructionStack_substitute(&stack, module, &type))
+            throw(argumentTypeSubstituteError);
+        ConstructionFrame frame = stack.pFrames[stack.frameCount - 1];
+        expression = frame.pArguments[frame.constructorSubstitutionCount - 1];
+        if (!output_writeCharacter(pOutput, ' '))
+            throw(argumentSeparatorPrintError);
     }
+    destroyConstructionStack(stack);
+    return true;
+    
+argumentSeparatorPrintError:
+argumentTypeSubstituteError:
+expressionKindError:
+evaluationEndError:
+evaluationPrintError:
+evaluationDollarSignPrintError:
+constructionPushError:
+constructionNamePrintError:
+constructionTypeError:
+    destroyConstructionStack(stack);
     return false;
 }
 bool type_print(
-    Expression expression, Module module, size_t parameterCount, Parameter const* pParameters
+    Expression expression, Module module, size_t parameterCount, Parameter const* pParameters, Output* pOutput
 ) {
     Construction universeTypeConstruction = {
         .index = 0,
-        .argumentCount = 0,
-        .pArguments = NULL
+        .argumentCount = 0
     };
+    universeTypeConstruction.hash = construction_hash(universeTypeConstruction, NULL);
     Expression universeType = {
         .kind = CONSTRUCTION_EXPRESSION,
         .pData = &universeTypeConstruction
     };
-    return expression_print(expression, module, parameterCount, pParameters, universeType);
+    return expression_print(expression, module, parameterCount, pParameters, universeType, pOutput);
 }
 bool evaluation_print(
-    Evaluation evaluation, Module module, size_t parameterCount, Parameter const* pParameters, Expression* pType
+    Evaluation evaluation, Module module, size_t parameterCount, Parameter const* pParameters, Output* pOutput,
+    Expression* pType
 ) {
     if (evaluation.kind == REFERENCE_EVALUATION) {
         size_t* pData = evaluation.pData;
-        String name = pParameters[*pData].name;
-        if (!string_print(name))
+        if (!symbol_print(pParameters[*pData].name, pOutput))
             throw(referenceNamePrintError);
         
         Expression type;
@@ -938,7 +3978,6 @@ bool evaluation_print(
         *pType = type;
         return true;
     
-        destroyExpression(type);
     referenceTypeDuplicateError:
     referenceNamePrintError:
         return false;
@@ -948,9 +3987,9 @@ bool evaluation_print(
         
         Expression type;
         
-        if (!evaluation_print(pData->caller, module, parameterCount, pParameters, &type))
+        if (!evaluation_print(pData->caller, module, parameterCount, pParameters, pOutput, &type))
             throw(destructionEvaluationPrintError);
-        if (fputc('.', stdout) == EOF)
+        if (!output_writeCharacter(pOutput, '.'))
             throw(destructionPeriodPrintError);
         if (type.kind != CONSTRUCTION_EXPRESSION)
             throw(destructionCallerTypeError);
@@ -959,7 +3998,7 @@ bool evaluation_print(
         Matrix matrix = module.pMatrices[pTypeConstruction->index];
         
         Destructor destructor = matrix.pDestructors[pData->index];
-        if (!string_print(destructor.name))
+        if (!symbol_print(destructor.name, pOutput))
             throw(destructionDestructorNamePrintError);
     
         Substitution* pSubstitutions = malloc(
@@ -974,18 +4013,17 @@ bool evaluation_print(
             typeSubstitutionCount++
         ) {
             Expression parameterType;
-            if (!expression_substitute(
-                typeConstructor.pParameterTypes[typeSubstitutionCount], module, pSubstitutions, &parameterType
+            if (!expression_instantiate(
+                typeConstructor.pParameterTypes[typeSubstitutionCount], module, pTypeConstruction, pSubstitutions, &parameterType
             ))
                 throw(destructionParameterTypeSubstituteError);
         
             pSubstitutions[typeSubstitutionCount] = (Substitution) {
                 .type = parameterType,
-                .value = pTypeConstruction->pArguments[typeSubstitutionCount]
+                .value = construction_getArguments(pTypeConstruction)[typeSubstitutionCount]
             };
             continue;
         
-            destroyExpression(parameterType);
         destructionParameterTypeSubstituteError:
             throw(destructionTypeSubstitutionsError);
         }
@@ -1003,8 +4041,8 @@ bool evaluation_print(
             destructorSubstitutionCount++
         ) {
             Expression parameterType;
-            if (!expression_substitute(
-                destructor.pParameterTypes[destructorSubstitutionCount], module, pSubstitutions, &parameterType
+            if (!expression_instantiate(
+                destructor.pParameterTypes[destructorSubstitutionCount], module, pTypeConstruction, pSubstitutions, &parameterType
             ))
                 throw(destructionParameterDestructorSubstituteError);
         
@@ -1012,10 +4050,11 @@ bool evaluation_print(
                 .type = parameterType,
                 .value = pData->pArguments[destructorSubstitutionCount]
             };
-            if (fputc(' ', stdout) == EOF)
+            if (!output_writeCharacter(pOutput, ' '))
                 throw(destructionParameterConstructorArgumentPrintError);
             if (!expression_print(
-                pData->pArguments[destructorSubstitutionCount], module, parameterCount, pParameters, parameterType
+                pData->pArguments[destructorSubstitutionCount], module, parameterCount, pParameters, parameterType,
+                pOutput
             ))
                 throw(destructionParameterConstructorArgumentPrintError);
             pSubstitutions[typeSubstitutionCount + 1 + destructorSubstitutionCount] = (Substitution) {
@@ -1025,402 +4064,1424 @@ bool evaluation_print(
             continue;
     
         destructionParameterConstructorArgumentPrintError:
-            destroyExpression(parameterType);
         destructionParameterDestructorSubstituteError:
             throw(destructionDestructorSubstitutionsError);
         }
         
         Expression resultType;
-        if (!expression_substitute(destructor.returnType, module, pSubstitutions, &resultType))
+        if (!expression_instantiate(destructor.returnType, module, pTypeConstruction, pSubstitutions, &resultType))
             throw(destructionResultTypeComputeError);
     
         *pType = resultType;
-        destroyExpression(type);
         return true;
     
-        destroyExpression(resultType);
     destructionResultTypeComputeError:
     destructionDestructorSubstitutionsError:
-        for (size_t i = 0; i < destructorSubstitutionCount; i++)
-            destroyExpression(pSubstitutions[typeSubstitutionCount + 1 + i].type);
     destructionTypeSubstitutionsError:
-        for (size_t i = 0; i < typeSubstitutionCount; i++)
-            destroyExpression(pSubstitutions[i].type);
         free(pSubstitutions);
     destructionSubstitutionsMallocError:
     destructionDestructorNamePrintError:
     destructionCallerTypeError:
     destructionPeriodPrintError:
-        destroyExpression(type);
     destructionEvaluationPrintError:
         return false;
     }
     return false;
 }
-bool substitution_destruct(
-    Substitution substitution, Module module, size_t index, Expression const* pArguments,
-    Substitution* pResult
+bool expression_instantiate(
+    Expression type, Module module, Construction* pTypeConstruction, Substitution const* pSubstitutions,
+    Expression* pResult
 ) {
-    if (substitution.type.kind != CONSTRUCTION_EXPRESSION)
-        throw(typeKindError);
-    Construction* pTypeConstruction = substitution.type.pData;
-    Constructor typeConstructor = module.pMatrices[0].pConstructors[pTypeConstruction->index];
+    if (type.kind == CONSTRUCTION_EXPRESSION && ((Construction*) type.pData)->isClosed)
+        return expression_duplicate(type, pResult);
+    size_t typeParameterCount = module.pMatrices[0].pConstructors[pTypeConstruction->index].parameterCount;
+    bool isCached = pExpressionRegion == &scratchRegion && typeParameterCount > 0;
     
-    Substitution* pTypeSubstitutions = malloc(typeConstructor.parameterCount * sizeof(Substitution));
-    if (pTypeSubstitutions == NULL)
-        throw(typeSubstitutionsMallocError);
-    size_t typeSubstitutionCount;
-    for (
-        typeSubstitutionCount = 0;
-        typeSubstitutionCount < typeConstructor.parameterCount;
-        typeSubstitutionCount++
-    ) {
-        Expression type;
-        if (!expression_substitute(
-            typeConstructor.pParameterTypes[typeSubstitutionCount], module, pTypeSubstitutions,
-            &type
-        ))
-            throw(typeSubstitutionTypeComputeError);
-        pTypeSubstitutions[typeSubstitutionCount] = (Substitution) {
-            .type = type,
-            .value = pTypeConstruction->pArguments[typeSubstitutionCount]
+    InstantiationTable* pTable = &scratchRegion.instantiationTable;
+    size_t index;
+    if (isCached && instantiationTable_find(*pTable, pTypeConstruction, type.pData, &index)) {
+        Expression result = pTable->pInstantiations[index].result;
+        if (result.kind != UNSPECIFIED_EXPRESSION)
+            return expression_duplicate(result, pResult);
+        isCached = false;
+    }
+    Expression result;
+    if (!expression_substitute(type, module, pSubstitutions, &result))
+        throw(resultSubstituteError);
+    if (evaluator.isLazy && !expression_normalize(result, module, &result))
+        throw(resultNormalizeError);
+    if (isCached) {
+        Instantiation instantiation = {
+            .pTypeConstruction = pTypeConstruction,
+            .pType = type.pData,
+            .result = result
         };
-        continue;
-    
-        destroyExpression(type);
-    typeSubstitutionTypeComputeError:
-        throw(typeSubstitutionCreateError);
+        if (!expression_isBounded(type, typeParameterCount))
+            instantiation.result = (Expression) {.kind = UNSPECIFIED_EXPRESSION, .pData = NULL};
+        if (!instantiationTable_insert(pTable, instantiation))
+            throw(instantiationInsertError);
     }
+    *pResult = result;
+    return true;
     
-    Destructor destructor = module.pMatrices[pTypeConstruction->index].pDestructors[index];
-    Substitution* pDestructorSubstitutions = malloc(
-        (typeSubstitutionCount + 1 + destructor.parameterCount) * sizeof(Substitution)
-    );
-    if (pDestructorSubstitutions == NULL)
-        throw(destructorSubstitutionsMallocError);
-    memcpy(pDestructorSubstitutions, pTypeSubstitutions, typeSubstitutionCount * sizeof(Substitution));
-    pDestructorSubstitutions[typeSubstitutionCount] = substitution;
-    size_t destructorSubstitutionCount;
-    for (
-        destructorSubstitutionCount = typeSubstitutionCount + 1;
-        destructorSubstitutionCount < typeSubstitutionCount + 1 + destructor.parameterCount;
-        destructorSubstitutionCount++
-    ) {
-        Expression type;
-        if (!expression_substitute(
-            destructor.pParameterTypes[
-                destructorSubstitutionCount - typeSubstitutionCount - 1
-            ], module, pDestructorSubstitutions,
-            &type
-        ))
-            throw(destructorSubstitutionTypeComputeError);
-        pDestructorSubstitutions[destructorSubstitutionCount] = (Substitution) {
-            .type = type,
-            .value = pArguments[destructorSubstitutionCount - typeSubstitutionCount - 1]
+instantiationInsertError:
+resultNormalizeError:
+resultSubstituteError:
+    return false;
+}
+bool substitution_computeType(Substitution substitution, Module module, Expression* pType) {
+    if (substitution.type.kind != DEFERRED_EXPRESSION)
+        return expression_duplicate(substitution.type, pType);
+    DeferredType* pData = substitution.type.pData;
+    return expression_instantiate(pData->type, module, pData->pTypeConstruction, pData->pSubstitutions, pType);
+}
+bool createThunkExpression(
+    Expression expression, Module module, Substitution const* pSubstitutions, Expression* pExpression
+) {
+    size_t substitutionCount = expression_getBound(expression);
+    Thunk* pData;
+    if (!expression_allocate(sizeof(Thunk) + substitutionCount * sizeof(Substitution), (void**) &pData))
+        throw(dataAllocateError);
+    *pData = (Thunk) {
+        .expression = expression,
+        .substitutionCount = substitutionCount,
+        .pSubstitutions = (Substitution*) (pData + 1),
+        .value = {.kind = UNSPECIFIED_EXPRESSION, .pData = NULL},
+        .epoch = collector.epoch,
+        .offset = SIZE_MAX
+    };
+    for (size_t i = 0; i < substitutionCount; i++) {
+        pData->pSubstitutions[i] = (Substitution) {
+            .type = {.kind = UNSPECIFIED_EXPRESSION, .pData = NULL},
+            .value = {.kind = UNSPECIFIED_EXPRESSION, .pData = NULL}
         };
-        continue;
-    
-        destroyExpression(type);
-    destructorSubstitutionTypeComputeError:
-        throw(destructorSubstitutionCreateError);
     }
     
-    Expression type;
-    if (!expression_substitute(destructor.returnType, module, pDestructorSubstitutions, &type))
-        throw(returnTypeSubstituteError);
+    Expression thunk = {
+        .kind = THUNK_EXPRESSION,
+        .pData = pData
+    };
+    if (!evaluator_pushValue((Expression) {.kind = UNSPECIFIED_EXPRESSION, .pData = NULL}, thunk))
+        throw(thunkPushError);
+    if (!expression_capture(expression, module, pSubstitutions, pData->pSubstitutions))
+        throw(captureError);
+    evaluator.valueCount--;
     
-    Expression value;
-    if (substitution.value.kind == CONSTRUCTION_EXPRESSION) {
-        Construction* pData = substitution.value.pData;
-        Constructor constructor = module.pMatrices[pTypeConstruction->index].pConstructors[pData->index];
-        
-        Substitution* pRuleSubstitutions = malloc((
-            typeSubstitutionCount + constructor.parameterCount + destructorSubstitutionCount
-        ) * sizeof(Substitution));
-        if (pRuleSubstitutions == NULL)
-            throw(constructionRuleSubstitutionsMallocError);
-        memcpy(pRuleSubstitutions, pTypeSubstitutions, typeSubstitutionCount * sizeof(Substitution));
-        memcpy(
-            &pRuleSubstitutions[typeSubstitutionCount + constructor.parameterCount],
-            &pDestructorSubstitutions[typeSubstitutionCount + 1], destructorSubstitutionCount * sizeof(Substitution)
-        );
-        size_t ruleSubstitutionCount;
-        for (
-            ruleSubstitutionCount = typeSubstitutionCount + destructorSubstitutionCount;
-            ruleSubstitutionCount < typeSubstitutionCount + destructorSubstitutionCount + constructor.parameterCount;
-            ruleSubstitutionCount++
-        ) {
-            Expression argumentType;
-            if (!expression_substitute(
-                constructor.pParameterTypes[
-                    ruleSubstitutionCount - typeSubstitutionCount - destructorSubstitutionCount
-                ], module, pRuleSubstitutions,
-                &argumentType
-            ))
-                throw(ruleSubstitutionTypeComputeError);
-            pRuleSubstitutions[ruleSubstitutionCount - destructorSubstitutionCount] = (Substitution) {
-                .type = argumentType,
-                .value = pData->pArguments[ruleSubstitutionCount - typeSubstitutionCount - destructorSubstitutionCount]
-            };
-            continue;
+    *pExpression = thunk;
+    return true;
     
-            destroyExpression(type);
-        ruleSubstitutionTypeComputeError:
-            throw(ruleSubstitutionCreateError);
-        }
-        
-        if (destructor.pRules[pData->index].kind == UNSPECIFIED_EXPRESSION)
-            throw(constructionRuleUnspecifiedError);
-        if (!expression_substitute(destructor.pRules[pData->index], module, pRuleSubstitutions, &value))
-            throw(constructionValueCreateError);
-        for (size_t i = typeSubstitutionCount + destructorSubstitutionCount; i < ruleSubstitutionCount; i++)
-            destroyExpression(pRuleSubstitutions[i - destructorSubstitutionCount].type);
-        free(pRuleSubstitutions);
-        goto valueCreateSuccess;
-    
-        destroyExpression(value);
-    constructionValueCreateError:
-    constructionRuleUnspecifiedError:
-    ruleSubstitutionCreateError:
-        for (size_t i = typeSubstitutionCount + destructorSubstitutionCount; i < ruleSubstitutionCount; i++)
-            destroyExpression(pRuleSubstitutions[i - destructorSubstitutionCount].type);
-        free(pRuleSubstitutions);
-    constructionRuleSubstitutionsMallocError:
-        throw(valueCreateError);
+captureError:
+    evaluator.valueCount--;
+thunkPushError:
+dataAllocateError:
+    return false;
+}
+bool expression_capture(
+    Expression expression, Module module, Substitution const* pSubstitutions, Substitution* pCaptured
+) {
+    if (expression.kind == CONSTRUCTION_EXPRESSION) {
+        Construction* pData = expression.pData;
+        if (pData->isClosed)
+            return true;
+        for (size_t i = 0; i < pData->argumentCount; i++) {
+            if (!expression_capture(construction_getArguments(pData)[i], module, pSubstitutions, pCaptured))
+                return false;
+        }
+        return true;
     }
-    if (substitution.value.kind == EVALUATION_EXPRESSION) {
-        Evaluation* pData = substitution.value.pData;
-        
-        Evaluation caller;
-        if (!evaluation_duplicate(*pData, &caller))
-            throw(evaluationDuplicateError);
+    if (expression.kind == EVALUATION_EXPRESSION)
+        return evaluation_capture(*(Evaluation*) expression.pData, module, pSubstitutions, pCaptured);
+    return true;
+}
+bool evaluation_capture(
+    Evaluation evaluation, Module module, Substitution const* pSubstitutions, Substitution* pCaptured
+) {
+    if (evaluation.kind == REFERENCE_EVALUATION) {
+        size_t index = *(size_t*) evaluation.pData;
+        if (pCaptured[index].value.kind != UNSPECIFIED_EXPRESSION)
+            return true;
+        pCaptured[index].value = pSubstitutions[index].value;
+        return substitution_computeType(pSubstitutions[index], module, &pCaptured[index].type);
+    }
+    if (evaluation.kind == DESTRUCTION_EVALUATION) {
+        Destruction* pData = evaluation.pData;
+        if (!evaluation_capture(pData->caller, module, pSubstitutions, pCaptured))
+            return false;
+        for (size_t i = 0; i < pData->argumentCount; i++) {
+            if (!expression_capture(pData->pArguments[i], module, pSubstitutions, pCaptured))
+                return false;
+        }
+        return true;
+    }
+    return true;
+}
+bool thunk_force(Thunk* pThunk, Module module, Expression* pValue) {
+    if (pThunk->value.kind == UNSPECIFIED_EXPRESSION) {
+        Expression value;
+        if (!expression_substitute(pThunk->expression, module, pThunk->pSubstitutions, &value))
+            return false;
+        if (!thunk_setValue(pThunk, value))
+            return false;
+    }
+    *pValue = pThunk->value;
+    return true;
+}
+bool thunk_setValue(Thunk* pThunk, Expression value) {
+    pThunk->value = value;
+    if (pThunk->epoch == collector.epoch)
+        return true;
+    return collector_remember(pThunk);
+}
+bool expression_normalize(Expression expression, Module module, Expression* pResult) {
+    if (expression.kind == CONSTRUCTION_EXPRESSION && ((Construction*) expression.pData)->isClosed) {
+        *pResult = expression;
+        return true;
+    }
+    size_t frameCount = evaluator.frameCount;
+    ArenaMark environmentMark = arena_mark(evaluator.environmentArena);
+    collector_enter();
+    Substitution result;
+    bool isReturning;
+    if (!evaluator_beginNormalization(expression, &isReturning, &result))
+        throw(beginError);
+    if (!evaluator_run(module, frameCount, isReturning, &result))
+        throw(runError);
+    
+    *pResult = result.value;
+    arena_rewind(&evaluator.environmentArena, environmentMark);
+    collector_leave();
+    return true;
+    
+runError:
+beginError:
+    evaluator_unwind(frameCount);
+    arena_rewind(&evaluator.environmentArena, environmentMark);
+    collector_leave();
+    return false;
+}
+bool substitution_destruct(
+    Substitution substitution, Module module, size_t index, Expression const* pArguments, bool isTypeNeeded,
+    Substitution* pResult
+) {
+    if (substitution.type.kind != CONSTRUCTION_EXPRESSION)
+        throw(typeKindError);
+    Construction* pTypeConstruction = substitution.type.pData;
+    Destructor destructor = module.pMatrices[pTypeConstruction->index].pDestructors[index];
     
-        Expression* pArgumentCopies = malloc(destructor.parameterCount * sizeof(Expression));
+    Expression* pArgumentCopies = NULL;
+    if (destructor.parameterCount > 0) {
+        pArgumentCopies = malloc(destructor.parameterCount * sizeof(Expression));
         if (pArgumentCopies == NULL)
-            throw(evaluationArgumentCopiesMallocError);
+            throw(argumentCopiesMallocError);
+        memcpy(pArgumentCopies, pArguments, destructor.parameterCount * sizeof(Expression));
+    }
+    
+    size_t frameCount = evaluator.frameCount;
+    collector_enter();
+    Substitution result;
+    bool isReturning;
+    Expression type = {.kind = UNSPECIFIED_EXPRESSION, .pData = NULL};
+    if (!evaluator_apply(substitution, module, index, pArgumentCopies, isTypeNeeded, type, &isReturning, &result))
+        throw(applyError);
+    if (!evaluator_run(module, frameCount, isReturning, &result))
+        throw(runError);
+    
+    *pResult = result;
+    collector_leave();
+    return true;
+    
+runError:
+applyError:
+    evaluator_unwind(frameCount);
+    collector_leave();
+argumentCopiesMallocError:
+typeKindError:
+    return false;
+}
+bool substitution_delay(
+    Module module, Construction* pTypeConstruction, size_t index, Substitution const* pSubstitutions, size_t offset,
+    Substitution* pResult
+) {
+    size_t typeSubstitutionCount = module.pMatrices[0].pConstructors[pTypeConstruction->index].parameterCount;
+    Destructor destructor = module.pMatrices[pTypeConstruction->index].pDestructors[index];
+    
+    Expression type;
+    if (!expression_instantiate(destructor.returnType, module, pTypeConstruction, pSubstitutions, &type))
+        throw(returnTypeInstantiateError);
+    Expression* pArguments = NULL;
+    if (destructor.parameterCount > 0) {
+        pArguments = malloc(destructor.parameterCount * sizeof(Expression));
+        if (pArguments == NULL)
+            throw(argumentsMallocError);
+    }
+    for (size_t i = 0; i < destructor.parameterCount; i++) {
+        Evaluation argument;
+        if (!createReferenceEvaluation(typeSubstitutionCount + 1 + i, &argument))
+            throw(argumentCreateError);
+        if (!createEvaluationExpression(argument, &pArguments[i]))
+            throw(argumentCreateError);
+    }
+    Evaluation caller;
+    if (!createReferenceEvaluation(typeSubstitutionCount, &caller))
+        throw(callerCreateError);
+    Destruction destruction = {
+        .caller = caller,
+        .index = index,
+        .argumentCount = destructor.parameterCount,
+        .pArguments = pArguments
+    };
+    Evaluation evaluation;
+    if (!createDestructionEvaluation(destruction, &evaluation))
+        throw(destructionCreateError);
+    Expression expression;
+    if (!createEvaluationExpression(evaluation, &expression))
+        throw(destructionCreateError);
+    Expression value;
+    if (!createThunkExpression(expression, module, pSubstitutions, &value))
+        throw(thunkCreateError);
+    ((Thunk*) value.pData)->offset = offset;
+    
+    free(pArguments);
+    *pResult = (Substitution) {
+        .type = type,
+        .value = value
+    };
+    return true;
+    
+thunkCreateError:
+destructionCreateError:
+callerCreateError:
+argumentCreateError:
+    free(pArguments);
+argumentsMallocError:
+returnTypeInstantiateError:
+    return false;
+}
+void destroyEvaluator(Evaluator* pEvaluator) {
+    free(pEvaluator->pFrames);
+    free(pEvaluator->pValues);
+    free(pEvaluator->pValueTypes);
+    destroyArena(pEvaluator->environmentArena);
+}
+bool evaluator_push(EvaluationFrame frame) {
+    if (evaluator.frameCount == evaluator.frameLimit) {
+        fprintf(stderr, "Evaluation exceeded the maximum depth of %lu\n", evaluator.frameLimit);
+        throw(frameLimitError);
+    }
+    if (evaluator.frameCount == evaluator.frameCapacity) {
+        size_t frameCapacity = evaluator.frameCapacity == 0 ? 64 : 2 * evaluator.frameCapacity;
+        EvaluationFrame* pFrames = realloc(evaluator.pFrames, frameCapacity * sizeof(EvaluationFrame));
+        if (pFrames == NULL)
+            throw(framesReallocError);
+        evaluator.pFrames = pFrames;
+        evaluator.frameCapacity = frameCapacity;
+    }
+    frame.environmentMark = arena_mark(evaluator.environmentArena);
+    evaluator.pFrames[evaluator.frameCount++] = frame;
+    return true;
+    
+framesReallocError:
+frameLimitError:
+    return false;
+}
+void evaluator_pop(void) {
+    EvaluationFrame frame = evaluator.pFrames[--evaluator.frameCount];
+    free(frame.pArguments);
+    arena_rewind(&evaluator.environmentArena, frame.environmentMark);
+}
+void evaluator_unwind(size_t frameCount) {
+    for (size_t i = evaluator.frameCount; i > frameCount && evaluator.failedOffset == SIZE_MAX; i--) {
+        EvaluationFrame frame = evaluator.pFrames[i - 1];
+        if (frame.kind == FORCE_FRAME)
+            evaluator.failedOffset = frame.pThunk->offset;
+    }
+    while (evaluator.frameCount > frameCount)
+        evaluator_pop();
+}
+bool evaluator_pushRoots(void) {
+    for (size_t i = 0; i < evaluator.frameCount; i++) {
+        EvaluationFrame frame = evaluator.pFrames[i];
+        if (frame.pArguments != NULL) {
+            for (size_t j = 0; j < frame.argumentCount; j++) {
+                if (!collector_pushExpression(frame.pArguments[j]))
+                    throw(rootPushError);
+            }
+        }
+        if (!collector_pushSubstitutions(&frame.caller, 1) || !collector_pushExpression(frame.type))
+            throw(rootPushError);
+        if ((frame.kind == FORCE_FRAME || frame.kind == NORMALIZE_FRAME) && !collector_pushExpression(frame.expression))
+            throw(rootPushError);
+        if (!collector_pushSubstitutions(frame.pDestructorSubstitutions, frame.destructorSubstitutionCount))
+            throw(rootPushError);
+        if (!collector_pushSubstitutions(frame.pRuleSubstitutions, frame.ruleSubstitutionCount))
+            throw(rootPushError);
+    }
+    for (size_t i = 0; i < evaluator.valueCount; i++) {
+        if (!collector_pushExpression(evaluator.pValueTypes[i]) || !collector_pushExpression(evaluator.pValues[i]))
+            throw(rootPushError);
+    }
+    return true;
+    
+rootPushError:
+    return false;
+}
+bool evaluator_beginExpression(
+    Expression expression, Module module, Substitution const* pSubstitutions, bool* pIsReturning,
+    Substitution* pResult
+) {
+    if (expression.kind == CONSTRUCTION_EXPRESSION) {
+        Construction* pData = expression.pData;
+        if (pData->isClosed) {
+            Expression value;
+            if (!expression_duplicate(expression, &value))
+                throw(constructionDuplicateError);
+            *pResult = (Substitution) {
+                .type = {.kind = UNSPECIFIED_EXPRESSION, .pData = NULL},
+                .value = value
+            };
+            *pIsReturning = true;
+            return true;
+        }
+        if (!evaluator_push((EvaluationFrame) {
+            .kind = CONSTRUCTION_FRAME,
+            .expression = expression,
+            .pSubstitutions = pSubstitutions,
+            .argumentCount = 0,
+            .pArguments = NULL
+        }))
+            throw(constructionPushError);
+        *pIsReturning = false;
+        return true;
+    
+    constructionPushError:
+    constructionDuplicateError:
+        return false;
+    }
+    if (expression.kind == EVALUATION_EXPRESSION) {
+        Evaluation* pData = expression.pData;
+        return evaluator_beginEvaluation(*pData, module, pSubstitutions, false, pIsReturning, pResult);
+    }
+    return false;
+}
+bool evaluator_beginEvaluation(
+    Evaluation evaluation, Module module, Substitution const* pSubstitutions, bool isTypeNeeded,
+    bool* pIsReturning, Substitution* pResult
+) {
+    if (evaluation.kind == REFERENCE_EVALUATION) {
+        size_t* pData = evaluation.pData;
+        
+        Expression type = {.kind = UNSPECIFIED_EXPRESSION, .pData = NULL};
+        if (isTypeNeeded && !substitution_computeType(pSubstitutions[*pData], module, &type))
+            throw(referenceTypeComputeError);
+        Expression value = pSubstitutions[*pData].value;
+        if (value.kind == THUNK_EXPRESSION && ((Thunk*) value.pData)->value.kind == UNSPECIFIED_EXPRESSION) {
+            if (!evaluator_push((EvaluationFrame) {
+                .kind = FORCE_FRAME,
+                .expression = value,
+                .pThunk = value.pData,
+                .type = type
+            }))
+                throw(referenceForcePushError);
+            *pIsReturning = false;
+            return true;
+        }
+        if (value.kind == THUNK_EXPRESSION)
+            value = ((Thunk*) value.pData)->value;
+        if (!expression_duplicate(value, &value))
+            throw(referenceValueDuplicateError);
+        
+        *pResult = (Substitution) {
+            .type = type,
+            .value = value
+        };
+        *pIsReturning = true;
+        return true;
+    
+    referenceValueDuplicateError:
+    referenceForcePushError:
+    referenceTypeComputeError:
+        return false;
+    }
+    if (evaluation.kind == DESTRUCTION_EVALUATION) {
+        Destruction* pData = evaluation.pData;
+        
+        Expression* pArguments = calloc(pData->argumentCount, sizeof(Expression));
+        if (pArguments == NULL)
+            throw(destructionArgumentsCallocError);
+        if (!evaluator_push((EvaluationFrame) {
+            .kind = DESTRUCTION_FRAME,
+            .pDestruction = pData,
+            .pSubstitutions = pSubstitutions,
+            .isTypeNeeded = isTypeNeeded,
+            .caller = {
+                .type = {.kind = UNSPECIFIED_EXPRESSION, .pData = NULL},
+                .value = {.kind = UNSPECIFIED_EXPRESSION, .pData = NULL}
+            },
+            .argumentCount = 0,
+            .pArguments = pArguments
+        }))
+            throw(destructionPushError);
+        *pIsReturning = false;
+        return true;
+    
+    destructionPushError:
+        free(pArguments);
+    destructionArgumentsCallocError:
+        return false;
+    }
+    return false;
+}
+bool evaluator_apply(
+    Substitution caller, Module module, size_t index, Expression* pArguments, bool isTypeNeeded, Expression type,
+    bool* pIsReturning, Substitution* pResult
+) {
+    if (caller.type.kind != CONSTRUCTION_EXPRESSION)
+        throw(typeKindError);
+    Construction* pTypeConstruction = caller.type.pData;
+    Constructor typeConstructor = module.pMatrices[0].pConstructors[pTypeConstruction->index];
+    Destructor destructor = module.pMatrices[pTypeConstruction->index].pDestructors[index];
+    if (!evaluator_push((EvaluationFrame) {
+        .kind = RULE_FRAME,
+        .caller = caller,
+        .index = index,
+        .argumentCount = destructor.parameterCount,
+        .pArguments = pArguments,
+        .type = type
+    }))
+        throw(framePushError);
+    if (!collector_poll())
+        throw(collectError);
+    
+    size_t typeSubstitutionCount = typeConstructor.parameterCount;
+    size_t destructorSubstitutionCount = typeSubstitutionCount + 1 + destructor.parameterCount;
+    size_t constructorParameterCount = 0;
+    if (caller.value.kind == CONSTRUCTION_EXPRESSION) {
+        Construction* pData = caller.value.pData;
+        constructorParameterCount = module.pMatrices[pTypeConstruction->index].pConstructors[pData->index].parameterCount;
+    }
+    
+    DeferredType* pDeferredTypes;
+    if (!arena_allocate(
+        &evaluator.environmentArena,
+        (typeSubstitutionCount + destructor.parameterCount + constructorParameterCount) * sizeof(DeferredType),
+        (void**) &pDeferredTypes
+    ))
+        throw(deferredTypesAllocateError);
+    Substitution* pDestructorSubstitutions;
+    if (!arena_allocate(
+        &evaluator.environmentArena, destructorSubstitutionCount * sizeof(Substitution),
+        (void**) &pDestructorSubstitutions
+    ))
+        throw(destructorSubstitutionsAllocateError);
+    for (size_t i = 0; i < typeSubstitutionCount; i++) {
+        pDeferredTypes[i] = (DeferredType) {
+            .type = typeConstructor.pParameterTypes[i],
+            .pTypeConstruction = pTypeConstruction,
+            .pSubstitutions = pDestructorSubstitutions
+        };
+        pDestructorSubstitutions[i] = (Substitution) {
+            .type = {.kind = DEFERRED_EXPRESSION, .pData = &pDeferredTypes[i]},
+            .value = construction_getArguments(pTypeConstruction)[i]
+        };
+    }
+    pDestructorSubstitutions[typeSubstitutionCount] = caller;
+    for (size_t i = 0; i < destructor.parameterCount; i++) {
+        pDeferredTypes[typeSubstitutionCount + i] = (DeferredType) {
+            .type = destructor.pParameterTypes[i],
+            .pTypeConstruction = pTypeConstruction,
+            .pSubstitutions = pDestructorSubstitutions
+        };
+        pDestructorSubstitutions[typeSubstitutionCount + 1 + i] = (Substitution) {
+            .type = {.kind = DEFERRED_EXPRESSION, .pData = &pDeferredTypes[typeSubstitutionCount + i]},
+            .value = pArguments[i]
+        };
+    }
+    evaluator.pFrames[evaluator.frameCount - 1].pDestructorSubstitutions = pDestructorSubstitutions;
+    evaluator.pFrames[evaluator.frameCount - 1].destructorSubstitutionCount = destructorSubstitutionCount;
+    
+    if (isTypeNeeded && !expression_instantiate(
+        destructor.returnType, module, pTypeConstruction, pDestructorSubstitutions, &type
+    ))
+        throw(returnTypeSubstituteError);
+    evaluator.pFrames[evaluator.frameCount - 1].type = type;
+    
+    if (caller.value.kind == CONSTRUCTION_EXPRESSION) {
+        Construction* pData = caller.value.pData;
+        Constructor constructor = module.pMatrices[pTypeConstruction->index].pConstructors[pData->index];
+        
+        bool isMemoized = memo.entryLimit > 0 && pExpressionRegion == &scratchRegion;
+        for (size_t i = 0; isMemoized && i < destructor.parameterCount; i++)
+            isMemoized = pArguments[i].kind != THUNK_EXPRESSION;
+        uint64_t memoHash = 0;
+        if (isMemoized) {
+            Expression value;
+            memoHash = memo_hash(pTypeConstruction, index, caller.value, destructor.parameterCount, pArguments);
+            if (memo_find(pTypeConstruction, index, caller.value, destructor.parameterCount, pArguments, memoHash, &value)) {
+                evaluator_pop();
+                *pResult = (Substitution) {
+                    .type = type,
+                    .value = value
+                };
+                *pIsReturning = true;
+                return true;
+            }
+        }
+        bool isNative;
+        Expression value;
+        if (!native_apply(module, pTypeConstruction->index, index, caller.value, pArguments, &isNative, &value))
+            throw(constructionNativeApplyError);
+        if (!isNative && !jit_apply(module, pTypeConstruction->index, index, caller.value, pArguments, &isNative, &value))
+            throw(constructionJitApplyError);
+        if (isNative) {
+            if (isMemoized && !memo_insert(
+                pTypeConstruction, index, caller.value, destructor.parameterCount, pArguments, memoHash, value
+            ))
+                throw(constructionMemoInsertError);
+            evaluator_pop();
+            *pResult = (Substitution) {
+                .type = type,
+                .value = value
+            };
+            *pIsReturning = true;
+            return true;
+        }
+        
+        Expression rule = matrix_getRules(module.pMatrices[pTypeConstruction->index], index)[pData->index];
+        if (rule.kind == UNSPECIFIED_EXPRESSION)
+            throw(constructionRuleUnspecifiedError);
+        size_t ruleSubstitutionCount = typeSubstitutionCount + constructor.parameterCount + destructor.parameterCount;
+        Substitution* pRuleSubstitutions;
+        if (!arena_allocate(
+            &evaluator.environmentArena, ruleSubstitutionCount * sizeof(Substitution), (void**) &pRuleSubstitutions
+        ))
+            throw(constructionRuleSubstitutionsAllocateError);
+        memcpy(pRuleSubstitutions, pDestructorSubstitutions, typeSubstitutionCount * sizeof(Substitution));
+        DeferredType* pConstructorDeferredTypes = &pDeferredTypes[typeSubstitutionCount + destructor.parameterCount];
+        for (size_t i = 0; i < constructor.parameterCount; i++) {
+            pConstructorDeferredTypes[i] = (DeferredType) {
+                .type = constructor.pParameterTypes[i],
+                .pTypeConstruction = pTypeConstruction,
+                .pSubstitutions = pRuleSubstitutions
+            };
+            pRuleSubstitutions[typeSubstitutionCount + i] = (Substitution) {
+                .type = {.kind = DEFERRED_EXPRESSION, .pData = &pConstructorDeferredTypes[i]},
+                .value = construction_getArguments(pData)[i]
+            };
+        }
+        memcpy(
+            &pRuleSubstitutions[typeSubstitutionCount + constructor.parameterCount],
+            &pDestructorSubstitutions[typeSubstitutionCount + 1], destructor.parameterCount * sizeof(Substitution)
+        );
+        
+        EvaluationFrame* pFrame = &evaluator.pFrames[evaluator.frameCount - 1];
+        pFrame->expression = rule;
+        bool isCompiled = evaluator.engine == BYTECODE_ENGINE && !evaluator.isLazy;
+        if (isCompiled && !codeTable_get(&codeTable, rule, &pFrame->pWords))
+            throw(constructionRuleCompileError);
+        pFrame->ruleSubstitutionCount = ruleSubstitutionCount;
+        pFrame->pRuleSubstitutions = pRuleSubstitutions;
+        pFrame->isMemoized = isMemoized;
+        pFrame->memoHash = memoHash;
+        *pIsReturning = false;
+        return true;
+    
+    constructionRuleCompileError:
+    constructionRuleSubstitutionsAllocateError:
+    constructionRuleUnspecifiedError:
+    constructionMemoInsertError:
+    constructionNativeApplyError:
+    constructionJitApplyError:
+        throw(valueCreateError);
+    }
+    if (caller.value.kind == EVALUATION_EXPRESSION) {
+        Evaluation* pData = caller.value.pData;
+        
+        for (size_t i = 0; i < destructor.parameterCount; i++) {
+            if (pArguments[i].kind == THUNK_EXPRESSION && !thunk_force(pArguments[i].pData, module, &pArguments[i]))
+                throw(evaluationArgumentForceError);
+        }
+        Evaluation callerCopy;
+        if (!evaluation_duplicate(*pData, &callerCopy))
+            throw(evaluationDuplicateError);
         size_t argumentCopyCount;
         for (argumentCopyCount = 0; argumentCopyCount < destructor.parameterCount; argumentCopyCount++) {
-            if (!expression_duplicate(pArguments[argumentCopyCount], &pArgumentCopies[argumentCopyCount]))
+            if (!expression_duplicate(pArguments[argumentCopyCount], &pArguments[argumentCopyCount]))
                 throw(evaluationArgumentDuplicateError);
         }
         
         Destruction destruction = {
-            .caller = caller,
+            .caller = callerCopy,
             .index = index,
             .argumentCount = argumentCopyCount,
-            .pArguments = pArgumentCopies
+            .pArguments = pArguments
         };
         Evaluation evaluation;
         if (!createDestructionEvaluation(destruction, &evaluation))
             throw(evaluationCreateError);
+        Expression value;
         if (!createEvaluationExpression(evaluation, &value))
             throw(evaluationValueCreateError);
-        goto valueCreateSuccess;
+        
+        evaluator_pop();
+        *pResult = (Substitution) {
+            .type = type,
+            .value = value
+        };
+        *pIsReturning = true;
+        return true;
     
-        destroyExpression(value);
     evaluationValueCreateError:
-        destroyEvaluation(evaluation);
     evaluationCreateError:
     evaluationArgumentDuplicateError:
-        for (size_t i = 0; i < argumentCopyCount; i++)
-            destroyExpression(pArgumentCopies[i]);
-        free(pArgumentCopies);
-    evaluationArgumentCopiesMallocError:
-        destroyEvaluation(caller);
     evaluationDuplicateError:
+    evaluationArgumentForceError:
         throw(valueCreateError);
     }
     throw(valueKindError);
     
-valueCreateSuccess:
-    *pResult = (Substitution) {
-        .type = type,
-        .value = value
-    };
-    for (size_t i = typeSubstitutionCount + 1; i < destructorSubstitutionCount; i++)
-        destroyExpression(pDestructorSubstitutions[i].type);
-    free(pDestructorSubstitutions);
-    for (size_t i = 0; i < typeSubstitutionCount; i++)
-        destroyExpression(pTypeSubstitutions[i].type);
-    free(pTypeSubstitutions);
-    return true;
-    
-valueCreateError:
 valueKindError:
-    destroyExpression(type);
+valueCreateError:
 returnTypeSubstituteError:
-destructorSubstitutionCreateError:
-    for (size_t i = typeSubstitutionCount + 1; i < destructorSubstitutionCount; i++)
-        destroyExpression(pDestructorSubstitutions[i].type);
-    free(pDestructorSubstitutions);
-destructorSubstitutionsMallocError:
-typeSubstitutionCreateError:
-    for (size_t i = 0; i < typeSubstitutionCount; i++)
-        destroyExpression(pTypeSubstitutions[i].type);
-    free(pTypeSubstitutions);
-typeSubstitutionsMallocError:
+destructorSubstitutionsAllocateError:
+deferredTypesAllocateError:
+collectError:
+    return false;
+framePushError:
 typeKindError:
+    free(pArguments);
     return false;
 }
-bool parser_parseExpression(
-    Parser* pParser, Module module,
-    size_t parameterCount, Parameter const* pParameters, Expression type,
-    Expression* pExpression
-) {
-    if (
-        isalnum(pParser->next) ||
-        pParser->next == '_' ||
-        pParser->next == '+' ||
-        pParser->next == '-' ||
-        pParser->next == '*' ||
-        pParser->next == '/' ||
-        pParser->next == '%' ||
-        pParser->next == '^' ||
-        pParser->next == '&' ||
-        pParser->next == '=' ||
-        pParser->next == '\'' ||
-        pParser->next == '"' ||
-        pParser->next == '\\' ||
-        pParser->next == ',' ||
-        pParser->next == '`' ||
-        pParser->next == '?'
-    ) {
-        if (type.kind != CONSTRUCTION_EXPRESSION)
-            throw(constructionTypeError);
-        Construction* pTypeConstruction = type.pData;
-        Constructor typeConstructor = module.pMatrices[0].pConstructors[pTypeConstruction->index];
-        Matrix matrix = module.pMatrices[pTypeConstruction->index];
-    
-        if (pParser->next == '?') {
-            for (size_t i = 0; i < parameterCount; i++) {
-                if (!type_print(pParameters[i].type, module, parameterCount, pParameters))
-                    throw(constructionQuestionMarkError);
-                fprintf(stdout, " [%s]\n", pParameters[i].name.pData);
+bool evaluator_run(Module module, size_t frameCount, bool isReturning, Substitution* pResult) {
+    Substitution result = *pResult;
+    while (evaluator.frameCount > frameCount) {
+        EvaluationFrame* pFrame = &evaluator.pFrames[evaluator.frameCount - 1];
+        if (pFrame->kind == CONSTRUCTION_FRAME) {
+            Construction* pData = pFrame->expression.pData;
+            Expression const* pArguments = construction_getArguments(pData);
+            if (isReturning) {
+                size_t argumentIndex = pFrame->argumentCount++;
+                if (pFrame->pArguments == NULL && result.value.pData != pArguments[argumentIndex].pData) {
+                    pFrame->pArguments = calloc(pData->argumentCount, sizeof(Expression));
+                    if (pFrame->pArguments == NULL)
+                        throw(constructionArgumentsCallocError);
+                    memcpy(pFrame->pArguments, pArguments, argumentIndex * sizeof(Expression));
+                }
+                if (pFrame->pArguments != NULL)
+                    pFrame->pArguments[argumentIndex] = result.value;
+            }
+            if (pFrame->argumentCount < pData->argumentCount) {
+                bool isDelayed;
+                if (!evaluator_delay(
+                    pArguments[pFrame->argumentCount], module, pFrame->pSubstitutions, &isDelayed, &result.value
+                ))
+                    throw(constructionArgumentDelayError);
+                if (isDelayed) {
+                    isReturning = true;
+                    continue;
+                }
+                if (!evaluator_beginExpression(
+                    pArguments[pFrame->argumentCount], module, pFrame->pSubstitutions, &isReturning, &result
+                ))
+                    throw(constructionArgumentBeginError);
+                continue;
             }
-            fprintf(stdout, "~ ");
-            if (!type_print(type, module, parameterCount, pParameters))
-                throw(constructionQuestionMarkError);
-            fprintf(stdout, "\n");
-            for (size_t i = 0; i < matrix.constructorCount; i++)
-                fprintf(stdout, "|%s\n", matrix.pConstructors[i].name.pData);
-            fprintf(stdout, "\n");
-            throw(constructionQuestionMarkError);
-        }
-        
-        String name;
-        if (!parser_parseName(pParser, &name))
-            throw(constructionNameParseError);
-        
-        size_t index;
-        for (index = 0; index < matrix.constructorCount; index++) {
-            Constructor constructor = matrix.pConstructors[index];
-            if (string_equals(name, constructor.name))
-                break;
-        }
-        if (index == matrix.constructorCount)
-            throw(constructionNameError);
-        Constructor constructor = matrix.pConstructors[index];
-        
-        Substitution* pSubstitutions = malloc(
-            (typeConstructor.parameterCount + constructor.parameterCount) * sizeof(Substitution)
-        );
-        if (pSubstitutions == NULL)
-            throw(constructionSubstitutionsMallocError);
-        size_t typeSubstitutionCount;
-        for (
-            typeSubstitutionCount = 0;
-            typeSubstitutionCount < typeConstructor.parameterCount;
-            typeSubstitutionCount++
-        ) {
-            Expression parameterType;
-            if (!expression_substitute(
-                typeConstructor.pParameterTypes[typeSubstitutionCount], module, pSubstitutions, &parameterType
-            ))
-                throw(constructionParameterTypeSubstituteError);
             
-            pSubstitutions[typeSubstitutionCount] = (Substitution) {
-                .type = parameterType,
-                .value = pTypeConstruction->pArguments[typeSubstitutionCount]
+            Expression value;
+            if (pFrame->pArguments == NULL) {
+                if (!expression_duplicate(pFrame->expression, &value))
+                    throw(constructionDuplicateError);
+            } else {
+                Construction construction = {
+                    .index = pData->index,
+                    .argumentCount = pData->argumentCount
+                };
+                if (!createConstructionExpression(construction, pFrame->pArguments, &value))
+                    throw(constructionExpressionCreateError);
+            }
+            evaluator_pop();
+            result = (Substitution) {
+                .type = {.kind = UNSPECIFIED_EXPRESSION, .pData = NULL},
+                .value = value
             };
+            isReturning = true;
             continue;
-    
-            destroyExpression(parameterType);
-        constructionParameterTypeSubstituteError:
-            throw(constructionTypeSubstitutionsError);
         }
-        size_t constructorSubstitutionCount;
-        for (
-            constructorSubstitutionCount = 0;
-            constructorSubstitutionCount < constructor.parameterCount;
-            constructorSubstitutionCount++
-        ) {
-            Expression parameterType;
-            if (!expression_substitute(
-                constructor.pParameterTypes[constructorSubstitutionCount], module, pSubstitutions, &parameterType
+        if (pFrame->kind == DESTRUCTION_FRAME) {
+            Destruction* pData = pFrame->pDestruction;
+            if (isReturning && pFrame->caller.value.kind == UNSPECIFIED_EXPRESSION)
+                pFrame->caller = result;
+            else if (isReturning)
+                pFrame->pArguments[pFrame->argumentCount++] = result.value;
+            if (pFrame->caller.value.kind == UNSPECIFIED_EXPRESSION) {
+                if (!evaluator_beginEvaluation(
+                    pData->caller, module, pFrame->pSubstitutions, true, &isReturning, &result
+                ))
+                    throw(destructionCallerBeginError);
+                continue;
+            }
+            if (pFrame->argumentCount < pData->argumentCount) {
+                bool isDelayed;
+                if (!evaluator_delay(
+                    pData->pArguments[pFrame->argumentCount], module, pFrame->pSubstitutions, &isDelayed, &result.value
+                ))
+                    throw(destructionArgumentDelayError);
+                if (isDelayed) {
+                    isReturning = true;
+                    continue;
+                }
+                if (!evaluator_beginExpression(
+                    pData->pArguments[pFrame->argumentCount], module, pFrame->pSubstitutions, &isReturning, &result
+                ))
+                    throw(destructionArgumentBeginError);
+                continue;
+            }
+            
+            Substitution caller = pFrame->caller;
+            Expression* pArguments = pFrame->pArguments;
+            bool isTypeNeeded = pFrame->isTypeNeeded;
+            pFrame->pArguments = NULL;
+            evaluator_pop();
+            Expression type = {.kind = UNSPECIFIED_EXPRESSION, .pData = NULL};
+            if (evaluator.frameCount > frameCount) {
+                EvaluationFrame parent = evaluator.pFrames[evaluator.frameCount - 1];
+                if (parent.kind == RULE_FRAME && !parent.isMemoized) {
+                    type = parent.type;
+                    evaluator_pop();
+                }
+            }
+            if (!evaluator_apply(caller, module, pData->index, pArguments, isTypeNeeded, type, &isReturning, &result))
+                throw(destructionApplyError);
+            continue;
+        }
+        if (pFrame->kind == RULE_FRAME) {
+            if (!isReturning && pFrame->pWords != NULL) {
+                if (!machine_execute(module, &result))
+                    throw(ruleExecuteError);
+                isReturning = true;
+                continue;
+            }
+            if (!isReturning) {
+                if (!evaluator_beginExpression(
+                    pFrame->expression, module, pFrame->pRuleSubstitutions, &isReturning, &result
+                ))
+                    throw(ruleBeginError);
+                continue;
+            }
+            
+            Construction* pTypeConstruction = pFrame->caller.type.pData;
+            if (pFrame->isMemoized && !memo_insert(
+                pTypeConstruction, pFrame->index, pFrame->caller.value, pFrame->argumentCount, pFrame->pArguments,
+                pFrame->memoHash, result.value
             ))
-                throw(constructionParameterConstructorSubstituteError);
+                throw(ruleMemoInsertError);
+            result.type = pFrame->type;
+            evaluator_pop();
+            continue;
+        }
+        if (pFrame->kind == FORCE_FRAME) {
+            Thunk* pThunk = pFrame->pThunk;
+            if (!isReturning) {
+                if (!evaluator_beginExpression(
+                    pThunk->expression, module, pThunk->pSubstitutions, &isReturning, &result
+                ))
+                    throw(forceBeginError);
+                continue;
+            }
             
-            Expression parameterValue;
-            if (!parser_parseExpression(pParser, module, parameterCount, pParameters, parameterType, &parameterValue))
-                throw(constructionParameterValueParseError);
-        
-            pSubstitutions[typeSubstitutionCount + constructorSubstitutionCount] = (Substitution) {
-                .type = parameterType,
-                .value = parameterValue
+            if (!thunk_setValue(pThunk, result.value))
+                throw(forceSetError);
+            result.type = pFrame->type;
+            evaluator_pop();
+            continue;
+        }
+        if (pFrame->kind == NORMALIZE_FRAME) {
+            if (pFrame->expression.kind == THUNK_EXPRESSION) {
+                Expression value = result.value;
+                evaluator_pop();
+                if (!evaluator_beginNormalization(value, &isReturning, &result))
+                    throw(normalizeBeginError);
+                continue;
+            }
+            
+            size_t argumentCount;
+            Expression const* pArguments;
+            Expression caller = {.kind = UNSPECIFIED_EXPRESSION, .pData = NULL};
+            if (pFrame->expression.kind == CONSTRUCTION_EXPRESSION) {
+                Construction* pData = pFrame->expression.pData;
+                argumentCount = pData->argumentCount;
+                pArguments = construction_getArguments(pData);
+            } else {
+                Destruction* pData = ((Evaluation*) pFrame->expression.pData)->pData;
+                argumentCount = pData->argumentCount;
+                pArguments = pData->pArguments;
+                caller = (Expression) {.kind = EVALUATION_EXPRESSION, .pData = &pData->caller};
+            }
+            size_t childCount = caller.kind == UNSPECIFIED_EXPRESSION ? argumentCount : argumentCount + 1;
+            if (isReturning) {
+                size_t childIndex = pFrame->argumentCount++;
+                Expression child = childIndex < argumentCount ? pArguments[childIndex] : caller;
+                if (pFrame->pArguments == NULL && result.value.pData != child.pData) {
+                    pFrame->pArguments = calloc(childCount, sizeof(Expression));
+                    if (pFrame->pArguments == NULL)
+                        throw(normalizeArgumentsCallocError);
+                    memcpy(pFrame->pArguments, pArguments, childIndex * sizeof(Expression));
+                }
+                if (pFrame->pArguments != NULL)
+                    pFrame->pArguments[childIndex] = result.value;
+            }
+            if (pFrame->argumentCount < childCount) {
+                size_t childIndex = pFrame->argumentCount;
+                Expression child = childIndex < argumentCount ? pArguments[childIndex] : caller;
+                if (!evaluator_beginNormalization(child, &isReturning, &result))
+                    throw(normalizeBeginError);
+                continue;
+            }
+            
+            Expression value = pFrame->expression;
+            if (pFrame->pArguments != NULL && pFrame->expression.kind == CONSTRUCTION_EXPRESSION) {
+                Construction construction = {
+                    .index = ((Construction*) pFrame->expression.pData)->index,
+                    .argumentCount = argumentCount
+                };
+                if (!createConstructionExpression(construction, pFrame->pArguments, &value))
+                    throw(normalizeExpressionCreateError);
+            } else if (pFrame->pArguments != NULL) {
+                Destruction destruction = {
+                    .index = ((Destruction*) ((Evaluation*) pFrame->expression.pData)->pData)->index,
+                    .caller = *(Evaluation*) pFrame->pArguments[argumentCount].pData,
+                    .argumentCount = argumentCount,
+                    .pArguments = pFrame->pArguments
+                };
+                Evaluation evaluation;
+                if (!createDestructionEvaluation(destruction, &evaluation))
+                    throw(normalizeExpressionCreateError);
+                if (!createEvaluationExpression(evaluation, &value))
+                    throw(normalizeExpressionCreateError);
+            }
+            evaluator_pop();
+            result = (Substitution) {
+                .type = {.kind = UNSPECIFIED_EXPRESSION, .pData = NULL},
+                .value = value
             };
+            isReturning = true;
             continue;
+        }
+        throw(frameKindError);
+    }
+    *pResult = result;
+    return true;
     
-            destroyExpression(parameterValue);
-        constructionParameterValueParseError:
-            destroyExpression(parameterType);
-        constructionParameterConstructorSubstituteError:
-            throw(constructionConstructorSubstitutionsError);
+frameKindError:
+normalizeExpressionCreateError:
+normalizeArgumentsCallocError:
+normalizeBeginError:
+forceSetError:
+forceBeginError:
+ruleMemoInsertError:
+ruleBeginError:
+ruleExecuteError:
+destructionApplyError:
+destructionArgumentBeginError:
+destructionArgumentDelayError:
+destructionCallerBeginError:
+constructionExpressionCreateError:
+constructionDuplicateError:
+constructionArgumentBeginError:
+constructionArgumentDelayError:
+constructionArgumentsCallocError:
+    return false;
+}
+bool evaluator_delay(
+    Expression expression, Module module, Substitution const* pSubstitutions, bool* pIsDelayed, Expression* pValue
+) {
+    *pIsDelayed = false;
+    if (!evaluator.isLazy || !collector.isActive || expression.kind != EVALUATION_EXPRESSION)
+        return true;
+    Evaluation* pData = expression.pData;
+    if (pData->kind == REFERENCE_EVALUATION) {
+        Expression value = pSubstitutions[*(size_t*) pData->pData].value;
+        if (value.kind != THUNK_EXPRESSION)
+            return true;
+        Thunk* pThunk = value.pData;
+        if (pThunk->value.kind != UNSPECIFIED_EXPRESSION && !expression_duplicate(pThunk->value, &value))
+            return false;
+        *pValue = value;
+        *pIsDelayed = true;
+        return true;
+    }
+    if (!createThunkExpression(expression, module, pSubstitutions, pValue))
+        return false;
+    *pIsDelayed = true;
+    return true;
+}
+bool evaluator_beginNormalization(Expression expression, bool* pIsReturning, Substitution* pResult) {
+    if (expression.kind == THUNK_EXPRESSION && ((Thunk*) expression.pData)->value.kind != UNSPECIFIED_EXPRESSION)
+        expression = ((Thunk*) expression.pData)->value;
+    bool isNormal = expression.kind != THUNK_EXPRESSION;
+    if (expression.kind == CONSTRUCTION_EXPRESSION)
+        isNormal = ((Construction*) expression.pData)->isClosed;
+    if (expression.kind == EVALUATION_EXPRESSION)
+        isNormal = ((Evaluation*) expression.pData)->kind != DESTRUCTION_EVALUATION;
+    if (isNormal) {
+        *pResult = (Substitution) {
+            .type = {.kind = UNSPECIFIED_EXPRESSION, .pData = NULL},
+            .value = expression
+        };
+        *pIsReturning = true;
+        return true;
+    }
+    
+    if (!evaluator_push((EvaluationFrame) {
+        .kind = NORMALIZE_FRAME,
+        .expression = expression,
+        .argumentCount = 0,
+        .pArguments = NULL
+    }))
+        throw(normalizePushError);
+    if (expression.kind == THUNK_EXPRESSION && !evaluator_push((EvaluationFrame) {
+        .kind = FORCE_FRAME,
+        .expression = expression,
+        .pThunk = expression.pData,
+        .type = {.kind = UNSPECIFIED_EXPRESSION, .pData = NULL}
+    }))
+        throw(forcePushError);
+    *pIsReturning = false;
+    return true;
+    
+forcePushError:
+normalizePushError:
+    return false;
+}
+bool evaluator_pushValue(Expression type, Expression value) {
+    if (evaluator.valueCount == evaluator.valueCapacity) {
+        size_t valueCapacity = evaluator.valueCapacity == 0 ? 256 : 2 * evaluator.valueCapacity;
+        Expression* pValues = realloc(evaluator.pValues, valueCapacity * sizeof(Expression));
+        if (pValues == NULL)
+            throw(valuesReallocError);
+        evaluator.pValues = pValues;
+        Expression* pValueTypes = realloc(evaluator.pValueTypes, valueCapacity * sizeof(Expression));
+        if (pValueTypes == NULL)
+            throw(valueTypesReallocError);
+        evaluator.pValueTypes = pValueTypes;
+        evaluator.valueCapacity = valueCapacity;
+    }
+    evaluator.pValueTypes[evaluator.valueCount] = type;
+    evaluator.pValues[evaluator.valueCount] = value;
+    evaluator.valueCount++;
+    return true;
+    
+valueTypesReallocError:
+valuesReallocError:
+    return false;
+}
+bool code_append(Code* pCode, size_t word) {
+    if (pCode->wordCount == pCode->wordCapacity) {
+        size_t wordCapacity = pCode->wordCapacity == 0 ? 16 : 2 * pCode->wordCapacity;
+        size_t* pWords = realloc(pCode->pWords, wordCapacity * sizeof(size_t));
+        if (pWords == NULL)
+            throw(wordsReallocError);
+        pCode->pWords = pWords;
+        pCode->wordCapacity = wordCapacity;
+    }
+    pCode->pWords[pCode->wordCount++] = word;
+    return true;
+    
+wordsReallocError:
+    return false;
+}
+bool code_compileExpression(Code* pCode, Expression expression, bool isTail) {
+    if (expression.kind == CONSTRUCTION_EXPRESSION) {
+        Construction* pData = expression.pData;
+        if (pData->isClosed) {
+            if (!code_append(pCode, CONSTANT_OPCODE) || !code_append(pCode, (uintptr_t) pData))
+                throw(constructionAppendError);
+        } else {
+            for (size_t i = 0; i < pData->argumentCount; i++) {
+                if (!code_compileExpression(pCode, construction_getArguments(pData)[i], false))
+                    throw(constructionArgumentCompileError);
+            }
+            if (!code_append(pCode, CONSTRUCT_OPCODE) || !code_append(pCode, pData->index))
+                throw(constructionAppendError);
+            if (!code_append(pCode, pData->argumentCount))
+                throw(constructionAppendError);
         }
-        
-        Expression* pArguments = malloc(constructorSubstitutionCount * sizeof(Expression));
-        if (pArguments == NULL)
-            throw(constructionArgumentsMallocError);
-        for (size_t i = 0; i < constructorSubstitutionCount; i++)
-            pArguments[i] = pSubstitutions[typeSubstitutionCount + i].value;
+        if (isTail && !code_append(pCode, RETURN_OPCODE))
+            throw(constructionAppendError);
+        return true;
+    
+    constructionArgumentCompileError:
+    constructionAppendError:
+        return false;
+    }
+    if (expression.kind == EVALUATION_EXPRESSION)
+        return code_compileEvaluation(pCode, *(Evaluation*) expression.pData, false, isTail);
+    return false;
+}
+bool code_compileEvaluation(Code* pCode, Evaluation evaluation, bool isTypeNeeded, bool isTail) {
+    if (evaluation.kind == REFERENCE_EVALUATION) {
+        size_t* pData = evaluation.pData;
+        if (!code_append(pCode, isTypeNeeded ? LOAD_TYPED_OPCODE : LOAD_OPCODE) || !code_append(pCode, *pData))
+            throw(referenceAppendError);
+        if (isTail && !code_append(pCode, RETURN_OPCODE))
+            throw(referenceAppendError);
+        return true;
+    
+    referenceAppendError:
+        return false;
+    }
+    if (evaluation.kind == DESTRUCTION_EVALUATION) {
+        Destruction* pData = evaluation.pData;
+        if (!code_compileEvaluation(pCode, pData->caller, true, false))
+            throw(destructionCallerCompileError);
+        for (size_t i = 0; i < pData->argumentCount; i++) {
+            if (!code_compileExpression(pCode, pData->pArguments[i], false))
+                throw(destructionArgumentCompileError);
+        }
+        Opcode opcode = isTail ? TAIL_DISPATCH_OPCODE : isTypeNeeded ? DISPATCH_TYPED_OPCODE : DISPATCH_OPCODE;
+        if (!code_append(pCode, opcode) || !code_append(pCode, pData->index))
+            throw(destructionAppendError);
+        if (!code_append(pCode, pData->argumentCount))
+            throw(destructionAppendError);
+        if (isTail && !code_append(pCode, RETURN_OPCODE))
+            throw(destructionAppendError);
+        return true;
+    
+    destructionAppendError:
+    destructionArgumentCompileError:
+    destructionCallerCompileError:
+        return false;
+    }
+    return false;
+}
+void destroyCodeTable(CodeTable table) {
+    for (size_t i = 0; i < table.capacity; i++)
+        free(table.ppWords[i]);
+    free(table.ppRules);
+    free(table.ppWords);
+}
+void codeTable_clear(CodeTable* pTable) {
+    if (pTable->codeCount == 0)
+        return;
+    for (size_t i = 0; i < pTable->capacity; i++) {
+        free(pTable->ppWords[i]);
+        pTable->ppRules[i] = NULL;
+        pTable->ppWords[i] = NULL;
+    }
+    pTable->codeCount = 0;
+}
+bool codeTable_get(CodeTable* pTable, Expression rule, size_t const** ppWords) {
+    if (pTable->capacity > 0) {
+        for (
+            size_t i = hash_combine(0, (uintptr_t) rule.pData) & (pTable->capacity - 1);
+            pTable->ppRules[i] != NULL;
+            i = (i + 1) & (pTable->capacity - 1)
+        ) {
+            if (pTable->ppRules[i] == rule.pData) {
+                *ppWords = pTable->ppWords[i];
+                return true;
+            }
+        }
+    }
+    
+    Code code = {
+        .wordCount = 0,
+        .wordCapacity = 0,
+        .pWords = NULL
+    };
+    if (!code_compileExpression(&code, rule, true))
+        throw(ruleCompileError);
+    if (2 * (pTable->codeCount + 1) > pTable->capacity) {
+        size_t capacity = pTable->capacity == 0 ? 64 : 2 * pTable->capacity;
+        void const** ppRules = calloc(capacity, sizeof(void const*));
+        size_t** ppCodeWords = calloc(capacity, sizeof(size_t*));
+        if (ppRules == NULL || ppCodeWords == NULL) {
+            free(ppRules);
+            free(ppCodeWords);
+            throw(tableCallocError);
+        }
+        for (size_t i = 0; i < pTable->capacity; i++) {
+            if (pTable->ppRules[i] == NULL)
+                continue;
+            size_t j = hash_combine(0, (uintptr_t) pTable->ppRules[i]) & (capacity - 1);
+            while (ppRules[j] != NULL)
+                j = (j + 1) & (capacity - 1);
+            ppRules[j] = pTable->ppRules[i];
+            ppCodeWords[j] = pTable->ppWords[i];
+        }
+        free(pTable->ppRules);
+        free(pTable->ppWords);
+        pTable->ppRules = ppRules;
+        pTable->ppWords = ppCodeWords;
+        pTable->capacity = capacity;
+    }
+    size_t i = hash_combine(0, (uintptr_t) rule.pData) & (pTable->capacity - 1);
+    while (pTable->ppRules[i] != NULL)
+        i = (i + 1) & (pTable->capacity - 1);
+    pTable->ppRules[i] = rule.pData;
+    pTable->ppWords[i] = code.pWords;
+    pTable->codeCount++;
+    *ppWords = code.pWords;
+    return true;
+    
+tableCallocError:
+ruleCompileError:
+    free(code.pWords);
+    return false;
+}
+bool machine_execute(Module module, Substitution* pResult) {
+    static void* const ppOpcodeLabels[] = {
+        [CONSTANT_OPCODE] = &&constantOpcode,
+        [LOAD_OPCODE] = &&loadOpcode,
+        [LOAD_TYPED_OPCODE] = &&loadOpcode,
+        [CONSTRUCT_OPCODE] = &&constructOpcode,
+        [DISPATCH_OPCODE] = &&dispatchOpcode,
+        [DISPATCH_TYPED_OPCODE] = &&dispatchOpcode,
+        [TAIL_DISPATCH_OPCODE] = &&dispatchOpcode,
+        [RETURN_OPCODE] = &&returnOpcode
+    };
+    Expression const UNSPECIFIED_TYPE = {.kind = UNSPECIFIED_EXPRESSION, .pData = NULL};
+    size_t frameCount = evaluator.frameCount - 1;
+    size_t valueCount = evaluator.valueCount;
+    EvaluationFrame* pFrame = &evaluator.pFrames[frameCount];
+    size_t const* pWords = pFrame->pWords;
+    size_t programCounter = pFrame->programCounter;
+    Substitution const* pSubstitutions = pFrame->pRuleSubstitutions;
+    Substitution result;
+    goto *ppOpcodeLabels[pWords[programCounter]];
     
+constantOpcode: {
+        Expression value = {.kind = CONSTRUCTION_EXPRESSION, .pData = (void*) pWords[programCounter + 1]};
+        if (!evaluator_pushValue(UNSPECIFIED_TYPE, value))
+            throw(valuePushError);
+        programCounter += 2;
+        goto *ppOpcodeLabels[pWords[programCounter]];
+    }
+loadOpcode: {
+        Substitution substitution = pSubstitutions[pWords[programCounter + 1]];
+        Expression type = UNSPECIFIED_TYPE;
+        if (pWords[programCounter] == LOAD_TYPED_OPCODE && !substitution_computeType(substitution, module, &type))
+            throw(loadTypeComputeError);
+        Expression value;
+        if (!expression_duplicate(substitution.value, &value))
+            throw(loadValueDuplicateError);
+        if (!evaluator_pushValue(type, value))
+            throw(valuePushError);
+        programCounter += 2;
+        goto *ppOpcodeLabels[pWords[programCounter]];
+    }
+constructOpcode: {
+        size_t argumentCount = pWords[programCounter + 2];
         Construction construction = {
-            .index = index,
-            .argumentCount = constructorSubstitutionCount,
-            .pArguments = pArguments
+            .index = pWords[programCounter + 1],
+            .argumentCount = argumentCount
         };
-        Expression expression;
-        if (!createConstructionExpression(construction, &expression))
-            throw(constructionExpressionCreateError);
+        Expression const* pArguments = &evaluator.pValues[evaluator.valueCount - argumentCount];
+        Expression value;
+        if (!createConstructionExpression(construction, pArguments, &value))
+            throw(constructionCreateError);
+        evaluator.valueCount -= argumentCount;
+        if (!evaluator_pushValue(UNSPECIFIED_TYPE, value))
+            throw(valuePushError);
+        programCounter += 3;
+        goto *ppOpcodeLabels[pWords[programCounter]];
+    }
+dispatchOpcode: {
+        Opcode opcode = pWords[programCounter];
+        size_t index = pWords[programCounter + 1];
+        size_t argumentCount = pWords[programCounter + 2];
+        Expression* pArguments = malloc(argumentCount * sizeof(Expression));
+        if (pArguments == NULL)
+            throw(argumentsMallocError);
+        memcpy(pArguments, &evaluator.pValues[evaluator.valueCount - argumentCount], argumentCount * sizeof(Expression));
+        evaluator.valueCount -= argumentCount + 1;
+        Substitution caller = {
+            .type = evaluator.pValueTypes[evaluator.valueCount],
+            .value = evaluator.pValues[evaluator.valueCount]
+        };
+        programCounter += 3;
         
-        *pExpression = expression;
-        for (size_t i = 0; i < constructorSubstitutionCount; i++)
-            destroyExpression(pSubstitutions[typeSubstitutionCount + i].type);
-        for (size_t i = 0; i < typeSubstitutionCount; i++)
-            destroyExpression(pSubstitutions[i].type);
-        free(pSubstitutions);
+        Expression type = UNSPECIFIED_TYPE;
+        bool isTail = opcode == TAIL_DISPATCH_OPCODE && !evaluator.pFrames[evaluator.frameCount - 1].isMemoized;
+        if (isTail) {
+            type = evaluator.pFrames[evaluator.frameCount - 1].type;
+            evaluator_pop();
+        } else
+            evaluator.pFrames[evaluator.frameCount - 1].programCounter = programCounter;
+        bool isReturning;
+        if (!evaluator_apply(
+            caller, module, index, pArguments, opcode == DISPATCH_TYPED_OPCODE, type, &isReturning, &result
+        ))
+            throw(dispatchApplyError);
+        if (isReturning && isTail)
+            goto deliverResult;
+        if (isReturning) {
+            if (!evaluator_pushValue(result.type, result.value))
+                throw(valuePushError);
+            goto *ppOpcodeLabels[pWords[programCounter]];
+        }
+        pFrame = &evaluator.pFrames[evaluator.frameCount - 1];
+        pWords = pFrame->pWords;
+        programCounter = pFrame->programCounter;
+        pSubstitutions = pFrame->pRuleSubstitutions;
+        goto *ppOpcodeLabels[pWords[programCounter]];
+    }
+returnOpcode: {
+        evaluator.valueCount--;
+        pFrame = &evaluator.pFrames[evaluator.frameCount - 1];
+        Construction* pTypeConstruction = pFrame->caller.type.pData;
+        if (pFrame->isMemoized && !memo_insert(
+            pTypeConstruction, pFrame->index, pFrame->caller.value, pFrame->argumentCount, pFrame->pArguments,
+            pFrame->memoHash, evaluator.pValues[evaluator.valueCount]
+        ))
+            throw(memoInsertError);
+        result = (Substitution) {
+            .type = pFrame->type,
+            .value = evaluator.pValues[evaluator.valueCount]
+        };
+        evaluator_pop();
+    }
+deliverResult:
+    if (evaluator.frameCount == frameCount) {
+        *pResult = result;
         return true;
+    }
+    pFrame = &evaluator.pFrames[evaluator.frameCount - 1];
+    pWords = pFrame->pWords;
+    programCounter = pFrame->programCounter;
+    pSubstitutions = pFrame->pRuleSubstitutions;
+    if (!evaluator_pushValue(result.type, result.value))
+        throw(valuePushError);
+    goto *ppOpcodeLabels[pWords[programCounter]];
     
-        destroyExpression(expression);
-    constructionExpressionCreateError:
-        free(pArguments);
-    constructionArgumentsMallocError:
-    constructionConstructorSubstitutionsError:
-        for (size_t i = 0; i < constructorSubstitutionCount; i++) {
-            destroyExpression(pSubstitutions[typeSubstitutionCount + i].value);
-            destroyExpression(pSubstitutions[typeSubstitutionCount + i].type);
+memoInsertError:
+dispatchApplyError:
+argumentsMallocError:
+constructionCreateError:
+loadValueDuplicateError:
+loadTypeComputeError:
+valuePushError:
+    evaluator.valueCount = valueCount;
+    return false;
+}
+bool parser_parseExpression(
+    Parser* pParser, Module module,
+    size_t parameterCount, Parameter const* pParameters, Expression type,
+    Expression* pExpression
+) {
+    ConstructionStack stack = {
+        .frameCount = 0,
+        .frameCapacity = 0,
+        .pFrames = NULL
+    };
+    Expression expression;
+    while (true) {
+        if (isWordCharacter(pParser->next) || pParser->next == '?') {
+            if (type.kind != CONSTRUCTION_EXPRESSION)
+                throw(constructionTypeError);
+            Construction* pTypeConstruction = type.pData;
+            Matrix matrix = module.pMatrices[pTypeConstruction->index];
+            
+            if (pParser->next == '?') {
+                for (size_t i = 0; i < parameterCount; i++) {
+                    if (!type_print(pParameters[i].type, module, parameterCount, pParameters, &output))
+                        throw(constructionQuestionMarkError);
+                    if (!output_format(&output, " [%s]\n", symbol_getString(pParameters[i].name).pData))
+                        throw(constructionQuestionMarkError);
+                }
+                if (!output_format(&output, "~ "))
+                    throw(constructionQuestionMarkError);
+                if (!type_print(type, module, parameterCount, pParameters, &output))
+                    throw(constructionQuestionMarkError);
+                if (!output_format(&output, "\n"))
+                    throw(constructionQuestionMarkError);
+                for (size_t i = 0; i < matrix.constructorCount; i++) {
+                    if (!output_format(&output, "|%s\n", symbol_getString(matrix.pConstructors[i].name).pData))
+                        throw(constructionQuestionMarkError);
+                }
+                if (!output_format(&output, "\n"))
+                    throw(constructionQuestionMarkError);
+                if (!output_sync(&output))
+                    throw(constructionQuestionMarkError);
+                throw(constructionQuestionMarkError);
+            }
+            
+            Symbol name;
+            if (!parser_parseName(pParser, &name))
+                throw(constructionNameParseError);
+            
+            size_t index;
+            if (!matrix_findConstructor(matrix, name, &index))
+                throw(constructionNameError);
+            
+            if (matrix.pConstructors[index].parameterCount > 0) {
+                if (!constructionStack_push(&stack, module, pTypeConstruction, index, NULL))
+                    throw(constructionPushError);
+                if (!constructionStack_substitute(&stack, module, &type))
+                    throw(argumentTypeSubstituteError);
+                continue;
+            }
+            Construction construction = {
+                .index = index,
+                .argumentCount = 0
+            };
+            if (!createConstructionExpression(construction, NULL, &expression))
+                throw(constructionExpressionCreateError);
+        } else {
+            if (!parser_parseEvaluation(pParser, module, parameterCount, pParameters, type, &expression))
+                throw(evaluationParseError);
         }
-    constructionTypeSubstitutionsError:
-        for (size_t i = 0; i < typeSubstitutionCount; i++)
-            destroyExpression(pSubstitutions[i].type);
-        free(pSubstitutions);
-    constructionSubstitutionsMallocError:
-    constructionNameError:
-        destroyString(name);
-    constructionNameParseError:
-    constructionQuestionMarkError:
-    constructionTypeError:
-        return false;
+        
+        while (stack.frameCount > 0) {
+            ConstructionFrame* pFrame = &stack.pFrames[stack.frameCount - 1];
+            size_t argumentCount = pFrame->constructorSubstitutionCount;
+            pFrame->pSubstitutions[pFrame->typeSubstitutionCount + argumentCount - 1].value = expression;
+            if (argumentCount < pFrame->constructor.parameterCount)
+                break;
+            
+            Expression* pArguments = malloc(argumentCount * sizeof(Expression));
+            if (pArguments == NULL)
+                throw(argumentsMallocError);
+            for (size_t i = 0; i < argumentCount; i++)
+                pArguments[i] = pFrame->pSubstitutions[pFrame->typeSubstitutionCount + i].value;
+            
+            Construction construction = {
+                .index = pFrame->index,
+                .argumentCount = argumentCount
+            };
+            bool isCreated = createConstructionExpression(construction, pArguments, &expression);
+            free(pArguments);
+            if (!isCreated)
+                throw(argumentsConstructionCreateError);
+            constructionStack_pop(&stack);
+        }
+        if (stack.frameCount == 0)
+            break;
+        
+        if (!constructionStack_substitute(&stack, module, &type))
+            throw(argumentTypeSubstituteError);
     }
+    destroyConstructionStack(stack);
+    *pExpression = expression;
+    return true;
+    
+argumentTypeSubstituteError:
+argumentsConstructionCreateError:
+argumentsMallocError:
+evaluationParseError:
+constructionExpressionCreateError:
+constructionPushError:
+constructionNameError:
+constructionNameParseError:
+constructionQuestionMarkError:
+constructionTypeError:
+    destroyConstructionStack(stack);
+    return false;
+}
+bool parser_parseEvaluation(
+    Parser* pParser, Module module,
+    size_t parameterCount, Parameter const* pParameters, Expression type,
+    Expression* pExpression
+) {
     Substitution caller;
     bool isAnnotation = false;
     if (pParser->next == '$') {
@@ -1441,10 +5502,8 @@ bool parser_parseExpression(
         
         goto callerParseSuccess;
     
-        destroyExpression(caller.value);
     annotationExpressionParseError:
     annotationColonError:
-        destroyExpression(caller.type);
     annotationTypeParseError:
         throw(callerParseError);
     }
@@ -1454,24 +5513,29 @@ bool parser_parseExpression(
     
         if (pParser->next == '?') {
             for (size_t i = 0; i < parameterCount; i++) {
-                if (!type_print(pParameters[i].type, module, parameterCount, pParameters))
+                if (!type_print(pParameters[i].type, module, parameterCount, pParameters, &output))
+                    throw(parameterQuestionMarkError);
+                if (!output_format(&output, " [%s]\n", symbol_getString(pParameters[i].name).pData))
                     throw(parameterQuestionMarkError);
-                fprintf(stdout, " [%s]\n", pParameters[i].name.pData);
             }
-            fprintf(stdout, "~ ");
-            if (!type_print(type, module, parameterCount, pParameters))
+            if (!output_format(&output, "~ "))
+                throw(parameterQuestionMarkError);
+            if (!type_print(type, module, parameterCount, pParameters, &output))
+                throw(parameterQuestionMarkError);
+            if (!output_format(&output, "\n\n"))
+                throw(parameterQuestionMarkError);
+            if (!output_sync(&output))
                 throw(parameterQuestionMarkError);
-            fprintf(stdout, "\n\n");
             throw(parameterQuestionMarkError);
         }
         
-        String name;
+        Symbol name;
         if (!parser_parseWord(pParser, &name))
             throw(parameterNameParseError);
         
         size_t index;
         for (index = 0; index < parameterCount; index++) {
-            if (string_equals(name, pParameters[index].name))
+            if (name == pParameters[index].name)
                 break;
         }
         if (index == parameterCount)
@@ -1487,21 +5551,18 @@ bool parser_parseExpression(
             throw(parameterExpressionCreateError);
         goto callerParseSuccess;
     
-        destroyExpression(caller.value);
     parameterExpressionCreateError:
-        destroyEvaluation(evaluation);
     parameterEvaluationCreateError:
-        destroyExpression(caller.type);
     parameterTypeDuplicateError:
     parameterNameError:
-        destroyString(name);
     parameterNameParseError:
     parameterQuestionMarkError:
         throw(callerParseError);
     }
     throw(invalidSymbolError);
 
-callerParseSuccess:
+callerParseSuccess:;
+    bool isDelayed = evaluator.isLazy && isAnnotation && parameterCount == 0 && pExpressionRegion == &scratchRegion;
     while (pParser->next == '.') {
         parser_advance(pParser);
         parser_skipWhitespace(pParser);
@@ -1513,31 +5574,34 @@ callerParseSuccess:
     
         if (pParser->next == '?') {
             for (size_t i = 0; i < parameterCount; i++) {
-                if (!type_print(pParameters[i].type, module, parameterCount, pParameters))
+                if (!type_print(pParameters[i].type, module, parameterCount, pParameters, &output))
+                    throw(destructionQuestionMarkError);
+                if (!output_format(&output, " [%s]\n", symbol_getString(pParameters[i].name).pData))
+                    throw(destructionQuestionMarkError);
+            }
+            if (!output_format(&output, "~ "))
+                throw(destructionQuestionMarkError);
+            if (!type_print(caller.type, module, parameterCount, pParameters, &output))
+                throw(destructionQuestionMarkError);
+            if (!output_format(&output, "\n"))
+                throw(destructionQuestionMarkError);
+            for (size_t i = 0; i < matrix.destructorCount; i++) {
+                if (!output_format(&output, ".%s\n", symbol_getString(matrix.pDestructors[i].name).pData))
                     throw(destructionQuestionMarkError);
-                fprintf(stdout, " [%s]\n", pParameters[i].name.pData);
             }
-            fprintf(stdout, "~ ");
-            if (!type_print(caller.type, module, parameterCount, pParameters))
+            if (!output_format(&output, "\n"))
+                throw(destructionQuestionMarkError);
+            if (!output_sync(&output))
                 throw(destructionQuestionMarkError);
-            fprintf(stdout, "\n");
-            for (size_t i = 0; i < matrix.destructorCount; i++)
-                fprintf(stdout, ".%s\n", matrix.pDestructors[i].name.pData);
-            fprintf(stdout, "\n");
             throw(destructionQuestionMarkError);
         }
         
-        String name;
+        Symbol name;
         if (!parser_parseName(pParser, &name))
             throw(destructionNameParseError);
         
         size_t index;
-        for (index = 0; index < matrix.destructorCount; index++) {
-            Destructor destructor = matrix.pDestructors[index];
-            if (string_equals(destructor.name, name))
-                break;
-        }
-        if (index == matrix.destructorCount)
+        if (!matrix_findDestructor(matrix, name, &index))
             throw(destructionNameError);
         Destructor destructor = matrix.pDestructors[index];
         
@@ -1553,18 +5617,17 @@ callerParseSuccess:
             typeSubstitutionCount++
         ) {
             Expression parameterType;
-            if (!expression_substitute(
-                typeConstructor.pParameterTypes[typeSubstitutionCount], module, pSubstitutions, &parameterType
+            if (!expression_instantiate(
+                typeConstructor.pParameterTypes[typeSubstitutionCount], module, pTypeConstruction, pSubstitutions, &parameterType
             ))
                 throw(destructionParameterTypeSubstituteError);
         
             pSubstitutions[typeSubstitutionCount] = (Substitution) {
                 .type = parameterType,
-                .value = pTypeConstruction->pArguments[typeSubstitutionCount]
+                .value = construction_getArguments(pTypeConstruction)[typeSubstitutionCount]
             };
             continue;
         
-            destroyExpression(parameterType);
         destructionParameterTypeSubstituteError:
             throw(destructionTypeSubstitutionsError);
         }
@@ -1576,8 +5639,8 @@ callerParseSuccess:
             destructorSubstitutionCount++
         ) {
             Expression parameterType;
-            if (!expression_substitute(
-                destructor.pParameterTypes[destructorSubstitutionCount], module, pSubstitutions, &parameterType
+            if (!expression_instantiate(
+                destructor.pParameterTypes[destructorSubstitutionCount], module, pTypeConstruction, pSubstitutions, &parameterType
             ))
                 throw(destructionParameterDestructorSubstituteError);
             
@@ -1591,9 +5654,7 @@ callerParseSuccess:
             };
             continue;
     
-            destroyExpression(parameterValue);
         destructionParameterValueParseError:
-            destroyExpression(parameterType);
         destructionParameterDestructorSubstituteError:
             throw(destructionDestructorSubstitutionsError);
         }
@@ -1605,39 +5666,29 @@ callerParseSuccess:
             pArguments[i] = pSubstitutions[typeSubstitutionCount + 1 + i].value;
         
         Substitution newCaller;
-        if (!substitution_destruct(caller, module, index, pArguments, &newCaller))
-            throw(destructionDestructError);
+        if (isDelayed) {
+            if (!substitution_delay(module, pTypeConstruction, index, pSubstitutions, pParser->offset, &newCaller))
+                throw(destructionDestructError);
+        } else {
+            if (!substitution_destruct(caller, module, index, pArguments, true, &newCaller))
+                throw(destructionDestructError);
+            if (evaluator.isLazy && !expression_normalize(newCaller.value, module, &newCaller.value))
+                throw(destructionDestructError);
+        }
     
-        destroyExpression(caller.value);
-        destroyExpression(caller.type);
         caller = newCaller;
         free(pArguments);
-        for (size_t i = 0; i < destructorSubstitutionCount; i++) {
-            destroyExpression(pSubstitutions[typeSubstitutionCount + 1 + i].value);
-            destroyExpression(pSubstitutions[typeSubstitutionCount + 1 + i].type);
-        }
-        for (size_t i = 0; i < typeSubstitutionCount; i++)
-            destroyExpression(pSubstitutions[i].type);
         free(pSubstitutions);
         continue;
     
-        destroyExpression(newCaller.value);
-        destroyExpression(newCaller.type);
     destructionDestructError:
         free(pArguments);
     destructionArgumentsMallocError:
     destructionDestructorSubstitutionsError:
-        for (size_t i = 0; i < destructorSubstitutionCount; i++) {
-            destroyExpression(pSubstitutions[typeSubstitutionCount + 1 + i].value);
-            destroyExpression(pSubstitutions[typeSubstitutionCount + 1 + i].type);
-        }
     destructionTypeSubstitutionsError:
-        for (size_t i = 0; i < typeSubstitutionCount; i++)
-            destroyExpression(pSubstitutions[i].type);
         free(pSubstitutions);
     destructionSubstitutionsMallocError:
     destructionNameError:
-        destroyString(name);
     destructionNameParseError:
     destructionTypeError:
     destructionQuestionMarkError:
@@ -1656,8 +5707,6 @@ callerParseSuccess:
 typeMismatchError:
 evaluationEndError:
 destructionParseError:
-    destroyExpression(caller.value);
-    destroyExpression(caller.type);
 callerParseError:
 invalidSymbolError:
     return false;
@@ -1669,9 +5718,9 @@ bool parser_parseType(
 ) {
     Construction universeTypeConstruction = {
         .index = 0,
-        .argumentCount = 0,
-        .pArguments = NULL
+        .argumentCount = 0
     };
+    universeTypeConstruction.hash = construction_hash(universeTypeConstruction, NULL);
     Expression universeType = {
         .kind = CONSTRUCTION_EXPRESSION,
         .pData = &universeTypeConstruction
@@ -1689,15 +5738,20 @@ bool parser_parseStatement(Parser* pParser, Module* pModule, size_t depth) {
         parser_advance(pParser);
         parser_skipWhitespace(pParser);
         
-        if (!parseFile(fileName.pData, pModule, depth))
+        String filePath = {.length = 0, .pData = NULL};
+        if (!string_duplicate(fileName, &filePath))
+            throw(filePathDuplicateError);
+        watch.resumeOffset = pParser->offset;
+        if (!parseFile(pParser->directory, filePath.pData, pModule, depth))
             throw(fileParseEndError);
         
-        destroyString(fileName);
+        destroyString(filePath);
         return true;
 
     fileParseEndError:
+        destroyString(filePath);
+    filePathDuplicateError:
     fileNameEndError:
-        destroyString(fileName);
     fileNameParseError:
         return false;
     }
@@ -1705,7 +5759,7 @@ bool parser_parseStatement(Parser* pParser, Module* pModule, size_t depth) {
         parser_advance(pParser);
         parser_skipWhitespace(pParser);
         
-        String name;
+        Symbol name;
         if (!parser_parseName(pParser, &name))
             throw(namespaceNameParseError);
         
@@ -1713,39 +5767,43 @@ bool parser_parseStatement(Parser* pParser, Module* pModule, size_t depth) {
             throw(namespaceBeginError);
         parser_advance(pParser);
         parser_skipWhitespace(pParser);
+        if (watch.isEnabled) {
+            if (!watch_pushNamespace(name))
+                throw(namespacePushError);
+        }
     
         while (pParser->next != EOF && pParser->next != '}') {
             if (!parser_parseStatement(pParser, pModule, depth + 1))
                 throw(namespaceStatementParseError);
         }
+        if (watch.isEnabled)
+            watch.namespaceCount--;
     
-        if (!module_endNamespace(pModule, depth + 1, name.pData))
+        if (!module_endNamespace(pModule, depth + 1, name))
             throw(namespaceEndError);
         if (pParser->next != '}')
             throw(namespaceEndError);
         parser_advance(pParser);
         parser_skipWhitespace(pParser);
     
-        destroyString(name);
         return true;
     
     namespaceEndError:
     namespaceStatementParseError:
+    namespacePushError:
     namespaceBeginError:
-        destroyString(name);
     namespaceNameParseError:
         return false;
     }
     if (pParser->next == '#') {
-        parser_advance(pParser);
-        while (pParser->next != EOF && pParser->next != '\n')
-            parser_advance(pParser);
+        parser_skipLine(pParser);
         parser_skipWhitespace(pParser);
         return true;
     }
     if (pParser->next == '$') {
         parser_advance(pParser);
         parser_skipWhitespace(pParser);
+        includeCache.printCount++;
         
         Expression type;
         if (!parser_parseType(pParser, *pModule, 0, NULL, &type))
@@ -1771,27 +5829,29 @@ bool parser_parseStatement(Parser* pParser, Module* pModule, size_t depth) {
             Matrix matrix = pModule->pMatrices[pTypeConstruction->index];
     
             if (pParser->next == '?') {
-                fprintf(stdout, "~ ");
-                if (!type_print(type, *pModule, 0, NULL))
+                if (!output_format(&output, "~ "))
+                    throw(printDestructionQuestionMarkError);
+                if (!type_print(type, *pModule, 0, NULL, &output))
+                    throw(printDestructionQuestionMarkError);
+                if (!output_format(&output, "\n"))
+                    throw(printDestructionQuestionMarkError);
+                for (size_t i = 0; i < matrix.constructorCount; i++) {
+                    if (!output_format(&output, "|%s\n", symbol_getString(matrix.pConstructors[i].name).pData))
+                        throw(printDestructionQuestionMarkError);
+                }
+                if (!output_format(&output, "\n"))
+                    throw(printDestructionQuestionMarkError);
+                if (!output_sync(&output))
                     throw(printDestructionQuestionMarkError);
-                fprintf(stdout, "\n");
-                for (size_t i = 0; i < matrix.constructorCount; i++)
-                    fprintf(stdout, "|%s\n", matrix.pConstructors[i].name.pData);
-                fprintf(stdout, "\n");
                 throw(printDestructionQuestionMarkError);
             }
         
-            String name;
+            Symbol name;
             if (!parser_parseName(pParser, &name))
                 throw(printDestructionNameParseError);
         
             size_t index;
-            for (index = 0; index < matrix.destructorCount; index++) {
-                Destructor destructor = matrix.pDestructors[index];
-                if (string_equals(destructor.name, name))
-                    break;
-            }
-            if (index == matrix.destructorCount)
+            if (!matrix_findDestructor(matrix, name, &index))
                 throw(printDestructionNameError);
             Destructor destructor = matrix.pDestructors[index];
         
@@ -1807,18 +5867,17 @@ bool parser_parseStatement(Parser* pParser, Module* pModule, size_t depth) {
                 typeSubstitutionCount++
             ) {
                 Expression parameterType;
-                if (!expression_substitute(
-                    typeConstructor.pParameterTypes[typeSubstitutionCount], *pModule, pSubstitutions, &parameterType
+                if (!expression_instantiate(
+                    typeConstructor.pParameterTypes[typeSubstitutionCount], *pModule, pTypeConstruction, pSubstitutions, &parameterType
                 ))
                     throw(printDestructionParameterTypeSubstituteError);
             
                 pSubstitutions[typeSubstitutionCount] = (Substitution) {
                     .type = parameterType,
-                    .value = pTypeConstruction->pArguments[typeSubstitutionCount]
+                    .value = construction_getArguments(pTypeConstruction)[typeSubstitutionCount]
                 };
                 continue;
             
-                destroyExpression(parameterType);
             printDestructionParameterTypeSubstituteError:
                 throw(printDestructionTypeSubstitutionsError);
             }
@@ -1830,8 +5889,8 @@ bool parser_parseStatement(Parser* pParser, Module* pModule, size_t depth) {
                 destructorSubstitutionCount++
             ) {
                 Expression parameterType;
-                if (!expression_substitute(
-                    destructor.pParameterTypes[destructorSubstitutionCount], *pModule, pSubstitutions, &parameterType
+                if (!expression_instantiate(
+                    destructor.pParameterTypes[destructorSubstitutionCount], *pModule, pTypeConstruction, pSubstitutions, &parameterType
                 ))
                     throw(printDestructionParameterDestructorSubstituteError);
             
@@ -1848,9 +5907,7 @@ bool parser_parseStatement(Parser* pParser, Module* pModule, size_t depth) {
                 };
                 continue;
             
-                destroyExpression(parameterValue);
             printDestructionParameterValueParseError:
-                destroyExpression(parameterType);
             printDestructionParameterDestructorSubstituteError:
                 throw(printDestructionDestructorSubstitutionsError);
             }
@@ -1862,43 +5919,33 @@ bool parser_parseStatement(Parser* pParser, Module* pModule, size_t depth) {
                 pArguments[i] = pSubstitutions[typeSubstitutionCount + 1 + i].value;
         
             Substitution newCaller;
-            if (!substitution_destruct(
-                (Substitution) {.type = type, .value = value}, *pModule, index, pArguments,
-                &newCaller
-            ))
-                throw(printDestructionDestructError);
+            if (evaluator.isLazy) {
+                if (!substitution_delay(
+                    *pModule, pTypeConstruction, index, pSubstitutions, pParser->offset, &newCaller
+                ))
+                    throw(printDestructionDestructError);
+            } else {
+                if (!substitution_destruct(
+                    (Substitution) {.type = type, .value = value}, *pModule, index, pArguments, true,
+                    &newCaller
+                ))
+                    throw(printDestructionDestructError);
+            }
         
-            destroyExpression(value);
-            destroyExpression(type);
             value = newCaller.value;
             type = newCaller.type;
             free(pArguments);
-            for (size_t i = 0; i < destructorSubstitutionCount; i++) {
-                destroyExpression(pSubstitutions[typeSubstitutionCount + 1 + i].value);
-                destroyExpression(pSubstitutions[typeSubstitutionCount + 1 + i].type);
-            }
-            for (size_t i = 0; i < typeSubstitutionCount; i++)
-                destroyExpression(pSubstitutions[i].type);
             free(pSubstitutions);
             continue;
         
-            destroyExpression(newCaller.value);
-            destroyExpression(newCaller.type);
         printDestructionDestructError:
             free(pArguments);
         printDestructionArgumentsMallocError:
         printDestructionDestructorSubstitutionsError:
-            for (size_t i = 0; i < destructorSubstitutionCount; i++) {
-                destroyExpression(pSubstitutions[typeSubstitutionCount + 1 + i].value);
-                destroyExpression(pSubstitutions[typeSubstitutionCount + 1 + i].type);
-            }
         printDestructionTypeSubstitutionsError:
-            for (size_t i = 0; i < typeSubstitutionCount; i++)
-                destroyExpression(pSubstitutions[i].type);
             free(pSubstitutions);
         printDestructionSubstitutionsMallocError:
         printDestructionNameError:
-            destroyString(name);
         printDestructionNameParseError:
         printDestructionTypeError:
         printDestructionQuestionMarkError:
@@ -1914,55 +5961,38 @@ bool parser_parseStatement(Parser* pParser, Module* pModule, size_t depth) {
         parser_advance(pParser);
         parser_skipWhitespace(pParser);
         
-        if (!expression_print(value, *pModule, 0, NULL, type))
+        if (evaluator.isLazy && !expression_normalize(value, *pModule, &value))
+            throw(printError);
+        if (evaluator.isLazy && !expression_normalize(type, *pModule, &type))
+            throw(printError);
+        if (!expression_print(value, *pModule, 0, NULL, type, &output))
+            throw(printError);
+        if (!output_writeCharacter(&output, '\n'))
             throw(printError);
-        if (fputc('\n', stdout) == EOF)
+        if (!output_sync(&output))
             throw(printError);
         
-        destroyExpression(value);
-        destroyExpression(type);
+        region_reset(&scratchRegion);
         return true;
     
     printSemicolonError:
     printEndError:
     printDestructionParseError:
     printError:
-        destroyExpression(value);
     printValueParseError:
     printColonError:
-        destroyExpression(type);
     printTypeParseError:
+        region_reset(&scratchRegion);
         return false;
     }
-    if (
-        isalnum(pParser->next) ||
-        pParser->next == '_' ||
-        pParser->next == '+' ||
-        pParser->next == '-' ||
-        pParser->next == '*' ||
-        pParser->next == '/' ||
-        pParser->next == '%' ||
-        pParser->next == '^' ||
-        pParser->next == '&' ||
-        pParser->next == '=' ||
-        pParser->next == '\'' ||
-        pParser->next == '"' ||
-        pParser->next == '\\' ||
-        pParser->next == ',' ||
-        pParser->next == '`'
-    ) {
-        String typeName;
+    if (isWordCharacter(pParser->next)) {
+        Symbol typeName;
         if (!parser_parseName(pParser, &typeName))
             throw(typeNameParseError);
         
         Matrix typeMatrix = pModule->pMatrices[0];
         size_t typeIndex;
-        for (typeIndex = 0; typeIndex < typeMatrix.constructorCount; typeIndex++) {
-            Constructor constructor = typeMatrix.pConstructors[typeIndex];
-            if (string_equals(constructor.name, typeName))
-                break;
-        }
-        if (typeIndex == typeMatrix.constructorCount)
+        if (!matrix_findConstructor(typeMatrix, typeName, &typeIndex))
             throw(typeNameError);
         Constructor typeConstructor = typeMatrix.pConstructors[typeIndex];
         Matrix* pMatrix = &pModule->pMatrices[typeIndex];
@@ -1972,7 +6002,7 @@ bool parser_parseStatement(Parser* pParser, Module* pModule, size_t depth) {
             throw(typeParametersMallocError);
         size_t typeParameterCount;
         for (typeParameterCount = 0; typeParameterCount < typeConstructor.parameterCount; typeParameterCount++) {
-            String name;
+            Symbol name;
             if (pParser->next != '(')
                 throw(typeParameterDollarSignError);
             parser_advance(pParser);
@@ -1991,7 +6021,6 @@ bool parser_parseStatement(Parser* pParser, Module* pModule, size_t depth) {
             continue;
     
         typeParameterNameEndError:
-            destroyString(name);
         typeParameterNameParseError:
         typeParameterDollarSignError:
             throw(typeParametersParseError);
@@ -2001,16 +6030,15 @@ bool parser_parseStatement(Parser* pParser, Module* pModule, size_t depth) {
             parser_advance(pParser);
             parser_skipWhitespace(pParser);
             
-            String name;
+            Symbol name;
             if (!parser_parseWord(pParser, &name))
                 throw(constructorNameParseError);
-            for (size_t i = 0; i < pMatrix->constructorCount; i++) {
-                Constructor constructor = pMatrix->pConstructors[i];
-                if (string_equals(constructor.name, name))
-                    throw(constructorNameError);
-            }
+            size_t existingIndex;
+            if (matrix_findConstructor(*pMatrix, name, &existingIndex))
+                throw(constructorNameError);
             
             size_t parameterCount = 0;
+            size_t parameterCapacity = 0;
             Parameter* pParameters = NULL;
             while (pParser->next != ';') {
                 Parameter* pCombinedParameters = malloc(
@@ -2033,12 +6061,12 @@ bool parser_parseStatement(Parser* pParser, Module* pModule, size_t depth) {
                 parser_advance(pParser);
                 parser_skipWhitespace(pParser);
     
-                String parameterName;
+                Symbol parameterName;
                 if (!parser_parseWord(pParser, &parameterName))
                     throw(constructorParameterNameParseError);
                 for (size_t i = 0; i < typeParameterCount + parameterCount; i++) {
                     Parameter parameter = pCombinedParameters[i];
-                    if (string_equals(parameter.name, parameterName))
+                    if (parameter.name == parameterName)
                         throw(constructorParameterNameError);
                 }
                 
@@ -2047,10 +6075,13 @@ bool parser_parseStatement(Parser* pParser, Module* pModule, size_t depth) {
                 parser_advance(pParser);
                 parser_skipWhitespace(pParser);
                 
-                Parameter* pNewParameters = realloc(pParameters, (parameterCount + 1) * sizeof(Parameter));
-                if (pNewParameters == NULL)
-                    throw(constructorParametersReallocError);
-                pParameters = pNewParameters;
+                if (parameterCount == parameterCapacity) {
+                    parameterCapacity = parameterCapacity == 0 ? 4 : 2 * parameterCapacity;
+                    Parameter* pNewParameters = realloc(pParameters, parameterCapacity * sizeof(Parameter));
+                    if (pNewParameters == NULL)
+                        throw(constructorParametersReallocError);
+                    pParameters = pNewParameters;
+                }
                 pParameters[parameterCount] = (Parameter) {
                     .type = type,
                     .name = parameterName
@@ -2062,10 +6093,8 @@ bool parser_parseStatement(Parser* pParser, Module* pModule, size_t depth) {
             constructorParametersReallocError:
             constructorParameterEndError:
             constructorParameterNameError:
-                destroyString(parameterName);
             constructorParameterNameParseError:
             constructorParameterColonError:
-                destroyExpression(type);
             constructorParameterTypeParseError:
                 free(pCombinedParameters);
             constructorCombinedParametersMallocError:
@@ -2084,58 +6113,18 @@ bool parser_parseStatement(Parser* pParser, Module* pModule, size_t depth) {
                 .parameterCount = parameterCount,
                 .pParameterTypes = pParameterTypes
             };
-            Constructor* pNewConstructors = realloc(
-                pMatrix->pConstructors, (pMatrix->constructorCount + 1) * sizeof(Constructor)
-            );
-            if (pNewConstructors == NULL)
-                throw(constructorsReallocError);
-            pMatrix->pConstructors = pNewConstructors;
-            for (size_t i = 0; i < pMatrix->destructorCount; i++) {
-                Destructor* pDestructor = &pMatrix->pDestructors[i];
-                Expression* pNewRules = realloc(
-                    pDestructor->pRules, (pMatrix->constructorCount + 1) * sizeof(Expression)
-                );
-                if (pNewRules == NULL)
-                    throw(constructorsReallocError);
-                pDestructor->pRules = pNewRules;
-                pDestructor->pRules[pMatrix->constructorCount] = (Expression) {
-                    .kind = UNSPECIFIED_EXPRESSION,
-                    .pData = NULL
-                };
-            }
-            pMatrix->pConstructors[pMatrix->constructorCount] = constructor;
-            pMatrix->constructorCount++;
-            if (typeIndex == 0) {
-                Matrix* pNewMatrices = realloc(pModule->pMatrices, (pModule->matrixCount + 1) * sizeof(Matrix));
-                if (pNewMatrices == NULL)
-                    throw(constructorMatricesReallocError);
-                pModule->pMatrices = pNewMatrices;
-                pModule->pMatrices[pModule->matrixCount] = (Matrix) {
-                    .constructorCount = 0,
-                    .pConstructors = NULL,
-                    .destructorCount = 0,
-                    .pDestructors = NULL
-                };
-                pModule->matrixCount++;
-            }
+            if (!module_addConstructor(pModule, typeIndex, constructor))
+                throw(constructorAddError);
     
-            for (size_t i = 0; i < parameterCount; i++)
-                destroyString(pParameters[i].name);
             free(pParameters);
             goto declarationParseSuccess;
     
-        constructorMatricesReallocError:
-        constructorsReallocError:
+        constructorAddError:
             free(pParameterTypes);
         constructorParameterTypesMallocError:
         constructorParametersParseError:
-            for (size_t i = 0; i < parameterCount; i++) {
-                destroyString(pParameters[i].name);
-                destroyExpression(pParameters[i].type);
-            }
             free(pParameters);
         constructorNameError:
-            destroyString(name);
         constructorNameParseError:
             throw(declarationParseError);
         }
@@ -2143,16 +6132,15 @@ bool parser_parseStatement(Parser* pParser, Module* pModule, size_t depth) {
             parser_advance(pParser);
             parser_skipWhitespace(pParser);
     
-            String name;
+            Symbol name;
             if (!parser_parseName(pParser, &name))
                 throw(destructorNameParseError);
-            for (size_t i = 0; i < typeMatrix.destructorCount; i++) {
-                Destructor destructor = typeMatrix.pDestructors[i];
-                if (string_equals(destructor.name, name))
-                    throw(destructorNameError);
-            }
+            size_t existingIndex;
+            if (matrix_findDestructor(typeMatrix, name, &existingIndex))
+                throw(destructorNameError);
     
             size_t parameterCount = 0;
+            size_t parameterCapacity = 0;
             Parameter* pParameters = NULL;
             while (pParser->next != '~') {
                 Parameter* pCombinedParameters = malloc(
@@ -2161,9 +6149,12 @@ bool parser_parseStatement(Parser* pParser, Module* pModule, size_t depth) {
                 if (pCombinedParameters == NULL)
                     throw(destructorCombinedParametersMallocError);
                 memcpy(pCombinedParameters, pTypeParameters, typeParameterCount * sizeof(Parameter));
-                Expression* pTypeConstructionArguments = malloc(typeParameterCount * sizeof(Expression));
-                if (pTypeConstructionArguments == NULL)
+                Construction* pTypeConstruction = malloc(
+                    sizeof(Construction) + typeParameterCount * sizeof(Expression)
+                );
+                if (pTypeConstruction == NULL)
                     throw(destructorTypeConstructionArgumentsMallocError);
+                Expression* pTypeConstructionArguments = construction_getArguments(pTypeConstruction);
                 size_t typeConstructionArgumentCount;
                 for (
                     typeConstructionArgumentCount = 0;
@@ -2179,26 +6170,21 @@ bool parser_parseStatement(Parser* pParser, Module* pModule, size_t depth) {
                     pTypeConstructionArguments[typeConstructionArgumentCount] = expression;
                     continue;
                     
-                    destroyExpression(expression);
                 destructorTypeConstructionArgumentExpressionCreateError:
-                    destroyEvaluation(evaluation);
                 destructorTypeConstructionArgumentEvaluationCreateError:
                     throw(destructorTypeConstructionArgumentsCreateError);
                 }
-                Construction typeConstruction = {
+                *pTypeConstruction = (Construction) {
                     .index = typeIndex,
-                    .argumentCount = typeParameterCount,
-                    .pArguments = pTypeConstructionArguments
+                    .argumentCount = typeParameterCount
                 };
+                pTypeConstruction->hash = construction_hash(*pTypeConstruction, pTypeConstructionArguments);
                 pCombinedParameters[typeParameterCount] = (Parameter) {
                     .type = {
                         .kind = CONSTRUCTION_EXPRESSION,
-                        .pData = &typeConstruction
+                        .pData = pTypeConstruction
                     },
-                    .name = {
-                        .length = 0,
-                        .pData = NULL
-                    }
+                    .name = EMPTY_SYMBOL
                 };
                 memcpy(&pCombinedParameters[typeParameterCount + 1], pParameters, parameterCount * sizeof(Parameter));
         
@@ -2214,12 +6200,12 @@ bool parser_parseStatement(Parser* pParser, Module* pModule, size_t depth) {
                 parser_advance(pParser);
                 parser_skipWhitespace(pParser);
         
-                String parameterName;
+                Symbol parameterName;
                 if (!parser_parseWord(pParser, &parameterName))
                     throw(destructorParameterNameParseError);
                 for (size_t i = 0; i < typeParameterCount + 1 + parameterCount; i++) {
                     Parameter parameter = pCombinedParameters[i];
-                    if (string_equals(parameter.name, parameterName))
+                    if (parameter.name == parameterName)
                         throw(destructorParameterNameError);
                 }
                 
@@ -2228,33 +6214,30 @@ bool parser_parseStatement(Parser* pParser, Module* pModule, size_t depth) {
                 parser_advance(pParser);
                 parser_skipWhitespace(pParser);
         
-                Parameter* pNewParameters = realloc(pParameters, (parameterCount + 1) * sizeof(Parameter));
-                if (pNewParameters == NULL)
-                    throw(destructorParametersReallocError);
-                pParameters = pNewParameters;
+                if (parameterCount == parameterCapacity) {
+                    parameterCapacity = parameterCapacity == 0 ? 4 : 2 * parameterCapacity;
+                    Parameter* pNewParameters = realloc(pParameters, parameterCapacity * sizeof(Parameter));
+                    if (pNewParameters == NULL)
+                        throw(destructorParametersReallocError);
+                    pParameters = pNewParameters;
+                }
                 pParameters[parameterCount] = (Parameter) {
                     .type = type,
                     .name = parameterName
                 };
                 parameterCount++;
-                for (size_t i = 0; i < typeConstructionArgumentCount; i++)
-                    destroyExpression(pTypeConstructionArguments[i]);
-                free(pTypeConstructionArguments);
+                free(pTypeConstruction);
                 free(pCombinedParameters);
                 continue;
     
             destructorParametersReallocError:
             destructorParameterEndError:
             destructorParameterNameError:
-                destroyString(parameterName);
             destructorParameterNameParseError:
             destructorParameterColonError:
-                destroyExpression(type);
             destructorParameterTypeParseError:
             destructorTypeConstructionArgumentsCreateError:
-                for (size_t i = 0; i < typeConstructionArgumentCount; i++)
-                    destroyExpression(pTypeConstructionArguments[i]);
-                free(pTypeConstructionArguments);
+                free(pTypeConstruction);
             destructorTypeConstructionArgumentsMallocError:
                 free(pCombinedParameters);
             destructorCombinedParametersMallocError:
@@ -2269,9 +6252,10 @@ bool parser_parseStatement(Parser* pParser, Module* pModule, size_t depth) {
             if (pCombinedParameters == NULL)
                 throw(destructorReturnCombinedParametersMallocError);
             memcpy(pCombinedParameters, pTypeParameters, typeParameterCount * sizeof(Parameter));
-            Expression* pTypeConstructionArguments = malloc(typeParameterCount * sizeof(Expression));
-            if (pTypeConstructionArguments == NULL)
+            Construction* pTypeConstruction = malloc(sizeof(Construction) + typeParameterCount * sizeof(Expression));
+            if (pTypeConstruction == NULL)
                 throw(destructorReturnTypeConstructionArgumentsMallocError);
+            Expression* pTypeConstructionArguments = construction_getArguments(pTypeConstruction);
             size_t typeConstructionArgumentCount;
             for (
                 typeConstructionArgumentCount = 0;
@@ -2287,26 +6271,21 @@ bool parser_parseStatement(Parser* pParser, Module* pModule, size_t depth) {
                 pTypeConstructionArguments[typeConstructionArgumentCount] = expression;
                 continue;
         
-                destroyExpression(expression);
             destructorReturnTypeConstructionArgumentExpressionCreateError:
-                destroyEvaluation(evaluation);
             destructorReturnTypeConstructionArgumentEvaluationCreateError:
                 throw(destructorReturnTypeConstructionArgumentsCreateError);
             }
-            Construction typeConstruction = {
+            *pTypeConstruction = (Construction) {
                 .index = typeIndex,
-                .argumentCount = typeParameterCount,
-                .pArguments = pTypeConstructionArguments
+                .argumentCount = typeParameterCount
             };
+            pTypeConstruction->hash = construction_hash(*pTypeConstruction, pTypeConstructionArguments);
             pCombinedParameters[typeParameterCount] = (Parameter) {
                 .type = {
                     .kind = CONSTRUCTION_EXPRESSION,
-                    .pData = &typeConstruction
+                    .pData = pTypeConstruction
                 },
-                .name = {
-                    .length = 0,
-                    .pData = NULL
-                }
+                .name = EMPTY_SYMBOL
             };
             memcpy(&pCombinedParameters[typeParameterCount + 1], pParameters, parameterCount * sizeof(Parameter));
             
@@ -2323,75 +6302,44 @@ bool parser_parseStatement(Parser* pParser, Module* pModule, size_t depth) {
             for (size_t i = 0; i < parameterCount; i++)
                 pParameterTypes[i] = pParameters[i].type;
             
-            Expression* pRules = malloc(pMatrix->constructorCount * sizeof(Expression));
-            if (pRules == NULL)
-                throw(destructorRulesMallocError);
-            for (size_t i = 0; i < pMatrix->constructorCount; i++)
-                pRules[i] = (Expression) {.kind = UNSPECIFIED_EXPRESSION, .pData = NULL};
-            
-            Destructor* pNewDestructors = realloc(
-                pMatrix->pDestructors, (pMatrix->destructorCount + 1) * sizeof(Destructor)
-            );
-            if (pNewDestructors == NULL)
-                throw(destructorsReallocError);
-            pMatrix->pDestructors = pNewDestructors;
-            pMatrix->pDestructors[pMatrix->destructorCount] = (Destructor) {
+            Destructor destructor = {
                 .depth = depth,
                 .name = name,
                 .parameterCount = parameterCount,
                 .pParameterTypes = pParameterTypes,
-                .returnType = returnType,
-                .pRules = pRules
+                .returnType = returnType
             };
-            pMatrix->destructorCount++;
+            if (!module_addDestructor(pModule, typeIndex, destructor))
+                throw(destructorAddError);
             
-            for (size_t i = 0; i < typeConstructionArgumentCount; i++)
-                destroyExpression(pTypeConstructionArguments[i]);
-            free(pTypeConstructionArguments);
+            free(pTypeConstruction);
             free(pCombinedParameters);
-            for (size_t i = 0; i < parameterCount; i++)
-                destroyString(pParameters[i].name);
             free(pParameters);
             goto declarationParseSuccess;
     
-        destructorsReallocError:
-            free(pRules);
-        destructorRulesMallocError:
+        destructorAddError:
             free(pParameterTypes);
         destructorParameterTypesMallocError:
-            destroyExpression(returnType);
         destructorReturnTypeParseError:
         destructorReturnTypeConstructionArgumentsCreateError:
-            for (size_t i = 0; i < typeConstructionArgumentCount; i++)
-                destroyExpression(pTypeConstructionArguments[i]);
-            free(pTypeConstructionArguments);
+            free(pTypeConstruction);
         destructorReturnTypeConstructionArgumentsMallocError:
             free(pCombinedParameters);
         destructorReturnCombinedParametersMallocError:
         destructorParametersParseError:
-            for (size_t i = 0; i < parameterCount; i++) {
-                destroyString(pParameters[i].name);
-                destroyExpression(pParameters[i].type);
-            }
             free(pParameters);
         destructorNameError:
-            destroyString(name);
         destructorNameParseError:
             throw(declarationParseError);
         }
         if (pParser->next == '[') {
             parser_advance(pParser);
             parser_skipWhitespace(pParser);
-            String constructorName;
+            Symbol constructorName;
             if (!parser_parseName(pParser, &constructorName))
                 throw(ruleConstructorNameParseError);
             size_t constructorIndex;
-            for (constructorIndex = 0; constructorIndex < pMatrix->constructorCount; constructorIndex++) {
-                Constructor constructor = pMatrix->pConstructors[constructorIndex];
-                if (string_equals(constructor.name, constructorName))
-                    break;
-            }
-            if (constructorIndex == pMatrix->constructorCount)
+            if (!matrix_findConstructor(*pMatrix, constructorName, &constructorIndex))
                 throw(ruleConstructorNameError);
             Constructor constructor = pMatrix->pConstructors[constructorIndex];
             
@@ -2404,7 +6352,7 @@ bool parser_parseStatement(Parser* pParser, Module* pModule, size_t depth) {
                 constructorParameterCount < constructor.parameterCount;
                 constructorParameterCount++
             ) {
-                String name;
+                Symbol name;
                 if (pParser->next != '(')
                     throw(ruleConstructorParameterNameParseError);
                 parser_advance(pParser);
@@ -2423,7 +6371,6 @@ bool parser_parseStatement(Parser* pParser, Module* pModule, size_t depth) {
                 continue;
     
             ruleConstructorParameterNameEndError:
-                destroyString(name);
             ruleConstructorParameterNameParseError:
                 throw(ruleConstructorParametersParseError);
             }
@@ -2433,19 +6380,14 @@ bool parser_parseStatement(Parser* pParser, Module* pModule, size_t depth) {
             parser_advance(pParser);
             parser_skipWhitespace(pParser);
     
-            String destructorName;
+            Symbol destructorName;
             if (!parser_parseName(pParser, &destructorName))
                 throw(ruleDestructorNameParseError);
             size_t destructorIndex;
-            for (destructorIndex = 0; destructorIndex < pMatrix->destructorCount; destructorIndex++) {
-                Destructor destructor = pMatrix->pDestructors[destructorIndex];
-                if (string_equals(destructor.name, destructorName))
-                    break;
-            }
-            if (destructorIndex == pMatrix->destructorCount)
+            if (!matrix_findDestructor(*pMatrix, destructorName, &destructorIndex))
                 throw(ruleDestructorNameError);
             Destructor destructor = pMatrix->pDestructors[destructorIndex];
-            if (pMatrix->pDestructors[destructorIndex].pRules[constructorIndex].kind != UNSPECIFIED_EXPRESSION)
+            if (matrix_getRules(*pMatrix, destructorIndex)[constructorIndex].kind != UNSPECIFIED_EXPRESSION)
                 throw(ruleDestructorImplementationError);
             
             Parameter* pParameters = malloc(
@@ -2464,7 +6406,7 @@ bool parser_parseStatement(Parser* pParser, Module* pModule, size_t depth) {
                 destructorParameterCount < destructor.parameterCount;
                 destructorParameterCount++
             ) {
-                String name;
+                Symbol name;
                 if (pParser->next != '(')
                     throw(ruleDestructorParameterNameParseError);
                 parser_advance(pParser);
@@ -2499,15 +6441,16 @@ bool parser_parseStatement(Parser* pParser, Module* pModule, size_t depth) {
                     };
                     continue;
     
-                    destroyExpression(value);
                 ruleDestructorTypeSubstitutionExpressionCreateError:
-                    destroyEvaluation(evaluation);
                 ruleDestructorTypeSubstitutionEvaluationCreateError:
                     throw(ruleDestructorTypeSubstitutionsCreateError);
                 }
-                Expression* pTypeConstructionArguments = malloc(typeParameterCount * sizeof(Expression));
-                if (pTypeConstructionArguments == NULL)
+                Construction* pTypeConstruction = malloc(
+                    sizeof(Construction) + typeParameterCount * sizeof(Expression)
+                );
+                if (pTypeConstruction == NULL)
                     throw(ruleDestructorTypeConstructionArgumentsMallocError);
+                Expression* pTypeConstructionArguments = construction_getArguments(pTypeConstruction);
                 size_t typeConstructionArgumentCount;
                 for (
                     typeConstructionArgumentCount = 0;
@@ -2523,20 +6466,21 @@ bool parser_parseStatement(Parser* pParser, Module* pModule, size_t depth) {
                     pTypeConstructionArguments[typeConstructionArgumentCount] = expression;
                     continue;
         
-                    destroyExpression(expression);
                 ruleDestructorTypeConstructionArgumentExpressionCreateError:
-                    destroyEvaluation(evaluation);
                 ruleDestructorTypeConstructionArgumentEvaluationCreateError:
                     throw(ruleDestructorTypeConstructionArgumentsCreateError);
                 }
-                Construction typeConstruction = {
+                *pTypeConstruction = (Construction) {
                     .index = typeIndex,
-                    .argumentCount = typeParameterCount,
-                    .pArguments = pTypeConstructionArguments
+                    .argumentCount = typeParameterCount
                 };
-                Expression* pValueConstructionArguments = malloc(constructorParameterCount * sizeof(Expression));
-                if (pValueConstructionArguments == NULL)
+                pTypeConstruction->hash = construction_hash(*pTypeConstruction, pTypeConstructionArguments);
+                Construction* pValueConstruction = malloc(
+                    sizeof(Construction) + constructorParameterCount * sizeof(Expression)
+                );
+                if (pValueConstruction == NULL)
                     throw(ruleDestructorValueConstructionArgumentsMallocError);
+                Expression* pValueConstructionArguments = construction_getArguments(pValueConstruction);
                 size_t valueConstructionArgumentCount;
                 for (
                     valueConstructionArgumentCount = 0;
@@ -2555,25 +6499,23 @@ bool parser_parseStatement(Parser* pParser, Module* pModule, size_t depth) {
                     pValueConstructionArguments[valueConstructionArgumentCount] = expression;
                     continue;
         
-                    destroyExpression(expression);
                 ruleDestructorValueConstructionArgumentExpressionCreateError:
-                    destroyEvaluation(evaluation);
                 ruleDestructorValueConstructionArgumentEvaluationCreateError:
                     throw(ruleDestructorValueConstructionArgumentsCreateError);
                 }
-                Construction valueConstruction = {
+                *pValueConstruction = (Construction) {
                     .index = constructorIndex,
-                    .argumentCount = constructorParameterCount,
-                    .pArguments = pValueConstructionArguments
+                    .argumentCount = constructorParameterCount
                 };
+                pValueConstruction->hash = construction_hash(*pValueConstruction, pValueConstructionArguments);
                 pSubstitutions[typeSubstitutionCount] = (Substitution) {
                     .type = {
                         .kind = CONSTRUCTION_EXPRESSION,
-                        .pData = &typeConstruction
+                        .pData = pTypeConstruction
                     },
                     .value = {
                         .kind = CONSTRUCTION_EXPRESSION,
-                        .pData = &valueConstruction
+                        .pData = pValueConstruction
                     }
                 };
                 size_t destructorSubstitutionCount;
@@ -2599,9 +6541,7 @@ bool parser_parseStatement(Parser* pParser, Module* pModule, size_t depth) {
                     };
                     continue;
     
-                    destroyExpression(value);
                 ruleDestructorDestructorSubstitutionExpressionCreateError:
-                    destroyEvaluation(evaluation);
                 ruleDestructorDestructorSubstitutionEvaluationCreateError:
                     throw(ruleDestructorDestructorSubstitutionsCreateError);
                 }
@@ -2617,39 +6557,23 @@ bool parser_parseStatement(Parser* pParser, Module* pModule, size_t depth) {
                     .type = type,
                     .name = name
                 };
-                for (size_t i = 0; i < destructorSubstitutionCount; i++)
-                    destroyExpression(pSubstitutions[typeSubstitutionCount + 1 + i].value);
-                for (size_t i = 0; i < valueConstructionArgumentCount; i++)
-                    destroyExpression(pValueConstructionArguments[i]);
-                free(pValueConstructionArguments);
-                for (size_t i = 0; i < typeConstructionArgumentCount; i++)
-                    destroyExpression(pTypeConstructionArguments[i]);
-                free(pTypeConstructionArguments);
+                free(pValueConstruction);
+                free(pTypeConstruction);
                 free(pSubstitutions);
                 continue;
     
-                destroyExpression(type);
             ruleDestructorTypeSubstituteError:
             ruleDestructorDestructorSubstitutionsCreateError:
-                for (size_t i = 0; i < destructorSubstitutionCount; i++)
-                    destroyExpression(pSubstitutions[typeSubstitutionCount + 1 + i].value);
             ruleDestructorValueConstructionArgumentsCreateError:
-                for (size_t i = 0; i < valueConstructionArgumentCount; i++)
-                    destroyExpression(pValueConstructionArguments[i]);
-                free(pValueConstructionArguments);
+                free(pValueConstruction);
             ruleDestructorValueConstructionArgumentsMallocError:
             ruleDestructorTypeConstructionArgumentsCreateError:
-                for (size_t i = 0; i < typeConstructionArgumentCount; i++)
-                    destroyExpression(pTypeConstructionArguments[i]);
-                free(pTypeConstructionArguments);
+                free(pTypeConstruction);
             ruleDestructorTypeConstructionArgumentsMallocError:
             ruleDestructorTypeSubstitutionsCreateError:
-                for (size_t i = 0; i < typeSubstitutionCount; i++)
-                    destroyExpression(pSubstitutions[i].value);
                 free(pSubstitutions);
             ruleDestructorSubstitutionsMallocError:
             ruleDestructorParameterNameEndError:
-                destroyString(name);
             ruleDestructorParameterNameParseError:
                 throw(ruleDestructorParametersParseError);
             }
@@ -2687,15 +6611,14 @@ bool parser_parseStatement(Parser* pParser, Module* pModule, size_t depth) {
                 };
                 continue;
         
-                destroyExpression(value);
             ruleReturnTypeTypeSubstitutionExpressionCreateError:
-                destroyEvaluation(evaluation);
             ruleReturnTypeTypeSubstitutionEvaluationCreateError:
                 throw(ruleReturnTypeTypeSubstitutionsCreateError);
             }
-            Expression* pTypeConstructionArguments = malloc(typeParameterCount * sizeof(Expression));
-            if (pTypeConstructionArguments == NULL)
+            Construction* pTypeConstruction = malloc(sizeof(Construction) + typeParameterCount * sizeof(Expression));
+            if (pTypeConstruction == NULL)
                 throw(ruleReturnTypeTypeConstructionArgumentsMallocError);
+            Expression* pTypeConstructionArguments = construction_getArguments(pTypeConstruction);
             size_t typeConstructionArgumentCount;
             for (
                 typeConstructionArgumentCount = 0;
@@ -2711,20 +6634,21 @@ bool parser_parseStatement(Parser* pParser, Module* pModule, size_t depth) {
                 pTypeConstructionArguments[typeConstructionArgumentCount] = expression;
                 continue;
         
-                destroyExpression(expression);
             ruleReturnTypeTypeConstructionArgumentExpressionCreateError:
-                destroyEvaluation(evaluation);
             ruleReturnTypeTypeConstructionArgumentEvaluationCreateError:
                 throw(ruleReturnTypeTypeConstructionArgumentsCreateError);
             }
-            Construction typeConstruction = {
+            *pTypeConstruction = (Construction) {
                 .index = typeIndex,
-                .argumentCount = typeParameterCount,
-                .pArguments = pTypeConstructionArguments
+                .argumentCount = typeParameterCount
             };
-            Expression* pValueConstructionArguments = malloc(constructorParameterCount * sizeof(Expression));
-            if (pValueConstructionArguments == NULL)
+            pTypeConstruction->hash = construction_hash(*pTypeConstruction, pTypeConstructionArguments);
+            Construction* pValueConstruction = malloc(
+                sizeof(Construction) + constructorParameterCount * sizeof(Expression)
+            );
+            if (pValueConstruction == NULL)
                 throw(ruleReturnTypeValueConstructionArgumentsMallocError);
+            Expression* pValueConstructionArguments = construction_getArguments(pValueConstruction);
             size_t valueConstructionArgumentCount;
             for (
                 valueConstructionArgumentCount = 0;
@@ -2743,25 +6667,23 @@ bool parser_parseStatement(Parser* pParser, Module* pModule, size_t depth) {
                 pValueConstructionArguments[valueConstructionArgumentCount] = expression;
                 continue;
         
-                destroyExpression(expression);
             ruleReturnTypeValueConstructionArgumentExpressionCreateError:
-                destroyEvaluation(evaluation);
             ruleReturnTypeValueConstructionArgumentEvaluationCreateError:
                 throw(ruleReturnTypeValueConstructionArgumentsCreateError);
             }
-            Construction valueConstruction = {
+            *pValueConstruction = (Construction) {
                 .index = constructorIndex,
-                .argumentCount = constructorParameterCount,
-                .pArguments = pValueConstructionArguments
+                .argumentCount = constructorParameterCount
             };
+            pValueConstruction->hash = construction_hash(*pValueConstruction, pValueConstructionArguments);
             pSubstitutions[typeSubstitutionCount] = (Substitution) {
                 .type = {
                     .kind = CONSTRUCTION_EXPRESSION,
-                    .pData = &typeConstruction
+                    .pData = pTypeConstruction
                 },
                 .value = {
                     .kind = CONSTRUCTION_EXPRESSION,
-                    .pData = &valueConstruction
+                    .pData = pValueConstruction
                 }
             };
             size_t destructorSubstitutionCount;
@@ -2787,9 +6709,7 @@ bool parser_parseStatement(Parser* pParser, Module* pModule, size_t depth) {
                 };
                 continue;
         
-                destroyExpression(value);
             ruleReturnTypeDestructorSubstitutionExpressionCreateError:
-                destroyEvaluation(evaluation);
             ruleReturnTypeDestructorSubstitutionEvaluationCreateError:
                 throw(ruleReturnTypeDestructorSubstitutionsCreateError);
             }
@@ -2805,232 +6725,4043 @@ bool parser_parseStatement(Parser* pParser, Module* pModule, size_t depth) {
             ))
                 throw(ruleResultParseError);
             
-            pMatrix->pDestructors[destructorIndex].pRules[constructorIndex] = rule;
-            destroyExpression(type);
-            for (size_t i = 0; i < destructorSubstitutionCount; i++)
-                destroyExpression(pSubstitutions[typeSubstitutionCount + 1 + i].value);
-            for (size_t i = 0; i < valueConstructionArgumentCount; i++)
-                destroyExpression(pValueConstructionArguments[i]);
-            free(pValueConstructionArguments);
-            for (size_t i = 0; i < typeConstructionArgumentCount; i++)
-                destroyExpression(pTypeConstructionArguments[i]);
-            free(pTypeConstructionArguments);
-            for (size_t i = 0; i < typeSubstitutionCount; i++)
-                destroyExpression(pSubstitutions[i].value);
+            if (!module_setRule(pModule, typeIndex, destructorIndex, constructorIndex, rule))
+                throw(ruleSetError);
+            free(pValueConstruction);
+            free(pTypeConstruction);
             free(pSubstitutions);
-            for (size_t i = 0; i < destructorParameterCount; i++)
-                destroyString(pParameters[typeParameterCount + constructorParameterCount + i].name);
             free(pParameters);
-            for (size_t i = 0; i < constructorParameterCount; i++)
-                destroyString(pConstructorParameters[i].name);
             free(pConstructorParameters);
             goto declarationParseSuccess;
     
-            destroyExpression(rule);
-        ruleResultParseError:
-            destroyExpression(type);
-        ruleReturnTypeTypeSubstituteError:
-        ruleReturnTypeDestructorSubstitutionsCreateError:
-            for (size_t i = 0; i < destructorSubstitutionCount; i++)
-                destroyExpression(pSubstitutions[typeSubstitutionCount + 1 + i].value);
-        ruleReturnTypeValueConstructionArgumentsCreateError:
-            for (size_t i = 0; i < valueConstructionArgumentCount; i++)
-                destroyExpression(pValueConstructionArguments[i]);
-            free(pValueConstructionArguments);
-        ruleReturnTypeValueConstructionArgumentsMallocError:
-        ruleReturnTypeTypeConstructionArgumentsCreateError:
-            for (size_t i = 0; i < typeConstructionArgumentCount; i++)
-                destroyExpression(pTypeConstructionArguments[i]);
-            free(pTypeConstructionArguments);
-        ruleReturnTypeTypeConstructionArgumentsMallocError:
-        ruleReturnTypeTypeSubstitutionsCreateError:
-            for (size_t i = 0; i < typeSubstitutionCount; i++)
-                destroyExpression(pSubstitutions[i].value);
-            free(pSubstitutions);
-        ruleReturnTypeSubstitutionsMallocError:
-        ruleTildeError:
-        ruleRightParenthesisError:
-        ruleDestructorParametersParseError:
-            for (size_t i = 0; i < destructorParameterCount; i++)
-                destroyString(pParameters[typeParameterCount + constructorParameterCount + i].name);
-            free(pParameters);
-        ruleParametersMallocError:
-        ruleDestructorImplementationError:
-        ruleDestructorNameError:
-            destroyString(destructorName);
-        ruleDestructorNameParseError:
-        rulePeriodError:
-        ruleConstructorParametersParseError:
-            for (size_t i = 0; i < constructorParameterCount; i++)
-                destroyString(pConstructorParameters[i].name);
-            free(pConstructorParameters);
-        ruleConstructorParametersMallocError:
-        ruleConstructorNameError:
-            destroyString(constructorName);
-        ruleConstructorNameParseError:
-            throw(declarationParseError);
+        ruleSetError:
+        ruleResultParseError:
+        ruleReturnTypeTypeSubstituteError:
+        ruleReturnTypeDestructorSubstitutionsCreateError:
+        ruleReturnTypeValueConstructionArgumentsCreateError:
+            free(pValueConstruction);
+        ruleReturnTypeValueConstructionArgumentsMallocError:
+        ruleReturnTypeTypeConstructionArgumentsCreateError:
+            free(pTypeConstruction);
+        ruleReturnTypeTypeConstructionArgumentsMallocError:
+        ruleReturnTypeTypeSubstitutionsCreateError:
+            free(pSubstitutions);
+        ruleReturnTypeSubstitutionsMallocError:
+        ruleTildeError:
+        ruleRightParenthesisError:
+        ruleDestructorParametersParseError:
+            free(pParameters);
+        ruleParametersMallocError:
+        ruleDestructorImplementationError:
+        ruleDestructorNameError:
+        ruleDestructorNameParseError:
+        rulePeriodError:
+        ruleConstructorParametersParseError:
+            free(pConstructorParameters);
+        ruleConstructorParametersMallocError:
+        ruleConstructorNameError:
+        ruleConstructorNameParseError:
+            throw(declarationParseError);
+        }
+        throw(declarationParseError);
+    
+    declarationParseSuccess:
+        if (pParser->next != ';')
+            throw(declarationEndError);
+        parser_advance(pParser);
+        parser_skipWhitespace(pParser);
+        free(pTypeParameters);
+        region_reset(&scratchRegion);
+        return true;
+    
+    declarationEndError:
+    declarationParseError:
+    typeParametersParseError:
+        free(pTypeParameters);
+    typeParametersMallocError:
+    typeNameError:
+    typeNameParseError:
+        region_reset(&scratchRegion);
+        return false;
+    }
+    return false;
+}
+bool module_endNamespace(Module* pModule, size_t depth, Symbol namespace) {
+    if (!module_reserveOperation(pModule))
+        throw(operationReserveError);
+    size_t renameStart = pModule->renameCount;
+    for (size_t i = 0; i < pModule->matrixCount; i++) {
+        Constructor typeConstructor = pModule->pMatrices[0].pConstructors[i];
+        Matrix* pMatrix = &pModule->pMatrices[i];
+        bool constructorRenamed = false;
+        for (size_t j = 0; j < pMatrix->constructorCount; j++) {
+            Constructor* pConstructor = &pMatrix->pConstructors[j];
+            if (pConstructor->depth == depth) {
+                if (!module_recordRename(pModule, CONSTRUCTOR_OPERATION, i, j))
+                    throw(renameRecordError);
+            }
+            if (pConstructor->depth == depth && typeConstructor.depth < depth) {
+                if (!symbol_qualify(namespace, pConstructor->name, &pConstructor->name))
+                    throw(nameQualifyError);
+                constructorRenamed = true;
+            }
+        }
+        bool destructorRenamed = false;
+        for (size_t j = 0; j < pMatrix->destructorCount; j++) {
+            Destructor* pDestructor = &pMatrix->pDestructors[j];
+            if (pDestructor->depth == depth) {
+                if (!module_recordRename(pModule, DESTRUCTOR_OPERATION, i, j))
+                    throw(renameRecordError);
+            }
+            if (pDestructor->depth == depth && typeConstructor.depth < depth) {
+                if (!symbol_qualify(namespace, pDestructor->name, &pDestructor->name))
+                    throw(nameQualifyError);
+                destructorRenamed = true;
+            }
+        }
+        if (constructorRenamed) {
+            if (!nameIndex_rebuild(&pMatrix->constructorIndex, &pMatrix->pConstructors->name, sizeof(Constructor), pMatrix->constructorCount))
+                throw(nameIndexRebuildError);
+        }
+        if (destructorRenamed) {
+            if (!nameIndex_rebuild(&pMatrix->destructorIndex, &pMatrix->pDestructors->name, sizeof(Destructor), pMatrix->destructorCount))
+                throw(nameIndexRebuildError);
+        }
+    }
+    for (size_t i = 0; i < pModule->matrixCount; i++) {
+        Constructor typeConstructor = pModule->pMatrices[0].pConstructors[i];
+        Matrix matrix = pModule->pMatrices[i];
+        for (size_t j = 0; j < matrix.constructorCount; j++) {
+            Constructor* pConstructor = &matrix.pConstructors[j];
+            if (pConstructor->depth == depth)
+                pConstructor->depth--;
+        }
+        for (size_t j = 0; j < matrix.destructorCount; j++) {
+            Destructor* pDestructor = &matrix.pDestructors[j];
+            if (pDestructor->depth == depth)
+                pDestructor->depth--;
+        }
+    }
+    module_appendOperation(pModule, (Operation) {
+        .kind = NAMESPACE_OPERATION,
+        .typeIndex = 0,
+        .destructorIndex = 0,
+        .constructorIndex = 0,
+        .depth = depth,
+        .name = namespace,
+        .renameStart = renameStart,
+        .arenaMark = arena_mark(pModule->region.arena)
+    }, 0);
+    return true;
+    
+nameIndexRebuildError:
+nameQualifyError:
+renameRecordError:
+operationReserveError:
+    return false;
+}
+bool module_validate(Module module, size_t depth) {
+    for (size_t i = 0; i < module.matrixCount; i++) {
+        Constructor typeConstructor = module.pMatrices[0].pConstructors[i];
+        Matrix matrix = module.pMatrices[i];
+        for (size_t j = 0; j < matrix.destructorCount; j++) {
+            Destructor destructor = matrix.pDestructors[j];
+            for (size_t k = 0; k < matrix.constructorCount; k++) {
+                Constructor constructor = matrix.pConstructors[k];
+                if (constructor.depth < depth)
+                    continue;
+                if (destructor.depth < depth)
+                    continue;
+                if (matrix_getRules(matrix, j)[k].kind == UNSPECIFIED_EXPRESSION) {
+                    fprintf(
+                        stderr, "Unimplemented case found: %s [%s.%s]\n",
+                        symbol_getString(typeConstructor.name).pData, symbol_getString(constructor.name).pData,
+                        symbol_getString(destructor.name).pData
+                    );
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+bool createReferenceExpression(size_t index, Expression* pExpression) {
+    Evaluation evaluation;
+    if (!createReferenceEvaluation(index, &evaluation))
+        throw(referenceEvaluationCreateError);
+    if (!createEvaluationExpression(evaluation, pExpression))
+        throw(referenceExpressionCreateError);
+    return true;
+    
+referenceExpressionCreateError:
+referenceEvaluationCreateError:
+    return false;
+}
+bool expression_check(
+    Expression expression, Module module, size_t parameterCount, Parameter const* pParameters, Expression type
+) {
+    if (expression.kind == CONSTRUCTION_EXPRESSION) {
+        Construction* pData = expression.pData;
+        if (type.kind != CONSTRUCTION_EXPRESSION)
+            throw(constructionTypeError);
+        Construction* pTypeConstruction = type.pData;
+        Constructor typeConstructor = module.pMatrices[0].pConstructors[pTypeConstruction->index];
+        Matrix matrix = module.pMatrices[pTypeConstruction->index];
+        
+        if (pData->index >= matrix.constructorCount)
+            throw(constructionIndexError);
+        Constructor constructor = matrix.pConstructors[pData->index];
+        if (pData->argumentCount != constructor.parameterCount)
+            throw(constructionArgumentCountError);
+        
+        Substitution* pSubstitutions = malloc(
+            (typeConstructor.parameterCount + constructor.parameterCount) * sizeof(Substitution)
+        );
+        if (pSubstitutions == NULL)
+            throw(constructionSubstitutionsMallocError);
+        size_t typeSubstitutionCount;
+        for (
+            typeSubstitutionCount = 0;
+            typeSubstitutionCount < typeConstructor.parameterCount;
+            typeSubstitutionCount++
+        ) {
+            Expression parameterType;
+            if (!expression_substitute(
+                typeConstructor.pParameterTypes[typeSubstitutionCount], module, pSubstitutions, &parameterType
+            ))
+                throw(constructionParameterTypeSubstituteError);
+            
+            pSubstitutions[typeSubstitutionCount] = (Substitution) {
+                .type = parameterType,
+                .value = construction_getArguments(pTypeConstruction)[typeSubstitutionCount]
+            };
+            continue;
+        
+        constructionParameterTypeSubstituteError:
+            throw(constructionTypeSubstitutionsError);
+        }
+        size_t constructorSubstitutionCount;
+        for (
+            constructorSubstitutionCount = 0;
+            constructorSubstitutionCount < constructor.parameterCount;
+            constructorSubstitutionCount++
+        ) {
+            Expression parameterType;
+            if (!expression_substitute(
+                constructor.pParameterTypes[constructorSubstitutionCount], module, pSubstitutions, &parameterType
+            ))
+                throw(constructionParameterConstructorSubstituteError);
+            
+            Expression argument = construction_getArguments(pData)[constructorSubstitutionCount];
+            if (!expression_check(argument, module, parameterCount, pParameters, parameterType))
+                throw(constructionParameterConstructorArgumentCheckError);
+            pSubstitutions[typeSubstitutionCount + constructorSubstitutionCount] = (Substitution) {
+                .type = parameterType,
+                .value = argument
+            };
+            continue;
+        
+        constructionParameterConstructorArgumentCheckError:
+        constructionParameterConstructorSubstituteError:
+            throw(constructionConstructorSubstitutionsError);
+        }
+        
+        free(pSubstitutions);
+        return true;
+    
+    constructionConstructorSubstitutionsError:
+    constructionTypeSubstitutionsError:
+        free(pSubstitutions);
+    constructionSubstitutionsMallocError:
+    constructionArgumentCountError:
+    constructionIndexError:
+    constructionTypeError:
+        return false;
+    }
+    if (expression.kind == EVALUATION_EXPRESSION) {
+        Evaluation* pData = expression.pData;
+        Expression evaluationType;
+        if (!evaluation_check(*pData, module, parameterCount, pParameters, &evaluationType))
+            throw(evaluationCheckError);
+        if (!expression_equals(evaluationType, type))
+            throw(evaluationTypeMismatchError);
+        return true;
+    
+    evaluationTypeMismatchError:
+    evaluationCheckError:
+        return false;
+    }
+    return false;
+}
+bool evaluation_check(
+    Evaluation evaluation, Module module, size_t parameterCount, Parameter const* pParameters, Expression* pType
+) {
+    if (evaluation.kind == REFERENCE_EVALUATION) {
+        size_t* pData = evaluation.pData;
+        if (*pData >= parameterCount)
+            throw(referenceIndexError);
+        
+        Expression type;
+        if (!expression_duplicate(pParameters[*pData].type, &type))
+            throw(referenceTypeDuplicateError);
+        
+        *pType = type;
+        return true;
+    
+    referenceTypeDuplicateError:
+    referenceIndexError:
+        return false;
+    }
+    if (evaluation.kind == DESTRUCTION_EVALUATION) {
+        Destruction* pData = evaluation.pData;
+        
+        Expression type;
+        if (!evaluation_check(pData->caller, module, parameterCount, pParameters, &type))
+            throw(destructionCallerCheckError);
+        if (type.kind != CONSTRUCTION_EXPRESSION)
+            throw(destructionCallerTypeError);
+        Construction* pTypeConstruction = type.pData;
+        Constructor typeConstructor = module.pMatrices[0].pConstructors[pTypeConstruction->index];
+        Matrix matrix = module.pMatrices[pTypeConstruction->index];
+        
+        if (pData->index >= matrix.destructorCount)
+            throw(destructionIndexError);
+        Destructor destructor = matrix.pDestructors[pData->index];
+        if (pData->argumentCount != destructor.parameterCount)
+            throw(destructionArgumentCountError);
+    
+        Substitution* pSubstitutions = malloc(
+            (typeConstructor.parameterCount + 1 + destructor.parameterCount) * sizeof(Substitution)
+        );
+        if (pSubstitutions == NULL)
+            throw(destructionSubstitutionsMallocError);
+        size_t typeSubstitutionCount;
+        for (
+            typeSubstitutionCount = 0;
+            typeSubstitutionCount < typeConstructor.parameterCount;
+            typeSubstitutionCount++
+        ) {
+            Expression parameterType;
+            if (!expression_substitute(
+                typeConstructor.pParameterTypes[typeSubstitutionCount], module, pSubstitutions, &parameterType
+            ))
+                throw(destructionParameterTypeSubstituteError);
+        
+            pSubstitutions[typeSubstitutionCount] = (Substitution) {
+                .type = parameterType,
+                .value = construction_getArguments(pTypeConstruction)[typeSubstitutionCount]
+            };
+            continue;
+        
+        destructionParameterTypeSubstituteError:
+            throw(destructionTypeSubstitutionsError);
+        }
+        pSubstitutions[typeSubstitutionCount] = (Substitution) {
+            .value = {
+                .kind = EVALUATION_EXPRESSION,
+                .pData = &pData->caller
+            },
+            .type = type
+        };
+        size_t destructorSubstitutionCount;
+        for (
+            destructorSubstitutionCount = 0;
+            destructorSubstitutionCount < destructor.parameterCount;
+            destructorSubstitutionCount++
+        ) {
+            Expression parameterType;
+            if (!expression_substitute(
+                destructor.pParameterTypes[destructorSubstitutionCount], module, pSubstitutions, &parameterType
+            ))
+                throw(destructionParameterDestructorSubstituteError);
+        
+            if (!expression_check(
+                pData->pArguments[destructorSubstitutionCount], module, parameterCount, pParameters, parameterType
+            ))
+                throw(destructionParameterDestructorArgumentCheckError);
+            pSubstitutions[typeSubstitutionCount + 1 + destructorSubstitutionCount] = (Substitution) {
+                .type = parameterType,
+                .value = pData->pArguments[destructorSubstitutionCount]
+            };
+            continue;
+    
+        destructionParameterDestructorArgumentCheckError:
+        destructionParameterDestructorSubstituteError:
+            throw(destructionDestructorSubstitutionsError);
+        }
+        
+        Expression resultType;
+        if (!expression_substitute(destructor.returnType, module, pSubstitutions, &resultType))
+            throw(destructionResultTypeComputeError);
+    
+        *pType = resultType;
+        free(pSubstitutions);
+        return true;
+    
+    destructionResultTypeComputeError:
+    destructionDestructorSubstitutionsError:
+    destructionTypeSubstitutionsError:
+        free(pSubstitutions);
+    destructionSubstitutionsMallocError:
+    destructionArgumentCountError:
+    destructionIndexError:
+    destructionCallerTypeError:
+    destructionCallerCheckError:
+        return false;
+    }
+    return false;
+}
+bool module_checkSignatures(Module module, size_t typeIndex) {
+    Construction universeTypeConstruction = {
+        .index = 0,
+        .argumentCount = 0
+    };
+    universeTypeConstruction.hash = construction_hash(universeTypeConstruction, NULL);
+    Expression universeType = {
+        .kind = CONSTRUCTION_EXPRESSION,
+        .pData = &universeTypeConstruction
+    };
+    Constructor typeConstructor = module.pMatrices[0].pConstructors[typeIndex];
+    Matrix matrix = module.pMatrices[typeIndex];
+    size_t typeParameterCount = typeConstructor.parameterCount;
+    
+    Construction* pTypeConstruction = malloc(sizeof(Construction) + typeParameterCount * sizeof(Expression));
+    if (pTypeConstruction == NULL)
+        throw(typeArgumentsMallocError);
+    Expression* pTypeArguments = construction_getArguments(pTypeConstruction);
+    size_t typeArgumentCount;
+    for (typeArgumentCount = 0; typeArgumentCount < typeParameterCount; typeArgumentCount++) {
+        if (!createReferenceExpression(typeArgumentCount, &pTypeArguments[typeArgumentCount]))
+            throw(typeArgumentsCreateError);
+    }
+    *pTypeConstruction = (Construction) {
+        .index = typeIndex,
+        .argumentCount = typeParameterCount
+    };
+    pTypeConstruction->hash = construction_hash(*pTypeConstruction, pTypeArguments);
+    
+    for (size_t i = 0; i < matrix.constructorCount; i++) {
+        Constructor constructor = matrix.pConstructors[i];
+        Parameter* pParameters = malloc((typeParameterCount + constructor.parameterCount) * sizeof(Parameter));
+        if (pParameters == NULL)
+            throw(constructorParametersMallocError);
+        for (size_t j = 0; j < typeParameterCount; j++)
+            pParameters[j] = (Parameter) {.name = EMPTY_SYMBOL, .type = typeConstructor.pParameterTypes[j]};
+        for (size_t j = 0; j < constructor.parameterCount; j++) {
+            if (!expression_check(
+                constructor.pParameterTypes[j], module, typeParameterCount + j, pParameters, universeType
+            ))
+                throw(constructorParameterCheckError);
+            pParameters[typeParameterCount + j] = (Parameter) {
+                .name = EMPTY_SYMBOL,
+                .type = constructor.pParameterTypes[j]
+            };
+        }
+        free(pParameters);
+        continue;
+    
+    constructorParameterCheckError:
+        free(pParameters);
+    constructorParametersMallocError:
+        throw(constructorsCheckError);
+    }
+    for (size_t i = 0; i < matrix.destructorCount; i++) {
+        Destructor destructor = matrix.pDestructors[i];
+        Parameter* pParameters = malloc((typeParameterCount + 1 + destructor.parameterCount) * sizeof(Parameter));
+        if (pParameters == NULL)
+            throw(destructorParametersMallocError);
+        for (size_t j = 0; j < typeParameterCount; j++)
+            pParameters[j] = (Parameter) {.name = EMPTY_SYMBOL, .type = typeConstructor.pParameterTypes[j]};
+        pParameters[typeParameterCount] = (Parameter) {
+            .name = EMPTY_SYMBOL,
+            .type = {
+                .kind = CONSTRUCTION_EXPRESSION,
+                .pData = pTypeConstruction
+            }
+        };
+        for (size_t j = 0; j < destructor.parameterCount; j++) {
+            if (!expression_check(
+                destructor.pParameterTypes[j], module, typeParameterCount + 1 + j, pParameters, universeType
+            ))
+                throw(destructorSignatureCheckError);
+            pParameters[typeParameterCount + 1 + j] = (Parameter) {
+                .name = EMPTY_SYMBOL,
+                .type = destructor.pParameterTypes[j]
+            };
+        }
+        if (!expression_check(
+            destructor.returnType, module, typeParameterCount + 1 + destructor.parameterCount, pParameters,
+            universeType
+        ))
+            throw(destructorSignatureCheckError);
+        free(pParameters);
+        continue;
+    
+    destructorSignatureCheckError:
+        free(pParameters);
+    destructorParametersMallocError:
+        throw(destructorsCheckError);
+    }
+    
+    free(pTypeConstruction);
+    return true;
+    
+destructorsCheckError:
+constructorsCheckError:
+typeArgumentsCreateError:
+    free(pTypeConstruction);
+typeArgumentsMallocError:
+    fprintf(stderr, "Ill-typed signature found in type %s\n", symbol_getString(typeConstructor.name).pData);
+    return false;
+}
+bool module_checkRule(
+    Module module, Construction* pTypeConstruction, size_t destructorIndex, size_t constructorIndex
+) {
+    Constructor typeConstructor = module.pMatrices[0].pConstructors[pTypeConstruction->index];
+    Matrix matrix = module.pMatrices[pTypeConstruction->index];
+    Constructor constructor = matrix.pConstructors[constructorIndex];
+    Destructor destructor = matrix.pDestructors[destructorIndex];
+    size_t typeParameterCount = typeConstructor.parameterCount;
+    size_t constructorParameterCount = constructor.parameterCount;
+    
+    Construction* pValueConstruction = malloc(
+        sizeof(Construction) + constructorParameterCount * sizeof(Expression)
+    );
+    if (pValueConstruction == NULL)
+        throw(valueArgumentsMallocError);
+    Expression* pValueArguments = construction_getArguments(pValueConstruction);
+    size_t valueArgumentCount;
+    for (valueArgumentCount = 0; valueArgumentCount < constructorParameterCount; valueArgumentCount++) {
+        if (!createReferenceExpression(typeParameterCount + valueArgumentCount, &pValueArguments[valueArgumentCount]))
+            throw(valueArgumentsCreateError);
+    }
+    *pValueConstruction = (Construction) {
+        .index = constructorIndex,
+        .argumentCount = constructorParameterCount
+    };
+    pValueConstruction->hash = construction_hash(*pValueConstruction, pValueArguments);
+    
+    Substitution* pSubstitutions = malloc(
+        (typeParameterCount + 1 + destructor.parameterCount) * sizeof(Substitution)
+    );
+    if (pSubstitutions == NULL)
+        throw(substitutionsMallocError);
+    for (size_t i = 0; i < typeParameterCount; i++) {
+        pSubstitutions[i] = (Substitution) {
+            .type = typeConstructor.pParameterTypes[i],
+            .value = construction_getArguments(pTypeConstruction)[i]
+        };
+    }
+    pSubstitutions[typeParameterCount] = (Substitution) {
+        .type = {
+            .kind = CONSTRUCTION_EXPRESSION,
+            .pData = pTypeConstruction
+        },
+        .value = {
+            .kind = CONSTRUCTION_EXPRESSION,
+            .pData = pValueConstruction
+        }
+    };
+    Parameter* pParameters = malloc(
+        (typeParameterCount + constructorParameterCount + destructor.parameterCount) * sizeof(Parameter)
+    );
+    if (pParameters == NULL)
+        throw(parametersMallocError);
+    for (size_t i = 0; i < typeParameterCount; i++)
+        pParameters[i] = (Parameter) {.name = EMPTY_SYMBOL, .type = typeConstructor.pParameterTypes[i]};
+    for (size_t i = 0; i < constructorParameterCount; i++)
+        pParameters[typeParameterCount + i] = (Parameter) {.name = EMPTY_SYMBOL, .type = constructor.pParameterTypes[i]};
+    size_t destructorParameterCount;
+    for (
+        destructorParameterCount = 0;
+        destructorParameterCount < destructor.parameterCount;
+        destructorParameterCount++
+    ) {
+        Expression type;
+        if (!expression_substitute(
+            destructor.pParameterTypes[destructorParameterCount], module, pSubstitutions, &type
+        ))
+            throw(destructorParameterTypeSubstituteError);
+        Expression value;
+        if (!createReferenceExpression(
+            typeParameterCount + constructorParameterCount + destructorParameterCount, &value
+        ))
+            throw(destructorParameterValueCreateError);
+        
+        pSubstitutions[typeParameterCount + 1 + destructorParameterCount] = (Substitution) {
+            .type = type,
+            .value = value
+        };
+        pParameters[typeParameterCount + constructorParameterCount + destructorParameterCount] = (Parameter) {
+            .name = EMPTY_SYMBOL,
+            .type = type
+        };
+        continue;
+    
+    destructorParameterValueCreateError:
+    destructorParameterTypeSubstituteError:
+        throw(destructorParametersCreateError);
+    }
+    
+    Expression returnType;
+    if (!expression_substitute(destructor.returnType, module, pSubstitutions, &returnType))
+        throw(returnTypeSubstituteError);
+    if (!expression_check(
+        matrix_getRules(matrix, destructorIndex)[constructorIndex], module,
+        typeParameterCount + constructorParameterCount + destructorParameterCount, pParameters,
+        returnType
+    ))
+        throw(ruleCheckError);
+    
+    free(pParameters);
+    free(pSubstitutions);
+    free(pValueConstruction);
+    return true;
+    
+ruleCheckError:
+returnTypeSubstituteError:
+destructorParametersCreateError:
+    free(pParameters);
+parametersMallocError:
+    free(pSubstitutions);
+substitutionsMallocError:
+valueArgumentsCreateError:
+    free(pValueConstruction);
+valueArgumentsMallocError:
+    fprintf(
+        stderr, "Ill-typed case found: %s [%s.%s]\n",
+        symbol_getString(typeConstructor.name).pData, symbol_getString(constructor.name).pData,
+        symbol_getString(destructor.name).pData
+    );
+    return false;
+}
+bool module_checkRules(Module module, size_t typeIndex) {
+    Constructor typeConstructor = module.pMatrices[0].pConstructors[typeIndex];
+    Matrix matrix = module.pMatrices[typeIndex];
+    
+    Construction* pTypeConstruction = malloc(
+        sizeof(Construction) + typeConstructor.parameterCount * sizeof(Expression)
+    );
+    if (pTypeConstruction == NULL)
+        throw(typeArgumentsMallocError);
+    Expression* pTypeArguments = construction_getArguments(pTypeConstruction);
+    size_t typeArgumentCount;
+    for (typeArgumentCount = 0; typeArgumentCount < typeConstructor.parameterCount; typeArgumentCount++) {
+        if (!createReferenceExpression(typeArgumentCount, &pTypeArguments[typeArgumentCount]))
+            throw(typeArgumentsCreateError);
+    }
+    *pTypeConstruction = (Construction) {
+        .index = typeIndex,
+        .argumentCount = typeArgumentCount
+    };
+    pTypeConstruction->hash = construction_hash(*pTypeConstruction, pTypeArguments);
+    
+    for (size_t i = 0; i < matrix.destructorCount; i++) {
+        Expression* pRules = matrix_getRules(matrix, i);
+        for (size_t j = 0; j < matrix.constructorCount; j++) {
+            if (pRules[j].kind == UNSPECIFIED_EXPRESSION)
+                continue;
+            if (!module_checkRule(module, pTypeConstruction, i, j))
+                throw(ruleCheckError);
+        }
+    }
+    
+    free(pTypeConstruction);
+    return true;
+    
+ruleCheckError:
+typeArgumentsCreateError:
+    free(pTypeConstruction);
+typeArgumentsMallocError:
+    return false;
+}
+bool module_check(Module module) {
+    for (size_t i = 0; i < module.matrixCount; i++) {
+        if (!module_checkSignatures(module, i))
+            throw(signaturesCheckError);
+    }
+    for (size_t i = 0; i < module.matrixCount; i++) {
+        if (!module_checkRules(module, i))
+            throw(rulesCheckError);
+    }
+    return true;
+    
+rulesCheckError:
+signaturesCheckError:
+    return false;
+}
+uint64_t image_getLayout(void) {
+    uint64_t byteOrder = 0;
+    memcpy(&byteOrder, "\x01\x02\x03\x04\x05\x06\x07\x08", sizeof(uint64_t));
+    return byteOrder ^ (
+        (uint64_t) sizeof(size_t) | (uint64_t) sizeof(Expression) << 8 | (uint64_t) sizeof(Construction) << 16
+        | (uint64_t) sizeof(Destruction) << 24 | (uint64_t) sizeof(Constructor) << 32
+        | (uint64_t) sizeof(Destructor) << 40 | (uint64_t) sizeof(Matrix) << 48
+    );
+}
+uint64_t image_checksum(char const* pData, size_t length) {
+    uint64_t hash = 0xCBF29CE484222325u;
+    for (size_t i = 0; i + sizeof(uint64_t) <= length; i += sizeof(uint64_t)) {
+        uint64_t word;
+        memcpy(&word, &pData[i], sizeof(uint64_t));
+        hash = (hash ^ word) * 0x100000001B3u;
+    }
+    return hash;
+}
+bool imageWriter_reserve(ImageWriter* pWriter, size_t size, size_t* pOffset) {
+    size_t offset = (pWriter->length + 7) & ~(size_t) 7;
+    size_t length = offset + ((size + 7) & ~(size_t) 7);
+    if (length > pWriter->capacity) {
+        size_t capacity = pWriter->capacity == 0 ? 4096 : pWriter->capacity;
+        while (capacity < length)
+            capacity *= 2;
+        char* pNewData = realloc(pWriter->pData, capacity);
+        if (pNewData == NULL)
+            throw(dataReallocError);
+        pWriter->pData = pNewData;
+        pWriter->capacity = capacity;
+    }
+    memset(&pWriter->pData[pWriter->length], 0, length - pWriter->length);
+    pWriter->length = length;
+    *pOffset = offset;
+    return true;
+    
+dataReallocError:
+    return false;
+}
+bool imageWriter_write(ImageWriter* pWriter, void const* pData, size_t size, size_t* pOffset) {
+    if (size == 0) {
+        *pOffset = 0;
+        return true;
+    }
+    size_t offset;
+    if (!imageWriter_reserve(pWriter, size, &offset))
+        throw(reserveError);
+    memcpy(&pWriter->pData[offset], pData, size);
+    *pOffset = offset;
+    return true;
+    
+reserveError:
+    return false;
+}
+bool imageWriter_writeExpression(ImageWriter* pWriter, Expression expression, Expression* pResult) {
+    if (expression.kind == CONSTRUCTION_EXPRESSION) {
+        Construction* pData = expression.pData;
+        size_t size = sizeof(Construction) + pData->argumentCount * sizeof(Expression);
+        Construction* pConstruction = malloc(size);
+        if (pConstruction == NULL)
+            throw(constructionMallocError);
+        *pConstruction = *pData;
+        for (size_t i = 0; i < pData->argumentCount; i++) {
+            Expression* pArgument = &construction_getArguments(pConstruction)[i];
+            if (!imageWriter_writeExpression(pWriter, construction_getArguments(pData)[i], pArgument))
+                throw(constructionArgumentWriteError);
+        }
+        size_t offset;
+        if (!imageWriter_write(pWriter, pConstruction, size, &offset))
+            throw(constructionWriteError);
+        free(pConstruction);
+        
+        *pResult = (Expression) {
+            .kind = CONSTRUCTION_EXPRESSION,
+            .pData = (void*) (uintptr_t) offset
+        };
+        return true;
+    
+    constructionWriteError:
+    constructionArgumentWriteError:
+        free(pConstruction);
+    constructionMallocError:
+        return false;
+    }
+    if (expression.kind == EVALUATION_EXPRESSION) {
+        Evaluation* pData = expression.pData;
+        Evaluation evaluation;
+        if (!imageWriter_writeEvaluation(pWriter, *pData, &evaluation))
+            throw(evaluationWriteError);
+        size_t offset;
+        if (!imageWriter_write(pWriter, &evaluation, sizeof(Evaluation), &offset))
+            throw(evaluationNodeWriteError);
+        
+        *pResult = (Expression) {
+            .kind = EVALUATION_EXPRESSION,
+            .pData = (void*) (uintptr_t) offset
+        };
+        return true;
+    
+    evaluationNodeWriteError:
+    evaluationWriteError:
+        return false;
+    }
+    *pResult = (Expression) {
+        .kind = UNSPECIFIED_EXPRESSION,
+        .pData = NULL
+    };
+    return true;
+}
+bool imageWriter_writeEvaluation(ImageWriter* pWriter, Evaluation evaluation, Evaluation* pResult) {
+    if (evaluation.kind == REFERENCE_EVALUATION) {
+        size_t offset;
+        if (!imageWriter_write(pWriter, evaluation.pData, sizeof(size_t), &offset))
+            throw(referenceWriteError);
+        
+        *pResult = (Evaluation) {
+            .kind = REFERENCE_EVALUATION,
+            .pData = (void*) (uintptr_t) offset
+        };
+        return true;
+    
+    referenceWriteError:
+        return false;
+    }
+    if (evaluation.kind == DESTRUCTION_EVALUATION) {
+        Destruction* pData = evaluation.pData;
+        Destruction destruction = *pData;
+        if (!imageWriter_writeEvaluation(pWriter, pData->caller, &destruction.caller))
+            throw(destructionCallerWriteError);
+        size_t argumentsOffset;
+        if (!imageWriter_writeExpressions(pWriter, pData->argumentCount, pData->pArguments, &argumentsOffset))
+            throw(destructionArgumentsWriteError);
+        destruction.pArguments = (Expression*) (uintptr_t) argumentsOffset;
+        size_t offset;
+        if (!imageWriter_write(pWriter, &destruction, sizeof(Destruction), &offset))
+            throw(destructionWriteError);
+        
+        *pResult = (Evaluation) {
+            .kind = DESTRUCTION_EVALUATION,
+            .pData = (void*) (uintptr_t) offset
+        };
+        return true;
+    
+    destructionWriteError:
+    destructionArgumentsWriteError:
+    destructionCallerWriteError:
+        return false;
+    }
+    return false;
+}
+bool imageWriter_writeExpressions(
+    ImageWriter* pWriter, size_t count, Expression const* pExpressions, size_t* pOffset
+) {
+    Expression* pResults = malloc(count * sizeof(Expression));
+    if (pResults == NULL)
+        throw(resultsMallocError);
+    for (size_t i = 0; i < count; i++) {
+        if (!imageWriter_writeExpression(pWriter, pExpressions[i], &pResults[i]))
+            throw(expressionWriteError);
+    }
+    if (!imageWriter_write(pWriter, pResults, count * sizeof(Expression), pOffset))
+        throw(expressionsWriteError);
+    free(pResults);
+    return true;
+    
+expressionsWriteError:
+expressionWriteError:
+    free(pResults);
+resultsMallocError:
+    return false;
+}
+bool image_relocate(char* pImage, size_t limit, size_t count, size_t size, void** ppData) {
+    size_t offset = (uintptr_t) *ppData;
+    if (count == 0) {
+        *ppData = NULL;
+        return true;
+    }
+    if (offset < sizeof(ImageHeader) || offset % 8 != 0 || offset > limit)
+        throw(offsetError);
+    if (count > (limit - offset) / size)
+        throw(sizeError);
+    *ppData = &pImage[offset];
+    return true;
+    
+sizeError:
+offsetError:
+    return false;
+}
+bool image_relocateExpression(char* pImage, size_t limit, bool isRule, Expression* pExpression) {
+    if (pExpression->kind == CONSTRUCTION_EXPRESSION) {
+        if (!image_relocate(pImage, limit, 1, sizeof(Construction), &pExpression->pData))
+            throw(constructionRelocateError);
+        Construction* pData = pExpression->pData;
+        size_t offset = (char*) pData - pImage;
+        if (pData->argumentCount > (limit - offset - sizeof(Construction)) / sizeof(Expression))
+            throw(constructionArgumentCountError);
+        Expression* pArguments = construction_getArguments(pData);
+        for (size_t i = 0; i < pData->argumentCount; i++) {
+            if (!image_relocateExpression(pImage, offset, false, &pArguments[i]))
+                throw(constructionArgumentRelocateError);
+        }
+        pData->hash = construction_hash(*pData, pArguments);
+        pData->isClosed = construction_isClosed(*pData, pArguments);
+        return true;
+    
+    constructionArgumentRelocateError:
+    constructionArgumentCountError:
+    constructionRelocateError:
+        return false;
+    }
+    if (pExpression->kind == EVALUATION_EXPRESSION) {
+        if (!image_relocate(pImage, limit, 1, sizeof(Evaluation), &pExpression->pData))
+            throw(evaluationRelocateError);
+        Evaluation* pData = pExpression->pData;
+        if (!image_relocateEvaluation(pImage, (char*) pData - pImage, pData))
+            throw(evaluationNodeRelocateError);
+        return true;
+    
+    evaluationNodeRelocateError:
+    evaluationRelocateError:
+        return false;
+    }
+    if (pExpression->kind == UNSPECIFIED_EXPRESSION && isRule && pExpression->pData == NULL)
+        return true;
+    throw(expressionKindError);
+    
+expressionKindError:
+    return false;
+}
+bool image_relocateEvaluation(char* pImage, size_t limit, Evaluation* pEvaluation) {
+    if (pEvaluation->kind == REFERENCE_EVALUATION) {
+        if (!image_relocate(pImage, limit, 1, sizeof(size_t), &pEvaluation->pData))
+            throw(referenceRelocateError);
+        return true;
+    
+    referenceRelocateError:
+        return false;
+    }
+    if (pEvaluation->kind == DESTRUCTION_EVALUATION) {
+        if (!image_relocate(pImage, limit, 1, sizeof(Destruction), &pEvaluation->pData))
+            throw(destructionRelocateError);
+        Destruction* pData = pEvaluation->pData;
+        size_t offset = (char*) pData - pImage;
+        if (!image_relocateEvaluation(pImage, offset, &pData->caller))
+            throw(destructionCallerRelocateError);
+        if (!image_relocateExpressions(pImage, offset, pData->argumentCount, false, &pData->pArguments))
+            throw(destructionArgumentsRelocateError);
+        pData->hash = destruction_hash(*pData);
+        return true;
+    
+    destructionArgumentsRelocateError:
+    destructionCallerRelocateError:
+    destructionRelocateError:
+        return false;
+    }
+    throw(evaluationKindError);
+    
+evaluationKindError:
+    return false;
+}
+bool image_relocateExpressions(char* pImage, size_t limit, size_t count, bool isRule, Expression** ppExpressions) {
+    if (!image_relocate(pImage, limit, count, sizeof(Expression), (void**) ppExpressions))
+        throw(expressionsRelocateError);
+    if (count == 0)
+        return true;
+    size_t offset = (char*) *ppExpressions - pImage;
+    for (size_t i = 0; i < count; i++) {
+        if (!image_relocateExpression(pImage, offset, isRule, &(*ppExpressions)[i]))
+            throw(expressionRelocateError);
+    }
+    return true;
+    
+expressionRelocateError:
+expressionsRelocateError:
+    return false;
+}
+bool module_saveImage(Module module, char const* pFileName) {
+    ImageWriter writer = {
+        .length = 0,
+        .capacity = 0,
+        .pData = NULL
+    };
+    size_t headerOffset;
+    if (!imageWriter_reserve(&writer, sizeof(ImageHeader), &headerOffset))
+        throw(headerReserveError);
+    
+    ImageString* pStrings = malloc(symbols.symbolCount * sizeof(ImageString));
+    if (pStrings == NULL)
+        throw(stringsMallocError);
+    for (Symbol i = 0; i < symbols.symbolCount; i++) {
+        String string = symbols.pStrings[i];
+        size_t offset;
+        if (!imageWriter_write(&writer, string.pData, string.length + 1, &offset))
+            throw(stringWriteError);
+        pStrings[i] = (ImageString) {
+            .offset = offset,
+            .length = string.length
+        };
+    }
+    size_t symbolsOffset;
+    if (!imageWriter_write(&writer, pStrings, symbols.symbolCount * sizeof(ImageString), &symbolsOffset))
+        throw(stringWriteError);
+    
+    Matrix* pMatrices = malloc(module.matrixCount * sizeof(Matrix));
+    if (pMatrices == NULL)
+        throw(matricesMallocError);
+    for (size_t i = 0; i < module.matrixCount; i++) {
+        Matrix matrix = module.pMatrices[i];
+        
+        Constructor* pConstructors = malloc(matrix.constructorCount * sizeof(Constructor));
+        if (pConstructors == NULL)
+            throw(constructorsMallocError);
+        for (size_t j = 0; j < matrix.constructorCount; j++) {
+            Constructor constructor = matrix.pConstructors[j];
+            size_t parameterTypesOffset;
+            if (!imageWriter_writeExpressions(
+                &writer, constructor.parameterCount, constructor.pParameterTypes, &parameterTypesOffset
+            ))
+                throw(constructorWriteError);
+            constructor.pParameterTypes = (Expression*) (uintptr_t) parameterTypesOffset;
+            pConstructors[j] = constructor;
+        }
+        size_t constructorsOffset;
+        if (!imageWriter_write(&writer, pConstructors, matrix.constructorCount * sizeof(Constructor), &constructorsOffset))
+            throw(constructorWriteError);
+        free(pConstructors);
+        
+        Destructor* pDestructors = malloc(matrix.destructorCount * sizeof(Destructor));
+        if (pDestructors == NULL)
+            throw(destructorsMallocError);
+        for (size_t j = 0; j < matrix.destructorCount; j++) {
+            Destructor destructor = matrix.pDestructors[j];
+            size_t parameterTypesOffset;
+            if (!imageWriter_writeExpressions(
+                &writer, destructor.parameterCount, destructor.pParameterTypes, &parameterTypesOffset
+            ))
+                throw(destructorWriteError);
+            if (!imageWriter_writeExpression(&writer, destructor.returnType, &destructor.returnType))
+                throw(destructorWriteError);
+            destructor.pParameterTypes = (Expression*) (uintptr_t) parameterTypesOffset;
+            pDestructors[j] = destructor;
+        }
+        size_t destructorsOffset;
+        if (!imageWriter_write(&writer, pDestructors, matrix.destructorCount * sizeof(Destructor), &destructorsOffset))
+            throw(destructorWriteError);
+        free(pDestructors);
+        
+        Expression* pRules = malloc(matrix.destructorCount * matrix.constructorCount * sizeof(Expression));
+        if (pRules == NULL)
+            throw(rulesMallocError);
+        for (size_t j = 0; j < matrix.destructorCount; j++)
+            memcpy(&pRules[j * matrix.constructorCount], matrix_getRules(matrix, j), matrix.constructorCount * sizeof(Expression));
+        size_t rulesOffset;
+        if (!imageWriter_writeExpressions(&writer, matrix.destructorCount * matrix.constructorCount, pRules, &rulesOffset))
+            throw(rulesWriteError);
+        free(pRules);
+        
+        pMatrices[i] = (Matrix) {
+            .constructorCount = matrix.constructorCount,
+            .pConstructors = (Constructor*) (uintptr_t) constructorsOffset,
+            .destructorCount = matrix.destructorCount,
+            .pDestructors = (Destructor*) (uintptr_t) destructorsOffset,
+            .ruleRowCapacity = matrix.destructorCount,
+            .ruleColumnCapacity = matrix.constructorCount,
+            .pRules = (Expression*) (uintptr_t) rulesOffset,
+            .constructorIndex = EMPTY_NAME_INDEX,
+            .destructorIndex = EMPTY_NAME_INDEX
+        };
+        continue;
+    
+    rulesWriteError:
+        free(pRules);
+    rulesMallocError:
+        throw(matrixWriteError);
+    destructorWriteError:
+        free(pDestructors);
+    destructorsMallocError:
+        throw(matrixWriteError);
+    constructorWriteError:
+        free(pConstructors);
+    constructorsMallocError:
+        throw(matrixWriteError);
+    }
+    size_t matricesOffset;
+    if (!imageWriter_write(&writer, pMatrices, module.matrixCount * sizeof(Matrix), &matricesOffset))
+        throw(matrixWriteError);
+    
+    ImageHeader header = {
+        .version = IMAGE_VERSION,
+        .layout = image_getLayout(),
+        .length = writer.length,
+        .checksum = image_checksum(&writer.pData[sizeof(ImageHeader)], writer.length - sizeof(ImageHeader)),
+        .symbolCount = symbols.symbolCount,
+        .symbolsOffset = symbolsOffset,
+        .matrixCount = module.matrixCount,
+        .matricesOffset = matricesOffset
+    };
+    memcpy(header.pMagic, IMAGE_MAGIC, sizeof(IMAGE_MAGIC));
+    memcpy(&writer.pData[headerOffset], &header, sizeof(ImageHeader));
+    
+    FILE* pFile = fopen(pFileName, "wb");
+    if (pFile == NULL)
+        throw(fileOpenError);
+    if (fwrite(writer.pData, 1, writer.length, pFile) != writer.length)
+        throw(fileWriteError);
+    if (fclose(pFile) == EOF)
+        throw(fileCloseError);
+    
+    free(pMatrices);
+    free(pStrings);
+    free(writer.pData);
+    return true;
+    
+fileWriteError:
+    fclose(pFile);
+fileCloseError:
+    remove(pFileName);
+fileOpenError:
+matrixWriteError:
+    free(pMatrices);
+matricesMallocError:
+stringWriteError:
+    free(pStrings);
+stringsMallocError:
+headerReserveError:
+    free(writer.pData);
+    fprintf(stderr, "Unable to write image %s\n", pFileName);
+    return false;
+}
+bool image_relocateModule(char* pImage, ImageHeader header, Symbol const* pSymbolMap) {
+    Matrix* pMatrices = (Matrix*) (uintptr_t) header.matricesOffset;
+    if (!image_relocate(pImage, header.length, header.matrixCount, sizeof(Matrix), (void**) &pMatrices))
+        throw(matricesRelocateError);
+    if (header.matrixCount == 0)
+        throw(matricesRelocateError);
+    size_t matricesOffset = (char*) pMatrices - pImage;
+    
+    for (size_t i = 0; i < header.matrixCount; i++) {
+        Matrix* pMatrix = &pMatrices[i];
+        if (!image_relocate(
+            pImage, matricesOffset, pMatrix->constructorCount, sizeof(Constructor), (void**) &pMatrix->pConstructors
+        ))
+            throw(matrixRelocateError);
+        size_t constructorsOffset = (char*) pMatrix->pConstructors - pImage;
+        for (size_t j = 0; j < pMatrix->constructorCount; j++) {
+            Constructor* pConstructor = &pMatrix->pConstructors[j];
+            if (pConstructor->name >= header.symbolCount)
+                throw(matrixRelocateError);
+            pConstructor->name = pSymbolMap[pConstructor->name];
+            if (!image_relocateExpressions(
+                pImage, constructorsOffset, pConstructor->parameterCount, false, &pConstructor->pParameterTypes
+            ))
+                throw(matrixRelocateError);
+        }
+        
+        if (!image_relocate(
+            pImage, matricesOffset, pMatrix->destructorCount, sizeof(Destructor), (void**) &pMatrix->pDestructors
+        ))
+            throw(matrixRelocateError);
+        size_t destructorsOffset = (char*) pMatrix->pDestructors - pImage;
+        for (size_t j = 0; j < pMatrix->destructorCount; j++) {
+            Destructor* pDestructor = &pMatrix->pDestructors[j];
+            if (pDestructor->name >= header.symbolCount)
+                throw(matrixRelocateError);
+            pDestructor->name = pSymbolMap[pDestructor->name];
+            if (!image_relocateExpressions(
+                pImage, destructorsOffset, pDestructor->parameterCount, false, &pDestructor->pParameterTypes
+            ))
+                throw(matrixRelocateError);
+            if (!image_relocateExpression(pImage, destructorsOffset, false, &pDestructor->returnType))
+                throw(matrixRelocateError);
+        }
+        
+        if (pMatrix->ruleRowCapacity != pMatrix->destructorCount || pMatrix->ruleColumnCapacity != pMatrix->constructorCount)
+            throw(matrixRelocateError);
+        if (!image_relocateExpressions(
+            pImage, matricesOffset, pMatrix->destructorCount * pMatrix->constructorCount, true, &pMatrix->pRules
+        ))
+            throw(matrixRelocateError);
+    }
+    if (pMatrices[0].constructorCount != header.matrixCount)
+        throw(matrixCountError);
+    return true;
+    
+matrixCountError:
+matrixRelocateError:
+matricesRelocateError:
+    return false;
+}
+bool createModuleFromImage(char const* pFileName, bool isTrusted, Module* pModule) {
+    int fileDescriptor = open(pFileName, O_RDONLY);
+    if (fileDescriptor == -1)
+        throw(fileOpenError);
+    struct stat fileStat;
+    if (fstat(fileDescriptor, &fileStat) == -1)
+        throw(fileStatError);
+    size_t length = (size_t) fileStat.st_size;
+    if (length < sizeof(ImageHeader))
+        throw(fileStatError);
+    char* pImage = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE, fileDescriptor, 0);
+    if (pImage == MAP_FAILED)
+        throw(fileMapError);
+    close(fileDescriptor);
+    
+    ImageHeader header;
+    memcpy(&header, pImage, sizeof(ImageHeader));
+    if (memcmp(header.pMagic, IMAGE_MAGIC, sizeof(IMAGE_MAGIC)) != 0)
+        throw(headerError);
+    if (header.version != IMAGE_VERSION || header.layout != image_getLayout() || header.length != length)
+        throw(headerError);
+    if (header.checksum != image_checksum(&pImage[sizeof(ImageHeader)], length - sizeof(ImageHeader)))
+        throw(checksumError);
+    
+    ImageString* pStrings = (ImageString*) (uintptr_t) header.symbolsOffset;
+    if (!image_relocate(pImage, length, header.symbolCount, sizeof(ImageString), (void**) &pStrings))
+        throw(symbolsRelocateError);
+    Symbol* pSymbolMap = malloc(header.symbolCount * sizeof(Symbol));
+    if (pSymbolMap == NULL)
+        throw(symbolMapMallocError);
+    for (size_t i = 0; i < header.symbolCount; i++) {
+        ImageString string = pStrings[i];
+        if (string.offset > length || string.length >= length - string.offset)
+            throw(symbolInternError);
+        if (!symbol_intern((String) {.length = string.length, .pData = &pImage[string.offset]}, &pSymbolMap[i]))
+            throw(symbolInternError);
+    }
+    
+    if (!image_relocateModule(pImage, header, pSymbolMap))
+        throw(moduleRelocateError);
+    Matrix* pImageMatrices = (Matrix*) &pImage[header.matricesOffset];
+    
+    Matrix* pMatrices = calloc(header.matrixCount, sizeof(Matrix));
+    if (pMatrices == NULL)
+        throw(matricesCallocError);
+    Module module = {
+        .matrixCount = header.matrixCount,
+        .matrixCapacity = header.matrixCount,
+        .pMatrices = pMatrices,
+        .operationCount = 0,
+        .operationCapacity = 0,
+        .pOperations = NULL,
+        .renameCount = 0,
+        .renameCapacity = 0,
+        .pRenames = NULL,
+        .fingerprint = hash_combine(EMPTY_MODULE_FINGERPRINT, header.checksum),
+        .region = EMPTY_REGION
+    };
+    module.region.pImage = pImage;
+    module.region.imageLength = length;
+    for (size_t i = 0; i < header.matrixCount; i++) {
+        Matrix imageMatrix = pImageMatrices[i];
+        Matrix* pMatrix = &pMatrices[i];
+        
+        Constructor* pConstructors = malloc(imageMatrix.constructorCount * sizeof(Constructor));
+        if (pConstructors == NULL)
+            throw(matrixCopyError);
+        memcpy(pConstructors, imageMatrix.pConstructors, imageMatrix.constructorCount * sizeof(Constructor));
+        pMatrix->pConstructors = pConstructors;
+        pMatrix->constructorCount = imageMatrix.constructorCount;
+        pMatrix->constructorCapacity = imageMatrix.constructorCount;
+        
+        Destructor* pDestructors = malloc(imageMatrix.destructorCount * sizeof(Destructor));
+        if (pDestructors == NULL)
+            throw(matrixCopyError);
+        pMatrix->pDestructors = pDestructors;
+        pMatrix->destructorCapacity = imageMatrix.destructorCount;
+        if (imageMatrix.destructorCount > 0 && !matrix_reserveRules(pMatrix, imageMatrix.destructorCount, imageMatrix.constructorCount))
+            throw(matrixCopyError);
+        for (size_t j = 0; j < imageMatrix.destructorCount; j++) {
+            Destructor destructor = imageMatrix.pDestructors[j];
+            memcpy(
+                matrix_getRules(*pMatrix, j), matrix_getRules(imageMatrix, j),
+                imageMatrix.constructorCount * sizeof(Expression)
+            );
+            pDestructors[j] = destructor;
+            pMatrix->destructorCount++;
+        }
+        
+        if (!nameIndex_rebuild(
+            &pMatrix->constructorIndex, &pMatrix->pConstructors->name, sizeof(Constructor), pMatrix->constructorCount
+        ))
+            throw(matrixCopyError);
+        if (!nameIndex_rebuild(
+            &pMatrix->destructorIndex, &pMatrix->pDestructors->name, sizeof(Destructor), pMatrix->destructorCount
+        ))
+            throw(matrixCopyError);
+    }
+    if (!isTrusted && !module_check(module))
+        throw(moduleCheckError);
+    
+    *pModule = module;
+    free(pSymbolMap);
+    return true;
+    
+moduleCheckError:
+matrixCopyError:
+    free(pSymbolMap);
+    destroyModule(module);
+    fprintf(stderr, "Unable to load image %s\n", pFileName);
+    return false;
+    
+matricesCallocError:
+moduleRelocateError:
+symbolInternError:
+    free(pSymbolMap);
+symbolMapMallocError:
+symbolsRelocateError:
+checksumError:
+headerError:
+    munmap(pImage, length);
+    fprintf(stderr, "Unable to load image %s\n", pFileName);
+    return false;
+    
+fileMapError:
+fileStatError:
+    close(fileDescriptor);
+fileOpenError:
+    fprintf(stderr, "Unable to load image %s\n", pFileName);
+    return false;
+}
+uint64_t native_getLayout(void) {
+    return NATIVE_VERSION << 48 | (uint64_t) sizeof(NativeBinding) << 40 | (uint64_t) sizeof(NativeApi) << 32
+        | (uint64_t) offsetof(Construction, hash) << 16 | (uint64_t) sizeof(Construction) << 8
+        | (uint64_t) sizeof(Expression);
+}
+uint64_t native_hash(Module module, size_t typeIndex, size_t destructorIndex) {
+    uint64_t hash = hash_combine(NATIVE_VERSION, typeIndex);
+    hash = hash_combine(hash, destructorIndex);
+    hash = hash_combine(hash, module.pMatrices[0].pConstructors[typeIndex].parameterCount);
+    Matrix matrix = module.pMatrices[typeIndex];
+    hash = hash_combine(hash, matrix.constructorCount);
+    for (size_t i = 0; i < matrix.constructorCount; i++) {
+        Constructor constructor = matrix.pConstructors[i];
+        hash = hash_combine(hash, constructor.parameterCount);
+        for (size_t j = 0; j < constructor.parameterCount; j++)
+            hash = hash_combine(hash, expression_hash(constructor.pParameterTypes[j]));
+    }
+    Destructor destructor = matrix.pDestructors[destructorIndex];
+    hash = hash_combine(hash, destructor.parameterCount);
+    for (size_t i = 0; i < destructor.parameterCount; i++)
+        hash = hash_combine(hash, expression_hash(destructor.pParameterTypes[i]));
+    hash = hash_combine(hash, expression_hash(destructor.returnType));
+    Expression* pRules = matrix_getRules(matrix, destructorIndex);
+    for (size_t i = 0; i < matrix.constructorCount; i++)
+        hash = hash_combine(hash, expression_hash(pRules[i]));
+    return hash;
+}
+bool createNativeLibrary(char const* pFileName, NativeLibrary* pLibrary) {
+    void* pHandle = dlopen(pFileName, RTLD_NOW | RTLD_LOCAL);
+    if (pHandle == NULL)
+        throw(libraryOpenError);
+    NativeBind bind = (NativeBind) dlsym(pHandle, "native_bind");
+    if (bind == NULL)
+        throw(bindFindError);
+    
+    *pLibrary = (NativeLibrary) {
+        .pHandle = pHandle,
+        .api = {
+            .layout = native_getLayout(),
+            .construct = native_construct,
+            .destruct = native_destruct,
+            .pIsValid = NULL,
+            .ppStackLimit = &pLibrary->pStackLimit
+        },
+        .bindingCount = 0,
+        .pBindings = NULL,
+        .pIsValid = NULL,
+        .slotCapacity = 0,
+        .pSlots = NULL,
+        .fingerprint = 0,
+        .isRunning = false,
+        .pStackLimit = native_getStackLimit(),
+        .pStackBase = NULL
+    };
+    if (!bind(&pLibrary->api, &pLibrary->bindingCount, &pLibrary->pBindings))
+        throw(bindError);
+    
+    pLibrary->pIsValid = calloc(pLibrary->bindingCount + 1, sizeof(bool));
+    if (pLibrary->pIsValid == NULL)
+        throw(isValidCallocError);
+    pLibrary->api.pIsValid = pLibrary->pIsValid;
+    size_t slotCapacity = 1;
+    while (slotCapacity < 2 * pLibrary->bindingCount)
+        slotCapacity *= 2;
+    pLibrary->pSlots = malloc(slotCapacity * sizeof(size_t));
+    if (pLibrary->pSlots == NULL)
+        throw(slotsMallocError);
+    pLibrary->slotCapacity = slotCapacity;
+    for (size_t i = 0; i < slotCapacity; i++)
+        pLibrary->pSlots[i] = NO_NATIVE_BINDING;
+    for (size_t i = 0; i < pLibrary->bindingCount; i++) {
+        NativeBinding binding = pLibrary->pBindings[i];
+        if (native_find(binding.typeIndex, binding.destructorIndex) != NO_NATIVE_BINDING)
+            continue;
+        size_t j = hash_combine(hash_combine(0, binding.typeIndex), binding.destructorIndex) & (slotCapacity - 1);
+        while (pLibrary->pSlots[j] != NO_NATIVE_BINDING)
+            j = (j + 1) & (slotCapacity - 1);
+        pLibrary->pSlots[j] = i;
+    }
+    return true;
+    
+slotsMallocError:
+    free(pLibrary->pIsValid);
+isValidCallocError:
+bindError:
+bindFindError:
+    fprintf(stderr, "Could not load native code %s: %s\n", pFileName, dlerror() ?: "incompatible library");
+    dlclose(pHandle);
+    return false;
+    
+libraryOpenError:
+    fprintf(stderr, "Could not load native code %s: %s\n", pFileName, dlerror());
+    return false;
+}
+char const* native_getStackLimit(void) {
+    char marker;
+    uintptr_t stackBudget = NATIVE_STACK_BUDGET_LIMIT;
+    struct rlimit stackLimit;
+    if (getrlimit(RLIMIT_STACK, &stackLimit) == 0 && stackLimit.rlim_cur != RLIM_INFINITY
+        && stackLimit.rlim_cur / 4 * 3 < stackBudget)
+        stackBudget = stackLimit.rlim_cur / 4 * 3;
+    return (char const*) ((uintptr_t) &marker > stackBudget ? (uintptr_t) &marker - stackBudget : 0);
+}
+void destroyNativeLibrary(NativeLibrary library) {
+    if (library.pHandle == NULL)
+        return;
+    free(library.pSlots);
+    free(library.pIsValid);
+    dlclose(library.pHandle);
+}
+size_t native_find(size_t typeIndex, size_t destructorIndex) {
+    if (native.slotCapacity == 0)
+        return NO_NATIVE_BINDING;
+    size_t i = hash_combine(hash_combine(0, typeIndex), destructorIndex) & (native.slotCapacity - 1);
+    for (; native.pSlots[i] != NO_NATIVE_BINDING; i = (i + 1) & (native.slotCapacity - 1)) {
+        NativeBinding binding = native.pBindings[native.pSlots[i]];
+        if (binding.typeIndex == typeIndex && binding.destructorIndex == destructorIndex)
+            return native.pSlots[i];
+    }
+    return NO_NATIVE_BINDING;
+}
+void native_validate(Module module) {
+    for (size_t i = 0; i < native.bindingCount; i++) {
+        NativeBinding binding = native.pBindings[i];
+        native.pIsValid[i] = binding.typeIndex > 0 && binding.typeIndex < module.matrixCount
+            && binding.typeIndex < module.pMatrices[0].constructorCount
+            && binding.destructorIndex < module.pMatrices[binding.typeIndex].destructorCount
+            && native_hash(module, binding.typeIndex, binding.destructorIndex) == binding.hash;
+    }
+    native.fingerprint = module.fingerprint;
+}
+bool native_apply(
+    Module module, size_t typeIndex, size_t index, Expression caller, Expression const* pArguments,
+    bool* pIsApplied, Expression* pValue
+) {
+    *pIsApplied = false;
+    if (native.bindingCount == 0 || native.isRunning || evaluator.isLazy || evaluator.frameLimit != SIZE_MAX)
+        return true;
+    if (native.fingerprint != module.fingerprint)
+        native_validate(module);
+    size_t bindingIndex = native_find(typeIndex, index);
+    if (bindingIndex == NO_NATIVE_BINDING || !native.pIsValid[bindingIndex])
+        return true;
+    
+    native.module = module;
+    native.isRunning = true;
+    native.pStackBase = __builtin_frame_address(0);
+    NativeStatus status = native.pBindings[bindingIndex].function(caller, pArguments, pValue);
+    native.isRunning = false;
+    native.pStackBase = NULL;
+    if (status == NATIVE_FAILED)
+        throw(functionError);
+    *pIsApplied = status == NATIVE_DONE;
+    return true;
+    
+functionError:
+    return false;
+}
+bool native_construct(size_t index, size_t argumentCount, Expression const* pArguments, Expression* pResult) {
+    if (!collector_poll())
+        return false;
+    return createConstructionExpression((Construction) {
+        .index = (uint32_t) index,
+        .argumentCount = (uint32_t) argumentCount
+    }, pArguments, pResult);
+}
+bool native_destruct(
+    size_t typeIndex, size_t index, Expression caller, Expression const* pArguments, Expression* pResult
+) {
+    Expression type;
+    if (!createConstructionExpression((Construction) {
+        .index = (uint32_t) typeIndex,
+        .argumentCount = 0
+    }, NULL, &type))
+        throw(typeCreateError);
+    Substitution result;
+    if (!substitution_destruct((Substitution) {
+        .type = type,
+        .value = caller
+    }, native.module, index, pArguments, false, &result))
+        throw(destructError);
+    *pResult = result.value;
+    return true;
+    
+destructError:
+typeCreateError:
+    return false;
+}
+bool native_getType(Module module, Expression type, size_t* pTypeIndex) {
+    if (type.kind != CONSTRUCTION_EXPRESSION)
+        return false;
+    Construction* pData = type.pData;
+    if (pData->argumentCount > 0 || pData->index == 0 || pData->index >= module.matrixCount)
+        return false;
+    *pTypeIndex = pData->index;
+    return true;
+}
+bool native_hasEligibleSignature(Module module, size_t typeIndex, size_t destructorIndex) {
+    if (typeIndex == 0 || module.pMatrices[0].pConstructors[typeIndex].parameterCount > 0)
+        return false;
+    size_t parameterTypeIndex;
+    Matrix matrix = module.pMatrices[typeIndex];
+    for (size_t i = 0; i < matrix.constructorCount; i++) {
+        Constructor constructor = matrix.pConstructors[i];
+        for (size_t j = 0; j < constructor.parameterCount; j++) {
+            if (!native_getType(module, constructor.pParameterTypes[j], &parameterTypeIndex))
+                return false;
+        }
+    }
+    Destructor destructor = matrix.pDestructors[destructorIndex];
+    for (size_t i = 0; i < destructor.parameterCount; i++) {
+        if (!native_getType(module, destructor.pParameterTypes[i], &parameterTypeIndex))
+            return false;
+    }
+    return native_getType(module, destructor.returnType, &parameterTypeIndex);
+}
+bool nativeEmitter_getSlotType(NativeEmitter const* pEmitter, size_t index, size_t* pTypeIndex) {
+    Matrix matrix = pEmitter->module.pMatrices[pEmitter->typeIndex];
+    Constructor constructor = matrix.pConstructors[pEmitter->constructorIndex];
+    if (index < constructor.parameterCount)
+        return native_getType(pEmitter->module, constructor.pParameterTypes[index], pTypeIndex);
+    index -= constructor.parameterCount;
+    Destructor destructor = matrix.pDestructors[pEmitter->destructorIndex];
+    if (index < destructor.parameterCount)
+        return native_getType(pEmitter->module, destructor.pParameterTypes[index], pTypeIndex);
+    return false;
+}
+bool nativeEmitter_checkExpression(NativeEmitter const* pEmitter, Expression expression) {
+    if (expression.kind == CONSTRUCTION_EXPRESSION) {
+        Construction* pData = expression.pData;
+        for (size_t i = 0; i < pData->argumentCount; i++) {
+            if (!nativeEmitter_checkExpression(pEmitter, construction_getArguments(pData)[i]))
+                return false;
+        }
+        return true;
+    }
+    size_t typeIndex;
+    return expression.kind == EVALUATION_EXPRESSION
+        && nativeEmitter_checkEvaluation(pEmitter, *(Evaluation*) expression.pData, &typeIndex);
+}
+bool nativeEmitter_checkEvaluation(NativeEmitter const* pEmitter, Evaluation evaluation, size_t* pTypeIndex) {
+    if (evaluation.kind == REFERENCE_EVALUATION)
+        return nativeEmitter_getSlotType(pEmitter, *(size_t*) evaluation.pData, pTypeIndex);
+    Destruction* pData = evaluation.pData;
+    size_t callerTypeIndex;
+    if (!nativeEmitter_checkEvaluation(pEmitter, pData->caller, &callerTypeIndex))
+        return false;
+    if (!pEmitter->pIsEligible[pEmitter->pOffsets[callerTypeIndex] + pData->index])
+        return false;
+    for (size_t i = 0; i < pData->argumentCount; i++) {
+        if (!nativeEmitter_checkExpression(pEmitter, pData->pArguments[i]))
+            return false;
+    }
+    Destructor destructor = pEmitter->module.pMatrices[callerTypeIndex].pDestructors[pData->index];
+    return native_getType(pEmitter->module, destructor.returnType, pTypeIndex);
+}
+bool nativeEmitter_emitExpression(NativeEmitter* pEmitter, Expression expression, bool isTail, size_t* pVariable) {
+    if (expression.kind == EVALUATION_EXPRESSION) {
+        size_t typeIndex;
+        return nativeEmitter_emitEvaluation(pEmitter, *(Evaluation*) expression.pData, isTail, &typeIndex, pVariable);
+    }
+    Construction* pData = expression.pData;
+    size_t* pVariables = malloc((pData->argumentCount + 1) * sizeof(size_t));
+    if (pVariables == NULL)
+        throw(variablesMallocError);
+    for (size_t i = 0; i < pData->argumentCount; i++) {
+        if (!nativeEmitter_emitExpression(pEmitter, construction_getArguments(pData)[i], false, &pVariables[i]))
+            throw(argumentEmitError);
+    }
+    
+    size_t variable = pEmitter->variableCount++;
+    if (!output_format(&pEmitter->output, "        Expression v%zu;\n", variable))
+        throw(variableEmitError);
+    if (!output_format(&pEmitter->output, "        if (!pApi->construct(%u, %u, ", pData->index, pData->argumentCount))
+        throw(constructEmitError);
+    if (pData->argumentCount == 0 && !output_format(&pEmitter->output, "NULL"))
+        throw(constructEmitError);
+    for (size_t i = 0; i < pData->argumentCount; i++) {
+        if (!output_format(&pEmitter->output, i == 0 ? "(Expression[]) {v%zu" : ", v%zu", pVariables[i]))
+            throw(constructEmitError);
+    }
+    if (pData->argumentCount > 0 && !output_format(&pEmitter->output, "}"))
+        throw(constructEmitError);
+    if (!output_format(&pEmitter->output, ", &v%zu))\n            return NATIVE_FAILED;\n", variable))
+        throw(constructEmitError);
+    free(pVariables);
+    *pVariable = variable;
+    return true;
+    
+constructEmitError:
+variableEmitError:
+argumentEmitError:
+    free(pVariables);
+variablesMallocError:
+    return false;
+}
+bool nativeEmitter_emitEvaluation(
+    NativeEmitter* pEmitter, Evaluation evaluation, bool isTail, size_t* pTypeIndex, size_t* pVariable
+) {
+    if (evaluation.kind == REFERENCE_EVALUATION) {
+        size_t index = *(size_t*) evaluation.pData;
+        if (!nativeEmitter_getSlotType(pEmitter, index, pTypeIndex))
+            throw(referenceTypeError);
+        size_t fieldCount = pEmitter->module.pMatrices[pEmitter->typeIndex].pConstructors[pEmitter->constructorIndex].parameterCount;
+        size_t variable = pEmitter->variableCount++;
+        if (index < fieldCount && !output_format(
+            &pEmitter->output, "        Expression v%zu = construction_getArguments(pCaller)[%zu];\n", variable, index
+        ))
+            throw(referenceEmitError);
+        if (index >= fieldCount && !output_format(
+            &pEmitter->output, "        Expression v%zu = a%zu;\n", variable, index - fieldCount
+        ))
+            throw(referenceEmitError);
+        *pVariable = variable;
+        return true;
+    
+    referenceEmitError:
+    referenceTypeError:
+        return false;
+    }
+    Destruction* pData = evaluation.pData;
+    size_t callerVariable;
+    size_t callerTypeIndex;
+    if (!nativeEmitter_emitEvaluation(pEmitter, pData->caller, false, &callerTypeIndex, &callerVariable))
+        throw(callerEmitError);
+    size_t* pVariables = malloc((pData->argumentCount + 1) * sizeof(size_t));
+    if (pVariables == NULL)
+        throw(variablesMallocError);
+    for (size_t i = 0; i < pData->argumentCount; i++) {
+        if (!nativeEmitter_emitExpression(pEmitter, pData->pArguments[i], false, &pVariables[i]))
+            throw(argumentEmitError);
+    }
+    Destructor destructor = pEmitter->module.pMatrices[callerTypeIndex].pDestructors[pData->index];
+    if (!native_getType(pEmitter->module, destructor.returnType, pTypeIndex))
+        throw(returnTypeError);
+    
+    if (isTail && callerTypeIndex == pEmitter->typeIndex && pData->index == pEmitter->destructorIndex) {
+        if (!output_format(&pEmitter->output, "        caller = v%zu;\n", callerVariable))
+            throw(callEmitError);
+        for (size_t i = 0; i < pData->argumentCount; i++) {
+            if (!output_format(&pEmitter->output, "        a%zu = v%zu;\n", i, pVariables[i]))
+                throw(callEmitError);
+        }
+        if (!output_format(&pEmitter->output, "        goto tail;\n"))
+            throw(callEmitError);
+        free(pVariables);
+        *pVariable = SIZE_MAX;
+        return true;
+    }
+    size_t variable = pEmitter->variableCount++;
+    if (!isTail && !output_format(
+        &pEmitter->output, "        Expression v%zu;\n        NativeStatus s%zu = ", variable, variable
+    ))
+        throw(callEmitError);
+    if (isTail && !output_format(&pEmitter->output, "        return "))
+        throw(callEmitError);
+    if (!nativeEmitter_emitName(pEmitter, callerTypeIndex, pData->index))
+        throw(callEmitError);
+    if (!output_format(&pEmitter->output, "(v%zu", callerVariable))
+        throw(callEmitError);
+    for (size_t i = 0; i < pData->argumentCount; i++) {
+        if (!output_format(&pEmitter->output, ", v%zu", pVariables[i]))
+            throw(callEmitError);
+    }
+    if (isTail && !output_format(&pEmitter->output, ", pResult);\n"))
+        throw(callEmitError);
+    if (!isTail && !output_format(
+        &pEmitter->output, ", &v%zu);\n        if (s%zu != NATIVE_DONE)\n            return s%zu;\n",
+        variable, variable, variable
+    ))
+        throw(callEmitError);
+    free(pVariables);
+    *pVariable = isTail ? SIZE_MAX : variable;
+    return true;
+    
+callEmitError:
+returnTypeError:
+argumentEmitError:
+    free(pVariables);
+variablesMallocError:
+callerEmitError:
+    return false;
+}
+bool nativeEmitter_emitName(NativeEmitter* pEmitter, size_t typeIndex, size_t destructorIndex) {
+    return output_format(&pEmitter->output, "native_%zu_%zu", typeIndex, destructorIndex);
+}
+bool nativeEmitter_emitSignature(NativeEmitter* pEmitter, size_t typeIndex, size_t destructorIndex) {
+    if (!output_format(&pEmitter->output, "static NativeStatus "))
+        throw(signatureEmitError);
+    if (!nativeEmitter_emitName(pEmitter, typeIndex, destructorIndex))
+        throw(signatureEmitError);
+    if (!output_format(&pEmitter->output, "(Expression caller"))
+        throw(signatureEmitError);
+    Destructor destructor = pEmitter->module.pMatrices[typeIndex].pDestructors[destructorIndex];
+    for (size_t i = 0; i < destructor.parameterCount; i++) {
+        if (!output_format(&pEmitter->output, ", Expression a%zu", i))
+            throw(signatureEmitError);
+    }
+    if (!output_format(&pEmitter->output, ", Expression* pResult)"))
+        throw(signatureEmitError);
+    return true;
+    
+signatureEmitError:
+    return false;
+}
+bool nativeEmitter_emitFunction(NativeEmitter* pEmitter, size_t typeIndex, size_t destructorIndex) {
+    Module module = pEmitter->module;
+    Matrix matrix = module.pMatrices[typeIndex];
+    Destructor destructor = matrix.pDestructors[destructorIndex];
+    String typeName = symbols.pStrings[module.pMatrices[0].pConstructors[typeIndex].name];
+    String destructorName = symbols.pStrings[destructor.name];
+    if (!output_format(
+        &pEmitter->output, "\n// %.*s.%.*s\n", (int) typeName.length, typeName.pData,
+        (int) destructorName.length, destructorName.pData
+    ))
+        throw(functionEmitError);
+    if (!nativeEmitter_emitSignature(pEmitter, typeIndex, destructorIndex))
+        throw(functionEmitError);
+    if (!output_format(
+        &pEmitter->output,
+        " {\n    if ((char const*) __builtin_frame_address(0) < *pApi->ppStackLimit)\n"
+        "        return pApi->destruct(%zu, %zu, caller, ", typeIndex, destructorIndex
+    ))
+        throw(functionEmitError);
+    if (destructor.parameterCount == 0 && !output_format(&pEmitter->output, "NULL"))
+        throw(functionEmitError);
+    for (size_t i = 0; i < destructor.parameterCount; i++) {
+        if (!output_format(&pEmitter->output, i == 0 ? "(Expression[]) {a%zu" : ", a%zu", i))
+            throw(functionEmitError);
+    }
+    if (destructor.parameterCount > 0 && !output_format(&pEmitter->output, "}"))
+        throw(functionEmitError);
+    if (!output_format(
+        &pEmitter->output,
+        ", pResult) ? NATIVE_DONE : NATIVE_FAILED;\n"
+        "    if (!pApi->pIsValid[%zu])\n"
+        "        return NATIVE_DECLINED;\n"
+        "    Construction const* pCaller;\n"
+        "tail: __attribute__((unused));\n"
+        "    if (caller.kind != CONSTRUCTION_EXPRESSION)\n"
+        "        return NATIVE_DECLINED;\n"
+        "    pCaller = caller.pData;\n"
+        "    switch (pCaller->index) {\n",
+        pEmitter->pBindingIndices[pEmitter->pOffsets[typeIndex] + destructorIndex]
+    ))
+        throw(functionEmitError);
+    
+    Expression* pRules = matrix_getRules(matrix, destructorIndex);
+    for (size_t i = 0; i < matrix.constructorCount; i++) {
+        if (pRules[i].kind == UNSPECIFIED_EXPRESSION)
+            continue;
+        pEmitter->typeIndex = typeIndex;
+        pEmitter->constructorIndex = i;
+        pEmitter->destructorIndex = destructorIndex;
+        pEmitter->variableCount = 0;
+        if (!output_format(&pEmitter->output, "    case %zu: {\n", i))
+            throw(functionEmitError);
+        size_t variable;
+        if (!nativeEmitter_emitExpression(pEmitter, pRules[i], true, &variable))
+            throw(functionEmitError);
+        if (variable != SIZE_MAX && !output_format(
+            &pEmitter->output, "        *pResult = v%zu;\n        return NATIVE_DONE;\n", variable
+        ))
+            throw(functionEmitError);
+        if (!output_format(&pEmitter->output, "    }\n"))
+            throw(functionEmitError);
+    }
+    if (!output_format(&pEmitter->output, "    default:\n        return NATIVE_DECLINED;\n    }\n}\n"))
+        throw(functionEmitError);
+    return true;
+    
+functionEmitError:
+    return false;
+}
+bool native_findEligible(Module module, size_t** ppOffsets, bool** ppIsEligible) {
+    size_t* pOffsets = malloc((module.matrixCount + 1) * sizeof(size_t));
+    if (pOffsets == NULL)
+        throw(offsetsMallocError);
+    pOffsets[0] = 0;
+    for (size_t i = 0; i < module.matrixCount; i++)
+        pOffsets[i + 1] = pOffsets[i] + module.pMatrices[i].destructorCount;
+    bool* pIsEligible = malloc((pOffsets[module.matrixCount] + 1) * sizeof(bool));
+    if (pIsEligible == NULL)
+        throw(isEligibleMallocError);
+    for (size_t i = 0; i < module.matrixCount; i++) {
+        for (size_t j = 0; j < module.pMatrices[i].destructorCount; j++)
+            pIsEligible[pOffsets[i] + j] = native_hasEligibleSignature(module, i, j);
+    }
+    
+    NativeEmitter emitter = {
+        .module = module,
+        .pOffsets = pOffsets,
+        .pIsEligible = pIsEligible
+    };
+    bool isChanged = true;
+    while (isChanged) {
+        isChanged = false;
+        for (size_t i = 0; i < module.matrixCount; i++) {
+            Matrix matrix = module.pMatrices[i];
+            for (size_t j = 0; j < matrix.destructorCount; j++) {
+                if (!pIsEligible[pOffsets[i] + j])
+                    continue;
+                Expression* pRules = matrix_getRules(matrix, j);
+                emitter.typeIndex = i;
+                emitter.destructorIndex = j;
+                for (size_t k = 0; k < matrix.constructorCount; k++) {
+                    emitter.constructorIndex = k;
+                    if (pRules[k].kind != UNSPECIFIED_EXPRESSION && !nativeEmitter_checkExpression(&emitter, pRules[k])) {
+                        pIsEligible[pOffsets[i] + j] = false;
+                        isChanged = true;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+    *ppOffsets = pOffsets;
+    *ppIsEligible = pIsEligible;
+    return true;
+    
+isEligibleMallocError:
+    free(pOffsets);
+offsetsMallocError:
+    return false;
+}
+bool module_emitNative(Module module, char const* pFileName) {
+    size_t* pOffsets;
+    bool* pIsEligible;
+    if (!native_findEligible(module, &pOffsets, &pIsEligible))
+        throw(eligibleFindError);
+    NativeEmitter emitter = {
+        .module = module,
+        .pOffsets = pOffsets,
+        .pIsEligible = pIsEligible
+    };
+    size_t* pBindingIndices = malloc((pOffsets[module.matrixCount] + 1) * sizeof(size_t));
+    if (pBindingIndices == NULL)
+        throw(bindingIndicesMallocError);
+    size_t bindingCount = 0;
+    for (size_t i = 0; i < pOffsets[module.matrixCount]; i++)
+        pBindingIndices[i] = pIsEligible[i] ? bindingCount++ : NO_NATIVE_BINDING;
+    emitter.pBindingIndices = pBindingIndices;
+    
+    if (!createFileOutput(pFileName, &emitter.output))
+        throw(outputCreateError);
+    if (!output_format(
+        &emitter.output,
+        "#include <stdbool.h>\n#include <stddef.h>\n#include <stdint.h>\n\n"
+        "enum {\n    CONSTRUCTION_EXPRESSION = %d\n};\n"
+        "typedef struct Expression {\n    int kind;\n    void* pData;\n} Expression;\n"
+        "typedef struct Construction {\n    uint32_t index;\n    uint32_t argumentCount : 31;\n"
+        "    uint32_t isClosed : 1;\n    uint64_t hash;\n} Construction;\n"
+        "static inline Expression* construction_getArguments(Construction const* pConstruction) {\n"
+        "    return (Expression*) (pConstruction + 1);\n}\n"
+        "typedef enum NativeStatus {\n    NATIVE_DONE,\n    NATIVE_DECLINED,\n    NATIVE_FAILED\n} NativeStatus;\n"
+        "typedef struct NativeApi {\n    uint64_t layout;\n"
+        "    bool (*construct)(size_t index, size_t argumentCount, Expression const* pArguments, Expression* pResult);\n"
+        "    bool (*destruct)(\n"
+        "        size_t typeIndex, size_t index, Expression caller, Expression const* pArguments, Expression* pResult\n"
+        "    );\n"
+        "    bool const* pIsValid;\n    char const* const* ppStackLimit;\n} NativeApi;\n"
+        "typedef struct NativeBinding {\n    size_t typeIndex;\n    size_t destructorIndex;\n    uint64_t hash;\n"
+        "    NativeStatus (*function)(Expression caller, Expression const* pArguments, Expression* pResult);\n"
+        "} NativeBinding;\n\n"
+        "static NativeApi const* pApi;\n",
+        CONSTRUCTION_EXPRESSION
+    ))
+        throw(headerEmitError);
+    for (size_t i = 0; i < module.matrixCount; i++) {
+        for (size_t j = 0; j < module.pMatrices[i].destructorCount; j++) {
+            if (!pIsEligible[pOffsets[i] + j])
+                continue;
+            if (!nativeEmitter_emitSignature(&emitter, i, j) || !output_format(&emitter.output, ";\n"))
+                throw(prototypeEmitError);
+        }
+    }
+    for (size_t i = 0; i < module.matrixCount; i++) {
+        for (size_t j = 0; j < module.pMatrices[i].destructorCount; j++) {
+            if (pIsEligible[pOffsets[i] + j] && !nativeEmitter_emitFunction(&emitter, i, j))
+                throw(functionEmitError);
+        }
+    }
+    
+    for (size_t i = 0; i < module.matrixCount; i++) {
+        for (size_t j = 0; j < module.pMatrices[i].destructorCount; j++) {
+            if (!pIsEligible[pOffsets[i] + j])
+                continue;
+            if (!output_format(&emitter.output, "\nstatic NativeStatus "))
+                throw(entryEmitError);
+            if (!nativeEmitter_emitName(&emitter, i, j))
+                throw(entryEmitError);
+            if (!output_format(
+                &emitter.output,
+                "_entry(Expression caller, Expression const* pArguments, Expression* pResult) {\n"
+            ))
+                throw(entryEmitError);
+            if (module.pMatrices[i].pDestructors[j].parameterCount == 0
+                && !output_format(&emitter.output, "    (void) pArguments;\n"))
+                throw(entryEmitError);
+            if (!output_format(&emitter.output, "    return "))
+                throw(entryEmitError);
+            if (!nativeEmitter_emitName(&emitter, i, j) || !output_format(&emitter.output, "(caller"))
+                throw(entryEmitError);
+            for (size_t k = 0; k < module.pMatrices[i].pDestructors[j].parameterCount; k++) {
+                if (!output_format(&emitter.output, ", pArguments[%zu]", k))
+                    throw(entryEmitError);
+            }
+            if (!output_format(&emitter.output, ", pResult);\n}\n"))
+                throw(entryEmitError);
+        }
+    }
+    if (!output_format(&emitter.output, "\nstatic NativeBinding const bindings[%zu] = {\n", bindingCount + 1))
+        throw(bindingEmitError);
+    for (size_t i = 0; i < module.matrixCount; i++) {
+        for (size_t j = 0; j < module.pMatrices[i].destructorCount; j++) {
+            if (!pIsEligible[pOffsets[i] + j])
+                continue;
+            if (!output_format(
+                &emitter.output, "    {%zu, %zu, 0x%016llXu, ", i, j, (unsigned long long) native_hash(module, i, j)
+            ))
+                throw(bindingEmitError);
+            if (!nativeEmitter_emitName(&emitter, i, j) || !output_format(&emitter.output, "_entry},\n"))
+                throw(bindingEmitError);
+        }
+    }
+    if (!output_format(
+        &emitter.output,
+        "};\n\n"
+        "bool native_bind(NativeApi const* pNativeApi, size_t* pBindingCount, NativeBinding const** ppBindings) {\n"
+        "    uint64_t layout = (uint64_t) %lluu << 48 | (uint64_t) sizeof(NativeBinding) << 40\n"
+        "        | (uint64_t) sizeof(NativeApi) << 32 | (uint64_t) offsetof(Construction, hash) << 16\n"
+        "        | (uint64_t) sizeof(Construction) << 8 | (uint64_t) sizeof(Expression);\n"
+        "    if (pNativeApi->layout != layout)\n"
+        "        return false;\n"
+        "    pApi = pNativeApi;\n"
+        "    *pBindingCount = %zu;\n"
+        "    *ppBindings = bindings;\n"
+        "    return true;\n"
+        "}\n",
+        (unsigned long long) NATIVE_VERSION, bindingCount
+    ))
+        throw(bindEmitError);
+    if (!output_flush(&emitter.output))
+        throw(outputFlushError);
+    
+    destroyOutput(emitter.output);
+    free(pBindingIndices);
+    free(pIsEligible);
+    free(pOffsets);
+    return true;
+    
+outputFlushError:
+bindEmitError:
+bindingEmitError:
+entryEmitError:
+functionEmitError:
+prototypeEmitError:
+headerEmitError:
+    destroyOutput(emitter.output);
+    remove(pFileName);
+outputCreateError:
+    free(pBindingIndices);
+bindingIndicesMallocError:
+    free(pIsEligible);
+    free(pOffsets);
+eligibleFindError:
+    fprintf(stderr, "Unable to write native code %s\n", pFileName);
+    return false;
+}
+void destroyJit(Jit* pJit) {
+    for (size_t i = 0; i < pJit->chunkCount; i++)
+        munmap(pJit->pChunks[i].pData, pJit->pChunks[i].length);
+    free(pJit->pChunks);
+    for (size_t i = 0; i < pJit->functionCount; i++)
+        free(pJit->ppFunctions[i]);
+    free(pJit->ppFunctions);
+    free(pJit->pProfiles);
+}
+JitProfile* jit_findProfile(size_t typeIndex, size_t destructorIndex) {
+    if (jit.profileCapacity == 0)
+        return NULL;
+    size_t i = hash_combine(hash_combine(0, typeIndex), destructorIndex) & (jit.profileCapacity - 1);
+    for (; jit.pProfiles[i].typeIndex != SIZE_MAX; i = (i + 1) & (jit.profileCapacity - 1)) {
+        if (jit.pProfiles[i].typeIndex == typeIndex && jit.pProfiles[i].destructorIndex == destructorIndex)
+            return &jit.pProfiles[i];
+    }
+    return NULL;
+}
+bool jit_insertProfile(size_t typeIndex, size_t destructorIndex, JitProfile** ppProfile) {
+    JitProfile* pProfile = jit_findProfile(typeIndex, destructorIndex);
+    if (pProfile != NULL) {
+        *ppProfile = pProfile;
+        return true;
+    }
+    if (2 * (jit.profileCount + 1) > jit.profileCapacity) {
+        size_t profileCapacity = jit.profileCapacity == 0 ? 64 : 2 * jit.profileCapacity;
+        JitProfile* pProfiles = malloc(profileCapacity * sizeof(JitProfile));
+        if (pProfiles == NULL)
+            throw(profilesMallocError);
+        for (size_t i = 0; i < profileCapacity; i++)
+            pProfiles[i].typeIndex = SIZE_MAX;
+        for (size_t i = 0; i < jit.profileCapacity; i++) {
+            JitProfile profile = jit.pProfiles[i];
+            if (profile.typeIndex == SIZE_MAX)
+                continue;
+            size_t j = hash_combine(hash_combine(0, profile.typeIndex), profile.destructorIndex) & (profileCapacity - 1);
+            while (pProfiles[j].typeIndex != SIZE_MAX)
+                j = (j + 1) & (profileCapacity - 1);
+            pProfiles[j] = profile;
+        }
+        free(jit.pProfiles);
+        jit.pProfiles = pProfiles;
+        jit.profileCapacity = profileCapacity;
+    }
+    
+    size_t i = hash_combine(hash_combine(0, typeIndex), destructorIndex) & (jit.profileCapacity - 1);
+    while (jit.pProfiles[i].typeIndex != SIZE_MAX)
+        i = (i + 1) & (jit.profileCapacity - 1);
+    jit.pProfiles[i] = (JitProfile) {
+        .typeIndex = typeIndex,
+        .destructorIndex = destructorIndex,
+        .callCount = 0,
+        .isRejected = false,
+        .rejectedFingerprint = 0,
+        .pFunction = NULL
+    };
+    jit.profileCount++;
+    *ppProfile = &jit.pProfiles[i];
+    return true;
+    
+profilesMallocError:
+    return false;
+}
+void jit_validate(Module module) {
+    for (size_t i = 0; i < jit.functionCount; i++) {
+        JitFunction* pFunction = jit.ppFunctions[i];
+        pFunction->isValid = pFunction->code != NULL && pFunction->typeIndex < module.matrixCount
+            && pFunction->typeIndex < module.pMatrices[0].constructorCount
+            && pFunction->destructorIndex < module.pMatrices[pFunction->typeIndex].destructorCount
+            && native_hash(module, pFunction->typeIndex, pFunction->destructorIndex) == pFunction->hash;
+    }
+    jit.fingerprint = module.fingerprint;
+}
+bool jit_apply(
+    Module module, size_t typeIndex, size_t index, Expression caller, Expression const* pArguments,
+    bool* pIsApplied, Expression* pValue
+) {
+    *pIsApplied = false;
+    if (jit.threshold == 0 || native.isRunning || evaluator.isLazy || evaluator.frameLimit != SIZE_MAX)
+        return true;
+    if (jit.fingerprint != module.fingerprint)
+        jit_validate(module);
+    JitProfile* pProfile;
+    if (!jit_insertProfile(typeIndex, index, &pProfile))
+        throw(profileInsertError);
+    if (pProfile->isRejected && pProfile->rejectedFingerprint == module.fingerprint)
+        return true;
+    if (pProfile->pFunction == NULL || !pProfile->pFunction->isValid) {
+        if (++pProfile->callCount < jit.threshold)
+            return true;
+        pProfile->callCount = 0;
+        bool isCompiled;
+        if (!jit_compile(module, typeIndex, index, &isCompiled))
+            throw(compileError);
+        pProfile = jit_findProfile(typeIndex, index);
+        if (!isCompiled) {
+            pProfile->isRejected = true;
+            pProfile->rejectedFingerprint = module.fingerprint;
+            return true;
+        }
+    }
+    
+    native.module = module;
+    native.isRunning = true;
+    native.pStackBase = __builtin_frame_address(0);
+    jit.isStackExhausted = false;
+    NativeStatus status = pProfile->pFunction->code(&caller, pArguments, pValue);
+    native.isRunning = false;
+    native.pStackBase = NULL;
+    if (status == NATIVE_FAILED)
+        throw(codeError);
+    if (jit.isStackExhausted) {
+        pProfile = jit_findProfile(typeIndex, index);
+        pProfile->isRejected = true;
+        pProfile->rejectedFingerprint = module.fingerprint;
+    }
+    *pIsApplied = status == NATIVE_DONE;
+    return true;
+    
+codeError:
+compileError:
+profileInsertError:
+    return false;
+}
+bool jit_compile(Module module, size_t typeIndex, size_t destructorIndex, bool* pIsCompiled) {
+    *pIsCompiled = false;
+#if defined(__x86_64__)
+    size_t* pOffsets;
+    bool* pIsEligible;
+    if (!native_findEligible(module, &pOffsets, &pIsEligible))
+        throw(eligibleFindError);
+    if (!pIsEligible[pOffsets[typeIndex] + destructorIndex]) {
+        free(pIsEligible);
+        free(pOffsets);
+        return true;
+    }
+    
+    JitAssembler assembler = {
+        .length = 0,
+        .capacity = 0,
+        .pData = NULL,
+        .labelCount = 0,
+        .labelCapacity = 0,
+        .pLabels = NULL,
+        .fixupCount = 0,
+        .fixupCapacity = 0,
+        .pFixups = NULL,
+        .batchCount = 0,
+        .batchCapacity = 0,
+        .ppBatch = NULL,
+        .pStarts = NULL,
+        .ppTargets = calloc(pOffsets[module.matrixCount] + 1, sizeof(JitFunction*)),
+        .emitter = {
+            .module = module,
+            .pOffsets = pOffsets,
+            .pIsEligible = pIsEligible
+        }
+    };
+    if (assembler.ppTargets == NULL)
+        throw(targetsCallocError);
+    JitFunction* pRoot;
+    if (!jitAssembler_getTarget(&assembler, typeIndex, destructorIndex, &pRoot))
+        throw(assembleError);
+    for (size_t i = 0; i < assembler.batchCount; i++) {
+        while (assembler.length % 16 != 0) {
+            if (!jitAssembler_emit(&assembler, 1, (unsigned char[]) {0xCC}))
+                throw(assembleError);
+        }
+        assembler.pStarts[i] = assembler.length;
+        if (!jitAssembler_emitFunction(&assembler, assembler.ppBatch[i]))
+            throw(assembleError);
+    }
+    for (size_t i = 0; i < assembler.fixupCount; i++) {
+        JitFixup fixup = assembler.pFixups[i];
+        int32_t displacement = (int32_t) (assembler.pLabels[fixup.label] - (fixup.position + 4));
+        memcpy(&assembler.pData[fixup.position], &displacement, sizeof(int32_t));
+    }
+    
+    if (jit.chunkCount == jit.chunkCapacity) {
+        size_t chunkCapacity = jit.chunkCapacity == 0 ? 16 : 2 * jit.chunkCapacity;
+        JitChunk* pChunks = realloc(jit.pChunks, chunkCapacity * sizeof(JitChunk));
+        if (pChunks == NULL)
+            throw(chunksReallocError);
+        jit.pChunks = pChunks;
+        jit.chunkCapacity = chunkCapacity;
+    }
+    unsigned char* pCode = mmap(NULL, assembler.length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (pCode == MAP_FAILED)
+        throw(codeMapError);
+    memcpy(pCode, assembler.pData, assembler.length);
+    if (mprotect(pCode, assembler.length, PROT_READ | PROT_EXEC) == -1)
+        throw(codeProtectError);
+    jit.pChunks[jit.chunkCount++] = (JitChunk) {
+        .pData = pCode,
+        .length = assembler.length
+    };
+    for (size_t i = 0; i < assembler.batchCount; i++) {
+        JitFunction* pFunction = assembler.ppBatch[i];
+        JitProfile* pProfile;
+        if (!jit_insertProfile(pFunction->typeIndex, pFunction->destructorIndex, &pProfile))
+            throw(profileInsertError);
+        pFunction->code = (JitCode) (pCode + assembler.pStarts[i]);
+        pFunction->isValid = true;
+        pProfile->pFunction = pFunction;
+    }
+    jit.compiledFunctionCount += assembler.batchCount;
+    jit.compiledByteCount += assembler.length;
+    
+    destroyJitAssembler(assembler);
+    free(pIsEligible);
+    free(pOffsets);
+    *pIsCompiled = true;
+    return true;
+    
+codeProtectError:
+    munmap(pCode, assembler.length);
+profileInsertError:
+codeMapError:
+chunksReallocError:
+assembleError:
+    destroyJitAssembler(assembler);
+targetsCallocError:
+    free(pIsEligible);
+    free(pOffsets);
+eligibleFindError:
+    return false;
+#else
+    return true;
+#endif
+}
+void jit_printStatistics(void) {
+    fprintf(
+        stderr, "JIT: %lu destructors compiled, %lu KB of code\n",
+        jit.compiledFunctionCount, (jit.compiledByteCount + 1023) / 1024
+    );
+}
+void destroyJitAssembler(JitAssembler assembler) {
+    free(assembler.ppTargets);
+    free(assembler.pStarts);
+    free(assembler.ppBatch);
+    free(assembler.pFixups);
+    free(assembler.pLabels);
+    free(assembler.pData);
+}
+bool jitAssembler_emit(JitAssembler* pAssembler, size_t length, unsigned char const* pBytes) {
+    if (pAssembler->length + length > pAssembler->capacity) {
+        size_t capacity = pAssembler->capacity == 0 ? 4096 : 2 * pAssembler->capacity;
+        while (capacity < pAssembler->length + length)
+            capacity *= 2;
+        unsigned char* pData = realloc(pAssembler->pData, capacity);
+        if (pData == NULL)
+            throw(dataReallocError);
+        pAssembler->pData = pData;
+        pAssembler->capacity = capacity;
+    }
+    memcpy(&pAssembler->pData[pAssembler->length], pBytes, length);
+    pAssembler->length += length;
+    return true;
+    
+dataReallocError:
+    return false;
+}
+bool jitAssembler_emitImmediate32(JitAssembler* pAssembler, uint32_t value) {
+    unsigned char pBytes[sizeof(uint32_t)];
+    memcpy(pBytes, &value, sizeof(uint32_t));
+    return jitAssembler_emit(pAssembler, sizeof(uint32_t), pBytes);
+}
+bool jitAssembler_emitImmediate64(JitAssembler* pAssembler, uint64_t value) {
+    unsigned char pBytes[sizeof(uint64_t)];
+    memcpy(pBytes, &value, sizeof(uint64_t));
+    return jitAssembler_emit(pAssembler, sizeof(uint64_t), pBytes);
+}
+bool jitAssembler_createLabel(JitAssembler* pAssembler, size_t* pLabel) {
+    if (pAssembler->labelCount == pAssembler->labelCapacity) {
+        size_t labelCapacity = pAssembler->labelCapacity == 0 ? 64 : 2 * pAssembler->labelCapacity;
+        size_t* pLabels = realloc(pAssembler->pLabels, labelCapacity * sizeof(size_t));
+        if (pLabels == NULL)
+            throw(labelsReallocError);
+        pAssembler->pLabels = pLabels;
+        pAssembler->labelCapacity = labelCapacity;
+    }
+    pAssembler->pLabels[pAssembler->labelCount] = SIZE_MAX;
+    *pLabel = pAssembler->labelCount++;
+    return true;
+    
+labelsReallocError:
+    return false;
+}
+void jitAssembler_placeLabel(JitAssembler* pAssembler, size_t label) {
+    pAssembler->pLabels[label] = pAssembler->length;
+}
+bool jitAssembler_emitJump(JitAssembler* pAssembler, size_t length, unsigned char const* pOpcode, size_t label) {
+    if (!jitAssembler_emit(pAssembler, length, pOpcode))
+        throw(opcodeEmitError);
+    if (pAssembler->fixupCount == pAssembler->fixupCapacity) {
+        size_t fixupCapacity = pAssembler->fixupCapacity == 0 ? 64 : 2 * pAssembler->fixupCapacity;
+        JitFixup* pFixups = realloc(pAssembler->pFixups, fixupCapacity * sizeof(JitFixup));
+        if (pFixups == NULL)
+            throw(fixupsReallocError);
+        pAssembler->pFixups = pFixups;
+        pAssembler->fixupCapacity = fixupCapacity;
+    }
+    pAssembler->pFixups[pAssembler->fixupCount++] = (JitFixup) {
+        .position = pAssembler->length,
+        .label = label
+    };
+    return jitAssembler_emitImmediate32(pAssembler, 0);
+    
+fixupsReallocError:
+opcodeEmitError:
+    return false;
+}
+bool jitAssembler_emitCall(JitAssembler* pAssembler, void const* pTarget) {
+    return jitAssembler_emit(pAssembler, 2, (unsigned char[]) {0x48, 0xB8})
+        && jitAssembler_emitImmediate64(pAssembler, (uint64_t) (uintptr_t) pTarget)
+        && jitAssembler_emit(pAssembler, 2, (unsigned char[]) {0xFF, 0xD0});
+}
+bool jitAssembler_emitCopy(JitAssembler* pAssembler, JitBase base, size_t offset, size_t slot) {
+    for (size_t i = 0; i < 2; i++) {
+        if (base == JIT_FIELDS && !jitAssembler_emit(pAssembler, 3, (unsigned char[]) {0x49, 0x8B, 0x86}))
+            throw(loadEmitError);
+        if (base == JIT_ARGUMENTS && !jitAssembler_emit(pAssembler, 4, (unsigned char[]) {0x49, 0x8B, 0x84, 0x24}))
+            throw(loadEmitError);
+        if (base == JIT_SLOTS && !jitAssembler_emit(pAssembler, 4, (unsigned char[]) {0x48, 0x8B, 0x84, 0x24}))
+            throw(loadEmitError);
+        if (!jitAssembler_emitImmediate32(pAssembler, (uint32_t) (offset + 8 * i)))
+            throw(loadEmitError);
+        if (!jitAssembler_emit(pAssembler, 4, (unsigned char[]) {0x48, 0x89, 0x84, 0x24}))
+            throw(storeEmitError);
+        if (!jitAssembler_emitImmediate32(pAssembler, (uint32_t) (slot * sizeof(Expression) + 8 * i)))
+            throw(storeEmitError);
+    }
+    return true;
+    
+storeEmitError:
+loadEmitError:
+    return false;
+}
+bool jitAssembler_emitSlotAddress(JitAssembler* pAssembler, unsigned char rex, unsigned char modRm, size_t slot) {
+    return jitAssembler_emit(pAssembler, 4, (unsigned char[]) {rex, 0x8D, modRm, 0x24})
+        && jitAssembler_emitImmediate32(pAssembler, (uint32_t) (slot * sizeof(Expression)));
+}
+size_t jitAssembler_allocateSlots(JitAssembler* pAssembler, size_t count) {
+    size_t slot = pAssembler->slotCount;
+    pAssembler->slotCount += count;
+    if (pAssembler->slotCount > pAssembler->frameSlotCount)
+        pAssembler->frameSlotCount = pAssembler->slotCount;
+    return slot;
+}
+bool jitAssembler_getTarget(
+    JitAssembler* pAssembler, size_t typeIndex, size_t destructorIndex, JitFunction** ppFunction
+) {
+    size_t index = pAssembler->emitter.pOffsets[typeIndex] + destructorIndex;
+    if (pAssembler->ppTargets[index] != NULL) {
+        *ppFunction = pAssembler->ppTargets[index];
+        return true;
+    }
+    JitProfile* pProfile = jit_findProfile(typeIndex, destructorIndex);
+    if (pProfile != NULL && pProfile->pFunction != NULL && pProfile->pFunction->isValid) {
+        pAssembler->ppTargets[index] = pProfile->pFunction;
+        *ppFunction = pProfile->pFunction;
+        return true;
+    }
+    
+    if (jit.functionCount == jit.functionCapacity) {
+        size_t functionCapacity = jit.functionCapacity == 0 ? 64 : 2 * jit.functionCapacity;
+        JitFunction** ppFunctions = realloc(jit.ppFunctions, functionCapacity * sizeof(JitFunction*));
+        if (ppFunctions == NULL)
+            throw(functionsReallocError);
+        jit.ppFunctions = ppFunctions;
+        jit.functionCapacity = functionCapacity;
+    }
+    if (pAssembler->batchCount == pAssembler->batchCapacity) {
+        size_t batchCapacity = pAssembler->batchCapacity == 0 ? 16 : 2 * pAssembler->batchCapacity;
+        JitFunction** ppBatch = realloc(pAssembler->ppBatch, batchCapacity * sizeof(JitFunction*));
+        if (ppBatch == NULL)
+            throw(batchReallocError);
+        pAssembler->ppBatch = ppBatch;
+        size_t* pStarts = realloc(pAssembler->pStarts, batchCapacity * sizeof(size_t));
+        if (pStarts == NULL)
+            throw(batchReallocError);
+        pAssembler->pStarts = pStarts;
+        pAssembler->batchCapacity = batchCapacity;
+    }
+    JitFunction* pFunction = malloc(sizeof(JitFunction));
+    if (pFunction == NULL)
+        throw(functionMallocError);
+    *pFunction = (JitFunction) {
+        .code = NULL,
+        .isValid = false,
+        .typeIndex = typeIndex,
+        .destructorIndex = destructorIndex,
+        .hash = native_hash(pAssembler->emitter.module, typeIndex, destructorIndex)
+    };
+    jit.ppFunctions[jit.functionCount++] = pFunction;
+    pAssembler->ppBatch[pAssembler->batchCount++] = pFunction;
+    pAssembler->ppTargets[index] = pFunction;
+    *ppFunction = pFunction;
+    return true;
+    
+functionMallocError:
+batchReallocError:
+functionsReallocError:
+    return false;
+}
+bool jitAssembler_emitExpression(JitAssembler* pAssembler, Expression expression, size_t slot) {
+    if (expression.kind == EVALUATION_EXPRESSION) {
+        size_t typeIndex;
+        return jitAssembler_emitEvaluation(pAssembler, *(Evaluation*) expression.pData, slot, false, &typeIndex);
+    }
+    Construction* pData = expression.pData;
+    size_t argumentSlot = jitAssembler_allocateSlots(pAssembler, pData->argumentCount);
+    for (size_t i = 0; i < pData->argumentCount; i++) {
+        if (!jitAssembler_emitExpression(pAssembler, construction_getArguments(pData)[i], argumentSlot + i))
+            throw(argumentEmitError);
+    }
+    if (!jitAssembler_emit(pAssembler, 1, (unsigned char[]) {0xBF}) || !jitAssembler_emitImmediate32(pAssembler, pData->index))
+        throw(constructEmitError);
+    if (!jitAssembler_emit(pAssembler, 1, (unsigned char[]) {0xBE}) || !jitAssembler_emitImmediate32(pAssembler, pData->argumentCount))
+        throw(constructEmitError);
+    if (!jitAssembler_emitSlotAddress(pAssembler, 0x48, 0x94, argumentSlot))
+        throw(constructEmitError);
+    if (!jitAssembler_emitSlotAddress(pAssembler, 0x48, 0x8C, slot))
+        throw(constructEmitError);
+    if (!jitAssembler_emitCall(pAssembler, native_construct))
+        throw(constructEmitError);
+    if (!jitAssembler_emit(pAssembler, 2, (unsigned char[]) {0x84, 0xC0}))
+        throw(constructEmitError);
+    if (!jitAssembler_emitJump(pAssembler, 2, (unsigned char[]) {0x0F, 0x84}, pAssembler->failedLabel))
+        throw(constructEmitError);
+    return true;
+    
+constructEmitError:
+argumentEmitError:
+    return false;
+}
+bool jitAssembler_emitEvaluation(
+    JitAssembler* pAssembler, Evaluation evaluation, size_t slot, bool isTail, size_t* pTypeIndex
+) {
+    NativeEmitter const* pEmitter = &pAssembler->emitter;
+    if (evaluation.kind == REFERENCE_EVALUATION) {
+        size_t index = *(size_t*) evaluation.pData;
+        if (!nativeEmitter_getSlotType(pEmitter, index, pTypeIndex))
+            throw(referenceTypeError);
+        size_t fieldCount = pEmitter->module.pMatrices[pEmitter->typeIndex].pConstructors[pEmitter->constructorIndex].parameterCount;
+        if (index < fieldCount && !jitAssembler_emitCopy(pAssembler, JIT_FIELDS, index * sizeof(Expression), slot))
+            throw(referenceEmitError);
+        if (index >= fieldCount && !jitAssembler_emitCopy(
+            pAssembler, JIT_ARGUMENTS, (index - fieldCount) * sizeof(Expression), slot
+        ))
+            throw(referenceEmitError);
+        return true;
+    
+    referenceEmitError:
+    referenceTypeError:
+        return false;
+    }
+    Destruction* pData = evaluation.pData;
+    size_t callerSlot = jitAssembler_allocateSlots(pAssembler, 1 + pData->argumentCount);
+    size_t callerTypeIndex;
+    if (!jitAssembler_emitEvaluation(pAssembler, pData->caller, callerSlot, false, &callerTypeIndex))
+        throw(callerEmitError);
+    for (size_t i = 0; i < pData->argumentCount; i++) {
+        if (!jitAssembler_emitExpression(pAssembler, pData->pArguments[i], callerSlot + 1 + i))
+            throw(argumentEmitError);
+    }
+    Destructor destructor = pEmitter->module.pMatrices[callerTypeIndex].pDestructors[pData->index];
+    if (!native_getType(pEmitter->module, destructor.returnType, pTypeIndex))
+        throw(returnTypeError);
+    JitFunction* pTarget;
+    if (!jitAssembler_getTarget(pAssembler, callerTypeIndex, pData->index, &pTarget))
+        throw(targetGetError);
+    
+    if (isTail && pTarget == pAssembler->pFunction) {
+        for (size_t i = 0; i <= pData->argumentCount; i++) {
+            if (!jitAssembler_emitCopy(pAssembler, JIT_SLOTS, (callerSlot + i) * sizeof(Expression), i))
+                throw(loopEmitError);
+        }
+        if (!jitAssembler_emitSlotAddress(pAssembler, 0x48, 0xBC, 0))
+            throw(loopEmitError);
+        if (!jitAssembler_emitSlotAddress(pAssembler, 0x4C, 0xA4, 1))
+            throw(loopEmitError);
+        if (!jitAssembler_emitJump(pAssembler, 1, (unsigned char[]) {0xE9}, pAssembler->loopLabel))
+            throw(loopEmitError);
+        return true;
+    }
+    if (!jitAssembler_emitSlotAddress(pAssembler, 0x48, 0xBC, callerSlot))
+        throw(callEmitError);
+    if (!jitAssembler_emitSlotAddress(pAssembler, 0x48, 0xB4, callerSlot + 1))
+        throw(callEmitError);
+    if (isTail && !jitAssembler_emit(pAssembler, 3, (unsigned char[]) {0x4C, 0x89, 0xEA}))
+        throw(callEmitError);
+    if (!isTail && !jitAssembler_emitSlotAddress(pAssembler, 0x48, 0x94, slot))
+        throw(callEmitError);
+    if (!jitAssembler_emit(pAssembler, 2, (unsigned char[]) {0x48, 0xB8}))
+        throw(callEmitError);
+    if (!jitAssembler_emitImmediate64(pAssembler, (uint64_t) (uintptr_t) &pTarget->code))
+        throw(callEmitError);
+    if (!jitAssembler_emit(pAssembler, 2, (unsigned char[]) {0xFF, 0x10}))
+        throw(callEmitError);
+    if (isTail && !jitAssembler_emitJump(pAssembler, 1, (unsigned char[]) {0xE9}, pAssembler->epilogueLabel))
+        throw(callEmitError);
+    if (!isTail && !jitAssembler_emit(pAssembler, 2, (unsigned char[]) {0x85, 0xC0}))
+        throw(callEmitError);
+    if (!isTail && !jitAssembler_emitJump(pAssembler, 2, (unsigned char[]) {0x0F, 0x85}, pAssembler->epilogueLabel))
+        throw(callEmitError);
+    return true;
+    
+callEmitError:
+loopEmitError:
+targetGetError:
+returnTypeError:
+argumentEmitError:
+callerEmitError:
+    return false;
+}
+bool jitAssembler_emitFunction(JitAssembler* pAssembler, JitFunction* pFunction) {
+    Module module = pAssembler->emitter.module;
+    Matrix matrix = module.pMatrices[pFunction->typeIndex];
+    Destructor destructor = matrix.pDestructors[pFunction->destructorIndex];
+    pAssembler->pFunction = pFunction;
+    pAssembler->frameSlotCount = 1 + destructor.parameterCount;
+    size_t fallbackLabel;
+    if (
+        !jitAssembler_createLabel(pAssembler, &pAssembler->loopLabel)
+        || !jitAssembler_createLabel(pAssembler, &pAssembler->declineLabel)
+        || !jitAssembler_createLabel(pAssembler, &pAssembler->failedLabel)
+        || !jitAssembler_createLabel(pAssembler, &pAssembler->doneLabel)
+        || !jitAssembler_createLabel(pAssembler, &pAssembler->epilogueLabel)
+        || !jitAssembler_createLabel(pAssembler, &fallbackLabel)
+    )
+        throw(labelCreateError);
+    
+    if (!jitAssembler_emit(pAssembler, 13, (unsigned char[]) {
+        0x55, 0x48, 0x89, 0xE5, 0x41, 0x54, 0x41, 0x55, 0x41, 0x56, 0x48, 0x81, 0xEC
+    }))
+        throw(prologueEmitError);
+    size_t frameSizePosition = pAssembler->length;
+    if (!jitAssembler_emitImmediate32(pAssembler, 0))
+        throw(prologueEmitError);
+    if (!jitAssembler_emit(pAssembler, 2, (unsigned char[]) {0x48, 0xB8}))
+        throw(prologueEmitError);
+    if (!jitAssembler_emitImmediate64(pAssembler, (uint64_t) (uintptr_t) &native.pStackLimit))
+        throw(prologueEmitError);
+    if (!jitAssembler_emit(pAssembler, 3, (unsigned char[]) {0x48, 0x3B, 0x20}))
+        throw(prologueEmitError);
+    if (!jitAssembler_emitJump(pAssembler, 2, (unsigned char[]) {0x0F, 0x82}, fallbackLabel))
+        throw(prologueEmitError);
+    if (!jitAssembler_emit(pAssembler, 2, (unsigned char[]) {0x48, 0xB8}))
+        throw(prologueEmitError);
+    if (!jitAssembler_emitImmediate64(pAssembler, (uint64_t) (uintptr_t) &pFunction->isValid))
+        throw(prologueEmitError);
+    if (!jitAssembler_emit(pAssembler, 3, (unsigned char[]) {0x80, 0x38, 0x00}))
+        throw(prologueEmitError);
+    if (!jitAssembler_emitJump(pAssembler, 2, (unsigned char[]) {0x0F, 0x84}, pAssembler->declineLabel))
+        throw(prologueEmitError);
+    if (!jitAssembler_emit(pAssembler, 6, (unsigned char[]) {0x49, 0x89, 0xF4, 0x49, 0x89, 0xD5}))
+        throw(prologueEmitError);
+    
+    jitAssembler_placeLabel(pAssembler, pAssembler->loopLabel);
+    if (!jitAssembler_emit(pAssembler, 2, (unsigned char[]) {0x81, 0x3F}))
+        throw(dispatchEmitError);
+    if (!jitAssembler_emitImmediate32(pAssembler, CONSTRUCTION_EXPRESSION))
+        throw(dispatchEmitError);
+    if (!jitAssembler_emitJump(pAssembler, 2, (unsigned char[]) {0x0F, 0x85}, pAssembler->declineLabel))
+        throw(dispatchEmitError);
+    if (!jitAssembler_emit(pAssembler, 4, (unsigned char[]) {0x48, 0x8B, 0x47, offsetof(Expression, pData)}))
+        throw(dispatchEmitError);
+    if (!jitAssembler_emit(pAssembler, 3, (unsigned char[]) {0x4C, 0x8D, 0xB0}))
+        throw(dispatchEmitError);
+    if (!jitAssembler_emitImmediate32(pAssembler, sizeof(Construction)))
+        throw(dispatchEmitError);
+    if (!jitAssembler_emit(pAssembler, 2, (unsigned char[]) {0x8B, 0x80}))
+        throw(dispatchEmitError);
+    if (!jitAssembler_emitImmediate32(pAssembler, offsetof(Construction, index)))
+        throw(dispatchEmitError);
+    Expression* pRules = matrix_getRules(matrix, pFunction->destructorIndex);
+    size_t firstCaseLabel = pAssembler->labelCount;
+    for (size_t i = 0; i < matrix.constructorCount; i++) {
+        size_t caseLabel;
+        if (!jitAssembler_createLabel(pAssembler, &caseLabel))
+            throw(dispatchEmitError);
+        if (pRules[i].kind == UNSPECIFIED_EXPRESSION)
+            continue;
+        if (!jitAssembler_emit(pAssembler, 1, (unsigned char[]) {0x3D}) || !jitAssembler_emitImmediate32(pAssembler, (uint32_t) i))
+            throw(dispatchEmitError);
+        if (!jitAssembler_emitJump(pAssembler, 2, (unsigned char[]) {0x0F, 0x84}, caseLabel))
+            throw(dispatchEmitError);
+    }
+    if (!jitAssembler_emitJump(pAssembler, 1, (unsigned char[]) {0xE9}, pAssembler->declineLabel))
+        throw(dispatchEmitError);
+    
+    for (size_t i = 0; i < matrix.constructorCount; i++) {
+        if (pRules[i].kind == UNSPECIFIED_EXPRESSION)
+            continue;
+        jitAssembler_placeLabel(pAssembler, firstCaseLabel + i);
+        pAssembler->emitter.typeIndex = pFunction->typeIndex;
+        pAssembler->emitter.constructorIndex = i;
+        pAssembler->emitter.destructorIndex = pFunction->destructorIndex;
+        pAssembler->slotCount = 1 + destructor.parameterCount;
+        Expression rule = pRules[i];
+        if (rule.kind == EVALUATION_EXPRESSION && ((Evaluation*) rule.pData)->kind == DESTRUCTION_EVALUATION) {
+            size_t typeIndex;
+            if (!jitAssembler_emitEvaluation(pAssembler, *(Evaluation*) rule.pData, 0, true, &typeIndex))
+                throw(ruleEmitError);
+            continue;
+        }
+        size_t slot = jitAssembler_allocateSlots(pAssembler, 1);
+        if (!jitAssembler_emitExpression(pAssembler, rule, slot))
+            throw(ruleEmitError);
+        for (size_t j = 0; j < 2; j++) {
+            if (!jitAssembler_emit(pAssembler, 4, (unsigned char[]) {0x48, 0x8B, 0x84, 0x24}))
+                throw(ruleEmitError);
+            if (!jitAssembler_emitImmediate32(pAssembler, (uint32_t) (slot * sizeof(Expression) + 8 * j)))
+                throw(ruleEmitError);
+            if (!jitAssembler_emit(pAssembler, 4, (unsigned char[]) {0x49, 0x89, 0x45, (unsigned char) (8 * j)}))
+                throw(ruleEmitError);
+        }
+        if (!jitAssembler_emitJump(pAssembler, 1, (unsigned char[]) {0xE9}, pAssembler->doneLabel))
+            throw(ruleEmitError);
+    }
+    
+    jitAssembler_placeLabel(pAssembler, pAssembler->declineLabel);
+    if (!jitAssembler_emit(pAssembler, 1, (unsigned char[]) {0xB8}) || !jitAssembler_emitImmediate32(pAssembler, NATIVE_DECLINED))
+        throw(epilogueEmitError);
+    if (!jitAssembler_emitJump(pAssembler, 1, (unsigned char[]) {0xE9}, pAssembler->epilogueLabel))
+        throw(epilogueEmitError);
+    jitAssembler_placeLabel(pAssembler, pAssembler->failedLabel);
+    if (!jitAssembler_emit(pAssembler, 1, (unsigned char[]) {0xB8}) || !jitAssembler_emitImmediate32(pAssembler, NATIVE_FAILED))
+        throw(epilogueEmitError);
+    if (!jitAssembler_emitJump(pAssembler, 1, (unsigned char[]) {0xE9}, pAssembler->epilogueLabel))
+        throw(epilogueEmitError);
+    jitAssembler_placeLabel(pAssembler, pAssembler->doneLabel);
+    if (!jitAssembler_emit(pAssembler, 1, (unsigned char[]) {0xB8}) || !jitAssembler_emitImmediate32(pAssembler, NATIVE_DONE))
+        throw(epilogueEmitError);
+    jitAssembler_placeLabel(pAssembler, pAssembler->epilogueLabel);
+    if (!jitAssembler_emit(pAssembler, 11, (unsigned char[]) {
+        0x48, 0x8D, 0x65, 0xE8, 0x41, 0x5E, 0x41, 0x5D, 0x41, 0x5C, 0x5D
+    }))
+        throw(epilogueEmitError);
+    if (!jitAssembler_emit(pAssembler, 1, (unsigned char[]) {0xC3}))
+        throw(epilogueEmitError);
+    
+    jitAssembler_placeLabel(pAssembler, fallbackLabel);
+    if (!jitAssembler_emit(pAssembler, 2, (unsigned char[]) {0x48, 0xB8}))
+        throw(fallbackEmitError);
+    if (!jitAssembler_emitImmediate64(pAssembler, (uint64_t) (uintptr_t) &jit.isStackExhausted))
+        throw(fallbackEmitError);
+    if (!jitAssembler_emit(pAssembler, 3, (unsigned char[]) {0xC6, 0x00, 0x01}))
+        throw(fallbackEmitError);
+    if (!jitAssembler_emitJump(pAssembler, 1, (unsigned char[]) {0xE9}, pAssembler->declineLabel))
+        throw(fallbackEmitError);
+    
+    uint32_t frameSize = (uint32_t) (pAssembler->frameSlotCount * sizeof(Expression) + 8);
+    memcpy(&pAssembler->pData[frameSizePosition], &frameSize, sizeof(uint32_t));
+    return true;
+    
+fallbackEmitError:
+epilogueEmitError:
+ruleEmitError:
+dispatchEmitError:
+prologueEmitError:
+labelCreateError:
+    return false;
+}
+bool createIncludeCache(char const* pDirectoryName, IncludeCache* pCache) {
+    if (mkdir(pDirectoryName, 0777) == -1 && errno != EEXIST)
+        throw(directoryCreateError);
+    char* pPath = realpath(pDirectoryName, NULL);
+    if (pPath == NULL)
+        throw(directoryCreateError);
+    
+    *pCache = (IncludeCache) {
+        .pDirectoryName = pPath,
+        .dependencyCount = 0,
+        .dependencyCapacity = 0,
+        .pDependencies = NULL,
+        .printCount = 0,
+        .fileDepth = 0,
+        .hitCount = 0,
+        .missCount = 0,
+        .staleCount = 0,
+        .storeCount = 0
+    };
+    return true;
+    
+directoryCreateError:
+    fprintf(stderr, "Unable to create cache directory %s\n", pDirectoryName);
+    return false;
+}
+void destroyIncludeCache(IncludeCache cache) {
+    for (size_t i = 0; i < cache.dependencyCount; i++)
+        destroyString(cache.pDependencies[i].path);
+    free(cache.pDependencies);
+    free(cache.pDirectoryName);
+}
+bool includeCache_appendDependency(String path, uint64_t contentHash) {
+    if (includeCache.dependencyCount == includeCache.dependencyCapacity) {
+        size_t dependencyCapacity = includeCache.dependencyCapacity == 0 ? 16 : 2 * includeCache.dependencyCapacity;
+        Dependency* pNewDependencies = realloc(
+            includeCache.pDependencies, dependencyCapacity * sizeof(Dependency)
+        );
+        if (pNewDependencies == NULL)
+            throw(dependenciesReallocError);
+        includeCache.pDependencies = pNewDependencies;
+        includeCache.dependencyCapacity = dependencyCapacity;
+    }
+    includeCache.pDependencies[includeCache.dependencyCount] = (Dependency) {
+        .path = path,
+        .contentHash = contentHash
+    };
+    includeCache.dependencyCount++;
+    return true;
+    
+dependenciesReallocError:
+    return false;
+}
+bool includeCache_getEntryFileName(
+    uint64_t contentHash, uint64_t pathHash, uint64_t fingerprint, size_t depth, char** ppFileName
+) {
+    uint64_t key = hash_combine(hash_combine(hash_combine(contentHash, pathHash), fingerprint), depth);
+    size_t length = strlen(includeCache.pDirectoryName) + 1 + 16 + strlen(".indcache") + 1;
+    char* pFileName = malloc(length);
+    if (pFileName == NULL)
+        throw(fileNameMallocError);
+    snprintf(pFileName, length, "%s/%016llx.indcache", includeCache.pDirectoryName, (unsigned long long) key);
+    *ppFileName = pFileName;
+    return true;
+    
+fileNameMallocError:
+    return false;
+}
+bool includeCache_isFresh(char* pEntry, CacheHeader header) {
+    CacheDependency* pDependencies = (CacheDependency*) (uintptr_t) header.dependenciesOffset;
+    if (!image_relocate(
+        pEntry, header.length, header.dependencyCount, sizeof(CacheDependency), (void**) &pDependencies
+    ))
+        return false;
+    for (size_t i = 0; i < header.dependencyCount; i++) {
+        ImageString path = pDependencies[i].path;
+        if (path.offset > header.length || path.length >= header.length - path.offset || pEntry[path.offset + path.length] != '\0')
+            return false;
+        if (access(&pEntry[path.offset], R_OK) == -1)
+            return false;
+        Parser parser;
+        if (!createParserFromFile(CURRENT_DIRECTORY, &pEntry[path.offset], &parser))
+            return false;
+        uint64_t contentHash = string_hash((String) {.length = parser.length, .pData = parser.pData});
+        destroyParser(parser);
+        if (contentHash != pDependencies[i].contentHash)
+            return false;
+    }
+    
+    CacheOperation* pOperations = (CacheOperation*) (uintptr_t) header.operationsOffset;
+    if (!image_relocate(
+        pEntry, header.length, header.operationCount, sizeof(CacheOperation), (void**) &pOperations
+    ))
+        return false;
+    size_t operationsOffset = (char*) pOperations - pEntry;
+    for (size_t i = 0; i < header.operationCount; i++) {
+        CacheOperation* pOperation = &pOperations[i];
+        if (pOperation->name.offset > header.length || pOperation->name.length >= header.length - pOperation->name.offset)
+            return false;
+        if (pOperation->kind == CONSTRUCTOR_OPERATION || pOperation->kind == DESTRUCTOR_OPERATION) {
+            if (!image_relocateExpressions(
+                pEntry, operationsOffset, pOperation->parameterCount, false, &pOperation->pParameterTypes
+            ))
+                return false;
+        }
+        if (pOperation->kind == DESTRUCTOR_OPERATION || pOperation->kind == RULE_OPERATION) {
+            if (!image_relocateExpression(pEntry, operationsOffset, false, &pOperation->expression))
+                return false;
+        }
+        if (pOperation->kind > NAMESPACE_OPERATION)
+            return false;
+    }
+    return true;
+}
+bool includeCache_duplicateExpressions(size_t count, Expression const* pExpressions, Expression** ppResult) {
+    Expression* pResult = malloc(count * sizeof(Expression));
+    if (pResult == NULL)
+        throw(resultMallocError);
+    size_t duplicateCount;
+    for (duplicateCount = 0; duplicateCount < count; duplicateCount++) {
+        if (!expression_duplicate(pExpressions[duplicateCount], &pResult[duplicateCount]))
+            throw(expressionDuplicateError);
+    }
+    *ppResult = pResult;
+    return true;
+    
+expressionDuplicateError:
+    free(pResult);
+resultMallocError:
+    return false;
+}
+bool includeCache_applyOperation(Module* pModule, char* pEntry, CacheOperation operation) {
+    Symbol name;
+    if (!symbol_intern((String) {.length = operation.name.length, .pData = &pEntry[operation.name.offset]}, &name))
+        throw(nameInternError);
+    if (operation.kind == NAMESPACE_OPERATION)
+        return module_endNamespace(pModule, operation.depth, name);
+    if (operation.typeIndex >= pModule->matrixCount)
+        throw(typeIndexError);
+    Matrix* pMatrix = &pModule->pMatrices[operation.typeIndex];
+    if (operation.kind == CONSTRUCTOR_OPERATION) {
+        if (operation.constructorIndex != pMatrix->constructorCount)
+            throw(constructorIndexError);
+        Expression* pParameterTypes;
+        if (!includeCache_duplicateExpressions(operation.parameterCount, operation.pParameterTypes, &pParameterTypes))
+            throw(constructorParameterTypesDuplicateError);
+        Constructor constructor = {
+            .depth = operation.depth,
+            .name = name,
+            .parameterCount = operation.parameterCount,
+            .pParameterTypes = pParameterTypes
+        };
+        if (!module_addConstructor(pModule, operation.typeIndex, constructor))
+            throw(constructorAddError);
+        return true;
+    
+    constructorAddError:
+        free(pParameterTypes);
+    constructorParameterTypesDuplicateError:
+    constructorIndexError:
+        return false;
+    }
+    if (operation.kind == DESTRUCTOR_OPERATION) {
+        if (operation.destructorIndex != pMatrix->destructorCount)
+            throw(destructorIndexError);
+        Expression* pParameterTypes;
+        if (!includeCache_duplicateExpressions(operation.parameterCount, operation.pParameterTypes, &pParameterTypes))
+            throw(destructorParameterTypesDuplicateError);
+        Expression returnType;
+        if (!expression_duplicate(operation.expression, &returnType))
+            throw(destructorReturnTypeDuplicateError);
+        Destructor destructor = {
+            .depth = operation.depth,
+            .name = name,
+            .parameterCount = operation.parameterCount,
+            .pParameterTypes = pParameterTypes,
+            .returnType = returnType
+        };
+        if (!module_addDestructor(pModule, operation.typeIndex, destructor))
+            throw(destructorAddError);
+        return true;
+    
+    destructorAddError:
+    destructorReturnTypeDuplicateError:
+        free(pParameterTypes);
+    destructorParameterTypesDuplicateError:
+    destructorIndexError:
+        return false;
+    }
+    if (operation.destructorIndex >= pMatrix->destructorCount || operation.constructorIndex >= pMatrix->constructorCount)
+        throw(ruleIndexError);
+    if (matrix_getRules(*pMatrix, operation.destructorIndex)[operation.constructorIndex].kind != UNSPECIFIED_EXPRESSION)
+        throw(ruleIndexError);
+    Expression rule;
+    if (!expression_duplicate(operation.expression, &rule))
+        throw(ruleDuplicateError);
+    if (!module_setRule(pModule, operation.typeIndex, operation.destructorIndex, operation.constructorIndex, rule))
+        throw(ruleSetError);
+    return true;
+    
+ruleSetError:
+ruleDuplicateError:
+ruleIndexError:
+typeIndexError:
+nameInternError:
+    return false;
+}
+bool includeCache_replay(Module* pModule, uint64_t contentHash, uint64_t pathHash, size_t depth, bool* pIsHit) {
+    char* pFileName;
+    if (!includeCache_getEntryFileName(contentHash, pathHash, pModule->fingerprint, depth, &pFileName))
+        throw(fileNameGetError);
+    int fileDescriptor = open(pFileName, O_RDONLY);
+    free(pFileName);
+    if (fileDescriptor == -1) {
+        includeCache.missCount++;
+        *pIsHit = false;
+        return true;
+    }
+    struct stat fileStat;
+    if (fstat(fileDescriptor, &fileStat) == -1 || (size_t) fileStat.st_size < sizeof(CacheHeader)) {
+        close(fileDescriptor);
+        includeCache.staleCount++;
+        includeCache.missCount++;
+        *pIsHit = false;
+        return true;
+    }
+    size_t length = (size_t) fileStat.st_size;
+    char* pEntry = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE, fileDescriptor, 0);
+    close(fileDescriptor);
+    if (pEntry == MAP_FAILED)
+        throw(entryMapError);
+    
+    CacheHeader header;
+    memcpy(&header, pEntry, sizeof(CacheHeader));
+    if (
+        memcmp(header.pMagic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 || header.version != CACHE_VERSION
+        || header.layout != image_getLayout() || header.length != length
+        || header.checksum != image_checksum(&pEntry[sizeof(CacheHeader)], length - sizeof(CacheHeader))
+        || header.contentHash != contentHash || header.pathHash != pathHash
+        || header.fingerprint != pModule->fingerprint || header.depth != depth
+        || header.printedOffset > length || header.printedLength > length - header.printedOffset
+        || !includeCache_isFresh(pEntry, header)
+    ) {
+        munmap(pEntry, length);
+        includeCache.staleCount++;
+        includeCache.missCount++;
+        *pIsHit = false;
+        return true;
+    }
+    
+    CacheOperation* pOperations = (CacheOperation*) &pEntry[header.operationsOffset];
+    for (size_t i = 0; i < header.operationCount; i++) {
+        if (!includeCache_applyOperation(pModule, pEntry, pOperations[i]))
+            throw(operationApplyError);
+    }
+    if (pModule->fingerprint != header.resultFingerprint)
+        throw(fingerprintError);
+    if (!output_write(&output, &pEntry[header.printedOffset], header.printedLength) || !output_sync(&output))
+        throw(printedWriteError);
+    if (header.printedLength > 0)
+        includeCache.printCount++;
+    
+    CacheDependency* pDependencies = (CacheDependency*) &pEntry[header.dependenciesOffset];
+    for (size_t i = 0; i < header.dependencyCount; i++) {
+        ImageString path = pDependencies[i].path;
+        String pathCopy;
+        if (!string_duplicate((String) {.length = path.length, .pData = &pEntry[path.offset]}, &pathCopy))
+            throw(dependencyAppendError);
+        if (!includeCache_appendDependency(pathCopy, pDependencies[i].contentHash)) {
+            destroyString(pathCopy);
+            throw(dependencyAppendError);
+        }
+    }
+    
+    munmap(pEntry, length);
+    includeCache.hitCount++;
+    *pIsHit = true;
+    return true;
+    
+dependencyAppendError:
+printedWriteError:
+fingerprintError:
+operationApplyError:
+    munmap(pEntry, length);
+entryMapError:
+fileNameGetError:
+    return false;
+}
+bool includeCache_store(
+    Module module, uint64_t contentHash, uint64_t pathHash, uint64_t fingerprint, size_t depth,
+    size_t operationStart, size_t dependencyStart, String printed
+) {
+    ImageWriter writer = {
+        .length = 0,
+        .capacity = 0,
+        .pData = NULL
+    };
+    size_t headerOffset;
+    if (!imageWriter_reserve(&writer, sizeof(CacheHeader), &headerOffset))
+        throw(headerReserveError);
+    
+    size_t dependencyCount = includeCache.dependencyCount - dependencyStart;
+    CacheDependency* pDependencies = malloc(dependencyCount * sizeof(CacheDependency));
+    if (pDependencies == NULL)
+        throw(dependenciesMallocError);
+    for (size_t i = 0; i < dependencyCount; i++) {
+        Dependency dependency = includeCache.pDependencies[dependencyStart + i];
+        size_t offset;
+        if (!imageWriter_write(&writer, dependency.path.pData, dependency.path.length + 1, &offset))
+            throw(dependencyWriteError);
+        pDependencies[i] = (CacheDependency) {
+            .path = {
+                .offset = offset,
+                .length = dependency.path.length
+            },
+            .contentHash = dependency.contentHash
+        };
+    }
+    size_t dependenciesOffset;
+    if (!imageWriter_write(&writer, pDependencies, dependencyCount * sizeof(CacheDependency), &dependenciesOffset))
+        throw(dependencyWriteError);
+    
+    size_t operationCount = module.operationCount - operationStart;
+    CacheOperation* pOperations = malloc(operationCount * sizeof(CacheOperation));
+    if (pOperations == NULL)
+        throw(operationsMallocError);
+    for (size_t i = 0; i < operationCount; i++) {
+        Operation operation = module.pOperations[operationStart + i];
+        String name = symbol_getString(operation.name);
+        size_t nameOffset;
+        if (!imageWriter_write(&writer, name.pData, name.length + 1, &nameOffset))
+            throw(operationWriteError);
+        CacheOperation cacheOperation = {
+            .kind = operation.kind,
+            .typeIndex = operation.typeIndex,
+            .destructorIndex = operation.destructorIndex,
+            .constructorIndex = operation.constructorIndex,
+            .depth = operation.depth,
+            .name = {
+                .offset = nameOffset,
+                .length = name.length
+            },
+            .parameterCount = 0,
+            .pParameterTypes = NULL,
+            .expression = {
+                .kind = UNSPECIFIED_EXPRESSION,
+                .pData = NULL
+            }
+        };
+        Matrix matrix = module.pMatrices[operation.typeIndex];
+        size_t parameterTypesOffset = 0;
+        if (operation.kind == CONSTRUCTOR_OPERATION) {
+            Constructor constructor = matrix.pConstructors[operation.constructorIndex];
+            cacheOperation.parameterCount = constructor.parameterCount;
+            if (!imageWriter_writeExpressions(
+                &writer, constructor.parameterCount, constructor.pParameterTypes, &parameterTypesOffset
+            ))
+                throw(operationWriteError);
+        }
+        if (operation.kind == DESTRUCTOR_OPERATION) {
+            Destructor destructor = matrix.pDestructors[operation.destructorIndex];
+            cacheOperation.parameterCount = destructor.parameterCount;
+            if (!imageWriter_writeExpressions(
+                &writer, destructor.parameterCount, destructor.pParameterTypes, &parameterTypesOffset
+            ))
+                throw(operationWriteError);
+            if (!imageWriter_writeExpression(&writer, destructor.returnType, &cacheOperation.expression))
+                throw(operationWriteError);
+        }
+        if (operation.kind == RULE_OPERATION) {
+            Expression rule = matrix_getRules(matrix, operation.destructorIndex)[operation.constructorIndex];
+            if (!imageWriter_writeExpression(&writer, rule, &cacheOperation.expression))
+                throw(operationWriteError);
+        }
+        cacheOperation.pParameterTypes = (Expression*) (uintptr_t) parameterTypesOffset;
+        pOperations[i] = cacheOperation;
+    }
+    size_t operationsOffset;
+    if (!imageWriter_write(&writer, pOperations, operationCount * sizeof(CacheOperation), &operationsOffset))
+        throw(operationWriteError);
+    size_t printedOffset;
+    if (!imageWriter_write(&writer, printed.pData, printed.length, &printedOffset))
+        throw(operationWriteError);
+    
+    CacheHeader header = {
+        .version = CACHE_VERSION,
+        .layout = image_getLayout(),
+        .length = writer.length,
+        .checksum = image_checksum(&writer.pData[sizeof(CacheHeader)], writer.length - sizeof(CacheHeader)),
+        .contentHash = contentHash,
+        .pathHash = pathHash,
+        .fingerprint = fingerprint,
+        .depth = depth,
+        .resultFingerprint = module.fingerprint,
+        .dependencyCount = dependencyCount,
+        .dependenciesOffset = dependenciesOffset,
+        .operationCount = operationCount,
+        .operationsOffset = operationsOffset,
+        .printedLength = printed.length,
+        .printedOffset = printedOffset
+    };
+    memcpy(header.pMagic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    memcpy(&writer.pData[headerOffset], &header, sizeof(CacheHeader));
+    
+    char* pFileName;
+    if (!includeCache_getEntryFileName(contentHash, pathHash, fingerprint, depth, &pFileName))
+        throw(fileNameGetError);
+    size_t temporaryLength = strlen(pFileName) + 32;
+    char* pTemporaryFileName = malloc(temporaryLength);
+    if (pTemporaryFileName == NULL)
+        throw(temporaryFileNameMallocError);
+    snprintf(pTemporaryFileName, temporaryLength, "%s.%ld.tmp", pFileName, (long) getpid());
+    FILE* pFile = fopen(pTemporaryFileName, "wb");
+    if (pFile == NULL)
+        throw(fileOpenError);
+    if (fwrite(writer.pData, 1, writer.length, pFile) != writer.length)
+        throw(fileWriteError);
+    if (fclose(pFile) == EOF)
+        throw(fileCloseError);
+    if (rename(pTemporaryFileName, pFileName) == -1)
+        throw(fileCloseError);
+    
+    includeCache.storeCount++;
+    free(pTemporaryFileName);
+    free(pFileName);
+    free(pOperations);
+    free(pDependencies);
+    free(writer.pData);
+    return true;
+    
+fileWriteError:
+    fclose(pFile);
+fileCloseError:
+    remove(pTemporaryFileName);
+fileOpenError:
+    free(pTemporaryFileName);
+temporaryFileNameMallocError:
+    free(pFileName);
+fileNameGetError:
+operationWriteError:
+    free(pOperations);
+operationsMallocError:
+dependencyWriteError:
+    free(pDependencies);
+dependenciesMallocError:
+headerReserveError:
+    free(writer.pData);
+    return false;
+}
+bool includeCache_endCapture(Output parentOutput, String* pPrinted) {
+    String printed;
+    bool isCaptured = output_getString(output, &printed);
+    destroyOutput(output);
+    output = parentOutput;
+    if (!isCaptured)
+        throw(printedGetError);
+    if (!string_print(printed, &output) || !output_sync(&output))
+        throw(printedWriteError);
+    *pPrinted = printed;
+    return true;
+    
+printedWriteError:
+    destroyString(printed);
+printedGetError:
+    return false;
+}
+void includeCache_printStatistics(void) {
+    fprintf(
+        stderr, "Include cache: %lu hits, %lu misses (%lu stale), %lu stored\n",
+        includeCache.hitCount, includeCache.missCount, includeCache.staleCount, includeCache.storeCount
+    );
+}
+#ifdef __linux__
+bool createWatch(Watch* pWatch) {
+    int inotifyDescriptor = inotify_init1(IN_CLOEXEC);
+    if (inotifyDescriptor == -1)
+        throw(inotifyInitError);
+    
+    *pWatch = (Watch) {
+        .isEnabled = true,
+        .inotifyDescriptor = inotifyDescriptor,
+        .checkpointCount = 0,
+        .checkpointCapacity = 0,
+        .pCheckpoints = NULL,
+        .fileCount = 0,
+        .fileCapacity = 0,
+        .pFiles = NULL,
+        .directoryCount = 0,
+        .directoryCapacity = 0,
+        .pDirectories = NULL,
+        .activeCheckpoint = NO_CHECKPOINT,
+        .resumeOffset = 0,
+        .namespaceCount = 0,
+        .namespaceCapacity = 0,
+        .pNamespaces = NULL
+    };
+    return true;
+    
+inotifyInitError:
+    return false;
+}
+#else
+bool createWatch(Watch* pWatch) {
+    (void) pWatch;
+    fprintf(stderr, "Watch mode is unsupported on this platform\n");
+    return false;
+}
+#endif
+void destroyWatch(Watch watchState) {
+    for (size_t i = 0; i < watchState.checkpointCount; i++)
+        destroyCheckpoint(watchState.pCheckpoints[i]);
+    free(watchState.pCheckpoints);
+    for (size_t i = 0; i < watchState.fileCount; i++)
+        destroyString(watchState.pFiles[i].path);
+    free(watchState.pFiles);
+    for (size_t i = 0; i < watchState.directoryCount; i++)
+        destroyString(watchState.pDirectories[i].path);
+    free(watchState.pDirectories);
+    free(watchState.pNamespaces);
+    close(watchState.inotifyDescriptor);
+}
+void destroyCheckpoint(Checkpoint checkpoint) {
+    free(checkpoint.fileName.pData);
+    free(checkpoint.directoryName.pData);
+    free(checkpoint.path.pData);
+    free(checkpoint.pNamespaces);
+}
+bool file_hash(char const* pFileName, uint64_t* pHash) {
+    Parser parser;
+    if (!createParserFromFile(CURRENT_DIRECTORY, pFileName, &parser))
+        throw(parserCreateError);
+    *pHash = string_hash((String) {.length = parser.length, .pData = parser.pData});
+    destroyParser(parser);
+    return true;
+    
+parserCreateError:
+    return false;
+}
+bool watch_setNamespaces(size_t namespaceCount, Symbol const* pNamespaces) {
+    if (namespaceCount > watch.namespaceCapacity) {
+        Symbol* pNewNamespaces = realloc(watch.pNamespaces, namespaceCount * sizeof(Symbol));
+        if (pNewNamespaces == NULL)
+            throw(namespacesReallocError);
+        watch.pNamespaces = pNewNamespaces;
+        watch.namespaceCapacity = namespaceCount;
+    }
+    memcpy(watch.pNamespaces, pNamespaces, namespaceCount * sizeof(Symbol));
+    watch.namespaceCount = namespaceCount;
+    return true;
+    
+namespacesReallocError:
+    return false;
+}
+bool watch_pushNamespace(Symbol namespace) {
+    if (watch.namespaceCount == watch.namespaceCapacity) {
+        size_t namespaceCapacity = watch.namespaceCapacity == 0 ? 8 : 2 * watch.namespaceCapacity;
+        Symbol* pNewNamespaces = realloc(watch.pNamespaces, namespaceCapacity * sizeof(Symbol));
+        if (pNewNamespaces == NULL)
+            throw(namespacesReallocError);
+        watch.pNamespaces = pNewNamespaces;
+        watch.namespaceCapacity = namespaceCapacity;
+    }
+    watch.pNamespaces[watch.namespaceCount] = namespace;
+    watch.namespaceCount++;
+    return true;
+    
+namespacesReallocError:
+    return false;
+}
+bool watch_addFile(String path, uint64_t contentHash, size_t checkpointIndex) {
+    if (watch.fileCount == watch.fileCapacity) {
+        size_t fileCapacity = watch.fileCapacity == 0 ? 16 : 2 * watch.fileCapacity;
+        WatchedFile* pNewFiles = realloc(watch.pFiles, fileCapacity * sizeof(WatchedFile));
+        if (pNewFiles == NULL)
+            throw(filesReallocError);
+        watch.pFiles = pNewFiles;
+        watch.fileCapacity = fileCapacity;
+    }
+    watch.pFiles[watch.fileCount] = (WatchedFile) {
+        .path = path,
+        .contentHash = contentHash,
+        .checkpointIndex = checkpointIndex,
+        .isChanged = false
+    };
+    watch.fileCount++;
+    return true;
+    
+filesReallocError:
+    return false;
+}
+bool watch_addCheckpoint(Directory directory, char const* pFileName, size_t depth, Module module, uint64_t contentHash) {
+    if (watch.checkpointCount == watch.checkpointCapacity) {
+        size_t checkpointCapacity = watch.checkpointCapacity == 0 ? 16 : 2 * watch.checkpointCapacity;
+        Checkpoint* pNewCheckpoints = realloc(watch.pCheckpoints, checkpointCapacity * sizeof(Checkpoint));
+        if (pNewCheckpoints == NULL)
+            throw(checkpointsReallocError);
+        watch.pCheckpoints = pNewCheckpoints;
+        watch.checkpointCapacity = checkpointCapacity;
+    }
+    String fileName;
+    if (!createStringFromCString(pFileName, &fileName))
+        throw(fileNameCreateError);
+    String directoryName;
+    if (!string_duplicate(directory.path, &directoryName))
+        throw(directoryNameDuplicateError);
+    char* pPath;
+    if (!directory_resolve(directory, pFileName, &pPath))
+        throw(pathResolveError);
+    String path = {.length = strlen(pPath), .pData = pPath};
+    String watchedPath;
+    if (!string_duplicate(path, &watchedPath))
+        throw(watchedPathDuplicateError);
+    Symbol* pNamespaces = malloc(watch.namespaceCount * sizeof(Symbol));
+    if (pNamespaces == NULL)
+        throw(namespacesMallocError);
+    memcpy(pNamespaces, watch.pNamespaces, watch.namespaceCount * sizeof(Symbol));
+    if (!watch_addFile(watchedPath, contentHash, watch.checkpointCount))
+        throw(fileAddError);
+    
+    watch.pCheckpoints[watch.checkpointCount] = (Checkpoint) {
+        .fileName = fileName,
+        .directoryName = directoryName,
+        .path = path,
+        .contentHash = contentHash,
+        .depth = depth,
+        .parentIndex = watch.activeCheckpoint,
+        .resumeOffset = watch.resumeOffset,
+        .namespaceCount = watch.namespaceCount,
+        .pNamespaces = pNamespaces,
+        .operationCount = module.operationCount,
+        .fingerprint = module.fingerprint
+    };
+    watch.checkpointCount++;
+    return true;
+    
+fileAddError:
+    free(pNamespaces);
+namespacesMallocError:
+    destroyString(watchedPath);
+watchedPathDuplicateError:
+    free(pPath);
+pathResolveError:
+    destroyString(directoryName);
+directoryNameDuplicateError:
+    destroyString(fileName);
+fileNameCreateError:
+checkpointsReallocError:
+    return false;
+}
+void watch_truncate(size_t checkpointIndex) {
+    while (watch.checkpointCount > checkpointIndex) {
+        watch.checkpointCount--;
+        destroyCheckpoint(watch.pCheckpoints[watch.checkpointCount]);
+    }
+    while (watch.fileCount > 0 && watch.pFiles[watch.fileCount - 1].checkpointIndex >= checkpointIndex) {
+        watch.fileCount--;
+        destroyString(watch.pFiles[watch.fileCount].path);
+    }
+}
+#ifdef __linux__
+bool watch_watchDirectories(void) {
+    for (size_t i = 0; i < watch.fileCount; i++) {
+        String path = watch.pFiles[i].path;
+        char* pSeparator = strrchr(path.pData, '/');
+        String directoryName = {
+            .length = pSeparator == path.pData ? 1 : (size_t) (pSeparator - path.pData),
+            .pData = path.pData
+        };
+        bool isWatched = false;
+        for (size_t j = 0; j < watch.directoryCount && !isWatched; j++)
+            isWatched = string_equals(watch.pDirectories[j].path, directoryName);
+        if (isWatched)
+            continue;
+        
+        if (watch.directoryCount == watch.directoryCapacity) {
+            size_t directoryCapacity = watch.directoryCapacity == 0 ? 8 : 2 * watch.directoryCapacity;
+            WatchedDirectory* pNewDirectories = realloc(
+                watch.pDirectories, directoryCapacity * sizeof(WatchedDirectory)
+            );
+            if (pNewDirectories == NULL)
+                throw(directoriesReallocError);
+            watch.pDirectories = pNewDirectories;
+            watch.directoryCapacity = directoryCapacity;
         }
-        throw(declarationParseError);
+        String directoryPath;
+        if (!string_duplicate(directoryName, &directoryPath))
+            throw(directoryPathDuplicateError);
+        int descriptor = inotify_add_watch(watch.inotifyDescriptor, directoryPath.pData, WATCH_EVENT_MASK);
+        if (descriptor == -1) {
+            destroyString(directoryPath);
+            throw(directoryWatchError);
+        }
+        watch.pDirectories[watch.directoryCount] = (WatchedDirectory) {
+            .descriptor = descriptor,
+            .path = directoryPath
+        };
+        watch.directoryCount++;
+    }
+    return true;
     
-    declarationParseSuccess:
-        if (pParser->next != ';')
-            throw(declarationEndError);
-        parser_advance(pParser);
-        parser_skipWhitespace(pParser);
-        for (size_t i = 0; i < typeParameterCount; i++)
-            destroyString(pTypeParameters[i].name);
-        free(pTypeParameters);
-        return true;
+directoryWatchError:
+directoryPathDuplicateError:
+directoriesReallocError:
+    return false;
+}
+bool watch_markChanged(char const* pEvents, size_t length) {
+    size_t offset = 0;
+    while (offset + sizeof(struct inotify_event) <= length) {
+        struct inotify_event const* pEvent = (struct inotify_event const*) &pEvents[offset];
+        offset += sizeof(struct inotify_event) + pEvent->len;
+        if (pEvent->mask & IN_Q_OVERFLOW) {
+            for (size_t i = 0; i < watch.fileCount; i++)
+                watch.pFiles[i].isChanged = true;
+            continue;
+        }
+        if (pEvent->len == 0)
+            continue;
+        
+        String directoryName = {.length = 0, .pData = NULL};
+        for (size_t i = 0; i < watch.directoryCount; i++) {
+            if (watch.pDirectories[i].descriptor == pEvent->wd)
+                directoryName = watch.pDirectories[i].path;
+        }
+        if (directoryName.pData == NULL)
+            continue;
+        size_t nameLength = strlen(pEvent->name);
+        for (size_t i = 0; i < watch.fileCount; i++) {
+            String path = watch.pFiles[i].path;
+            size_t separatorLength = directoryName.length == 1 ? 0 : 1;
+            if (
+                path.length == directoryName.length + separatorLength + nameLength
+                && memcmp(path.pData, directoryName.pData, directoryName.length) == 0
+                && strcmp(&path.pData[directoryName.length + separatorLength], pEvent->name) == 0
+            )
+                watch.pFiles[i].isChanged = true;
+        }
+    }
+    return true;
+}
+bool watch_waitForChange(size_t* pCheckpointIndex) {
+    char pEvents[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+    while (true) {
+        if (!watch_watchDirectories())
+            throw(directoriesWatchError);
+        ssize_t length = read(watch.inotifyDescriptor, pEvents, sizeof(pEvents));
+        if (length == -1 && errno == EINTR)
+            continue;
+        if (length <= 0)
+            throw(eventsReadError);
+        watch_markChanged(pEvents, (size_t) length);
+        
+        struct pollfd pollDescriptor = {
+            .fd = watch.inotifyDescriptor,
+            .events = POLLIN
+        };
+        while (poll(&pollDescriptor, 1, WATCH_SETTLE_MILLISECONDS) > 0) {
+            length = read(watch.inotifyDescriptor, pEvents, sizeof(pEvents));
+            if (length <= 0)
+                break;
+            watch_markChanged(pEvents, (size_t) length);
+        }
+        
+        size_t checkpointIndex = NO_CHECKPOINT;
+        for (size_t i = 0; i < watch.fileCount; i++) {
+            WatchedFile* pFile = &watch.pFiles[i];
+            if (!pFile->isChanged)
+                continue;
+            pFile->isChanged = false;
+            uint64_t contentHash;
+            if (file_hash(pFile->path.pData, &contentHash) && contentHash == pFile->contentHash)
+                continue;
+            if (pFile->checkpointIndex < checkpointIndex)
+                checkpointIndex = pFile->checkpointIndex;
+        }
+        if (checkpointIndex != NO_CHECKPOINT) {
+            *pCheckpointIndex = checkpointIndex;
+            return true;
+        }
+    }
     
-    declarationEndError:
-    declarationParseError:
-    typeParametersParseError:
-        for (size_t i = 0; i < typeParameterCount; i++)
-            destroyString(pTypeParameters[i].name);
-        free(pTypeParameters);
-    typeParametersMallocError:
-    typeNameError:
-        destroyString(typeName);
-    typeNameParseError:
-        return false;
+eventsReadError:
+directoriesWatchError:
+    return false;
+}
+#else
+bool watch_watchDirectories(void) {
+    return false;
+}
+bool watch_markChanged(char const* pEvents, size_t length) {
+    (void) pEvents;
+    (void) length;
+    return false;
+}
+bool watch_waitForChange(size_t* pCheckpointIndex) {
+    (void) pCheckpointIndex;
+    return false;
+}
+#endif
+bool watch_resumeFile(Module* pModule, size_t parentIndex, Checkpoint child) {
+    Checkpoint parent = watch.pCheckpoints[parentIndex];
+    size_t lineNumber;
+    size_t columnNumber;
+    
+    Directory directory;
+    if (!createDirectory(CURRENT_DIRECTORY, parent.directoryName.pData, &directory))
+        throw(directoryCreateError);
+    Parser parser;
+    if (!createParserFromFile(directory, parent.fileName.pData, &parser))
+        throw(parserCreateError);
+    if (child.resumeOffset > parser.length)
+        throw(resumeOffsetError);
+    parser.offset = child.resumeOffset;
+    parser.next = parser.offset < parser.length ? (unsigned char) parser.pData[parser.offset] : EOF;
+    watch.activeCheckpoint = parentIndex;
+    if (!watch_setNamespaces(child.namespaceCount, child.pNamespaces))
+        throw(namespacesSetError);
+    
+    size_t depth = parent.depth + child.namespaceCount - parent.namespaceCount;
+    while (depth > parent.depth) {
+        while (parser.next != EOF && parser.next != '}') {
+            if (!parser_parseStatement(&parser, pModule, depth))
+                throw(statementParseError);
+        }
+        watch.namespaceCount--;
+        if (!module_endNamespace(pModule, depth, watch.pNamespaces[watch.namespaceCount]))
+            throw(namespaceEndError);
+        if (parser.next != '}')
+            throw(namespaceEndError);
+        parser_advance(&parser);
+        parser_skipWhitespace(&parser);
+        depth--;
+    }
+    while (parser.next != EOF) {
+        if (!parser_parseStatement(&parser, pModule, depth))
+            throw(statementParseError);
     }
+    
+    destroyParser(parser);
+    destroyDirectory(directory);
+    return true;
+    
+statementParseError:
+    parser_seekFailure(&parser);
+    parser_getLocation(parser, &lineNumber, &columnNumber);
+    fprintf(
+        stderr, "Error encountered at %s/%s:%lu:%lu\n",
+        directory.path.pData, parent.fileName.pData, lineNumber, columnNumber
+    );
+namespaceEndError:
+namespacesSetError:
+resumeOffsetError:
+    destroyParser(parser);
+parserCreateError:
+    destroyDirectory(directory);
+directoryCreateError:
     return false;
 }
-bool module_endNamespace(Module* pModule, size_t depth, char const* pNamespace) {
-    size_t namespaceLength = strlen(pNamespace);
-    for (size_t i = 0; i < pModule->matrixCount; i++) {
-        Constructor typeConstructor = pModule->pMatrices[0].pConstructors[i];
-        Matrix matrix = pModule->pMatrices[i];
-        for (size_t j = 0; j < matrix.constructorCount; j++) {
-            Constructor* pConstructor = &matrix.pConstructors[j];
-            if (pConstructor->depth == depth && typeConstructor.depth < depth) {
-                String name = pConstructor->name;
-                size_t newNameLength = namespaceLength + 1 + name.length;
-                char* pNewNameData = malloc(newNameLength + 1);
-                if (pNewNameData == NULL)
-                    throw(newNameDataMallocError);
-                memcpy(pNewNameData, pNamespace, namespaceLength);
-                pNewNameData[namespaceLength] = ':';
-                memcpy(&pNewNameData[namespaceLength + 1], name.pData, name.length);
-                pNewNameData[newNameLength] = 0;
-                destroyString(name);
-                pConstructor->name = (String) {
-                    .length = newNameLength,
-                    .pData = pNewNameData
-                };
-            }
+void watch_printIncludeLocations(Checkpoint child) {
+    while (child.parentIndex != NO_CHECKPOINT) {
+        Checkpoint parent = watch.pCheckpoints[child.parentIndex];
+        Parser parser;
+        if (createParserFromFile(CURRENT_DIRECTORY, parent.path.pData, &parser)) {
+            size_t lineNumber;
+            size_t columnNumber;
+            parser.offset = child.resumeOffset < parser.length ? child.resumeOffset : parser.length;
+            parser_getLocation(parser, &lineNumber, &columnNumber);
+            fprintf(
+                stderr, "Error encountered at %s/%s:%lu:%lu\n",
+                parent.directoryName.pData, parent.fileName.pData, lineNumber, columnNumber
+            );
+            destroyParser(parser);
         }
-        for (size_t j = 0; j < matrix.destructorCount; j++) {
-            Destructor* pDestructor = &matrix.pDestructors[j];
-            if (pDestructor->depth == depth && typeConstructor.depth < depth) {
-                String name = pDestructor->name;
-                size_t newNameLength = namespaceLength + 1 + name.length;
-                char* pNewNameData = malloc(newNameLength + 1);
-                if (pNewNameData == NULL)
-                    throw(newNameDataMallocError);
-                memcpy(pNewNameData, pNamespace, namespaceLength);
-                pNewNameData[namespaceLength] = ':';
-                memcpy(&pNewNameData[namespaceLength + 1], name.pData, name.length);
-                pNewNameData[newNameLength] = 0;
-                destroyString(name);
-                pDestructor->name = (String) {
-                    .length = newNameLength,
-                    .pData = pNewNameData
-                };
-            }
+        child = parent;
+    }
+}
+bool watch_reparse(Module* pModule, size_t checkpointIndex) {
+    for (size_t i = watch.pCheckpoints[checkpointIndex].parentIndex; i != NO_CHECKPOINT; i = watch.pCheckpoints[i].parentIndex) {
+        uint64_t contentHash;
+        if (!file_hash(watch.pCheckpoints[i].path.pData, &contentHash) || contentHash != watch.pCheckpoints[i].contentHash)
+            checkpointIndex = i;
+    }
+    Checkpoint checkpoint = watch.pCheckpoints[checkpointIndex];
+    if (!module_rollback(pModule, checkpoint.operationCount, checkpoint.fingerprint))
+        throw(moduleRollbackError);
+    region_reset(&scratchRegion);
+    watch.pCheckpoints[checkpointIndex] = (Checkpoint) {
+        .fileName = {.length = 0, .pData = NULL},
+        .directoryName = {.length = 0, .pData = NULL},
+        .path = {.length = 0, .pData = NULL},
+        .pNamespaces = NULL
+    };
+    watch_truncate(checkpointIndex);
+    
+    if (!watch_setNamespaces(checkpoint.namespaceCount, checkpoint.pNamespaces))
+        throw(namespacesSetError);
+    watch.activeCheckpoint = checkpoint.parentIndex;
+    watch.resumeOffset = checkpoint.resumeOffset;
+    Directory directory;
+    if (!createDirectory(CURRENT_DIRECTORY, checkpoint.directoryName.pData, &directory))
+        throw(directoryCreateError);
+    Checkpoint child = checkpoint;
+    if (!parseFile(directory, checkpoint.fileName.pData, pModule, checkpoint.depth))
+        throw(fileParseError);
+    while (child.parentIndex != NO_CHECKPOINT) {
+        size_t parentIndex = child.parentIndex;
+        if (!watch_resumeFile(pModule, parentIndex, child))
+            throw(fileResumeError);
+        child = watch.pCheckpoints[parentIndex];
+    }
+    
+    watch.activeCheckpoint = NO_CHECKPOINT;
+    destroyDirectory(directory);
+    destroyCheckpoint(checkpoint);
+    return true;
+    
+fileResumeError:
+fileParseError:
+    watch_printIncludeLocations(child);
+    destroyDirectory(directory);
+directoryCreateError:
+namespacesSetError:
+    watch.activeCheckpoint = NO_CHECKPOINT;
+    destroyCheckpoint(checkpoint);
+moduleRollbackError:
+    return false;
+}
+bool watch_run(Directory directory, Module* pModule, bool isStatisticsEnabled) {
+    if (parseFile(directory, MAIN_FILE_NAME, pModule, 0))
+        module_validate(*pModule, 0);
+    if (!output_flush(&output))
+        throw(outputFlushError);
+    if (watch.checkpointCount == 0)
+        throw(mainFileError);
+    
+    while (true) {
+        size_t checkpointIndex;
+        if (!watch_waitForChange(&checkpointIndex))
+            throw(changeWaitError);
+        
+        struct timespec startTime;
+        clock_gettime(CLOCK_MONOTONIC, &startTime);
+        size_t checkpointCount = watch.checkpointCount;
+        if (watch_reparse(pModule, checkpointIndex))
+            module_validate(*pModule, 0);
+        if (!output_flush(&output))
+            throw(outputFlushError);
+        struct timespec endTime;
+        clock_gettime(CLOCK_MONOTONIC, &endTime);
+        
+        if (isStatisticsEnabled) {
+            double milliseconds = (endTime.tv_sec - startTime.tv_sec) * 1e3 + (endTime.tv_nsec - startTime.tv_nsec) / 1e6;
+            fprintf(
+                stderr, "Re-parsed from checkpoint %lu of %lu in %.3f ms\n",
+                checkpointIndex, checkpointCount, milliseconds
+            );
         }
     }
-    for (size_t i = 0; i < pModule->matrixCount; i++) {
-        Constructor typeConstructor = pModule->pMatrices[0].pConstructors[i];
-        Matrix matrix = pModule->pMatrices[i];
-        for (size_t j = 0; j < matrix.constructorCount; j++) {
-            Constructor* pConstructor = &matrix.pConstructors[j];
-            if (pConstructor->depth == depth)
-                pConstructor->depth--;
+    
+outputFlushError:
+changeWaitError:
+mainFileError:
+    return false;
+}
+bool createPrefetcher(size_t threadCount, Prefetcher* pPrefetcher) {
+    *pPrefetcher = (Prefetcher) {
+        .isEnabled = false,
+        .isStopping = false,
+        .threadCount = 0,
+        .pThreads = NULL,
+        .prefetchCount = 0,
+        .prefetchCapacity = 0,
+        .ppPrefetches = NULL,
+        .nextIndex = 0,
+        .bucketCount = 0,
+        .ppBuckets = NULL
+    };
+    if (threadCount == 0)
+        return true;
+    
+    pthread_t* pThreads = malloc(threadCount * sizeof(pthread_t));
+    if (pThreads == NULL)
+        throw(threadsMallocError);
+    if (pthread_mutex_init(&pPrefetcher->mutex, NULL) != 0)
+        throw(mutexInitError);
+    if (pthread_cond_init(&pPrefetcher->condition, NULL) != 0)
+        throw(conditionInitError);
+    pPrefetcher->isEnabled = true;
+    pPrefetcher->pThreads = pThreads;
+    for (size_t i = 0; i < threadCount; i++) {
+        if (pthread_create(&pThreads[i], NULL, prefetcher_work, NULL) != 0)
+            break;
+        pPrefetcher->threadCount++;
+    }
+    if (pPrefetcher->threadCount == 0)
+        throw(threadCreateError);
+    return true;
+    
+threadCreateError:
+    pPrefetcher->isEnabled = false;
+    pPrefetcher->pThreads = NULL;
+    pthread_cond_destroy(&pPrefetcher->condition);
+conditionInitError:
+    pthread_mutex_destroy(&pPrefetcher->mutex);
+mutexInitError:
+    free(pThreads);
+threadsMallocError:
+    return false;
+}
+void destroyPrefetcher(Prefetcher* pPrefetcher) {
+    if (!pPrefetcher->isEnabled)
+        return;
+    pthread_mutex_lock(&pPrefetcher->mutex);
+    pPrefetcher->isStopping = true;
+    pthread_cond_broadcast(&pPrefetcher->condition);
+    pthread_mutex_unlock(&pPrefetcher->mutex);
+    for (size_t i = 0; i < pPrefetcher->threadCount; i++)
+        pthread_join(pPrefetcher->pThreads[i], NULL);
+    free(pPrefetcher->pThreads);
+    
+    for (size_t i = 0; i < pPrefetcher->prefetchCount; i++)
+        destroyPrefetch(pPrefetcher->ppPrefetches[i]);
+    free(pPrefetcher->ppPrefetches);
+    free(pPrefetcher->ppBuckets);
+    pthread_cond_destroy(&pPrefetcher->condition);
+    pthread_mutex_destroy(&pPrefetcher->mutex);
+    pPrefetcher->isEnabled = false;
+}
+void destroyPrefetch(Prefetch* pPrefetch) {
+    if (pPrefetch->state == LOADED_PREFETCH) {
+        if (pPrefetch->isMapped)
+            munmap(pPrefetch->pData, pPrefetch->length);
+        else
+            free(pPrefetch->pData);
+    }
+    destroyString(pPrefetch->path);
+    destroyString(pPrefetch->directoryPath);
+    free(pPrefetch);
+}
+Prefetch* prefetcher_find(String path, uint64_t pathHash) {
+    if (prefetcher.bucketCount == 0)
+        return NULL;
+    size_t mask = prefetcher.bucketCount - 1;
+    for (size_t i = pathHash & mask; prefetcher.ppBuckets[i] != NULL; i = (i + 1) & mask) {
+        Prefetch* pPrefetch = prefetcher.ppBuckets[i];
+        if (pPrefetch->pathHash == pathHash && string_equals(pPrefetch->path, path))
+            return pPrefetch;
+    }
+    return NULL;
+}
+bool prefetcher_insert(Prefetch* pPrefetch) {
+    if (prefetcher.prefetchCount == prefetcher.prefetchCapacity) {
+        size_t prefetchCapacity = prefetcher.prefetchCapacity == 0 ? 64 : 2 * prefetcher.prefetchCapacity;
+        Prefetch** ppNewPrefetches = realloc(prefetcher.ppPrefetches, prefetchCapacity * sizeof(Prefetch*));
+        if (ppNewPrefetches == NULL)
+            throw(prefetchesReallocError);
+        prefetcher.ppPrefetches = ppNewPrefetches;
+        prefetcher.prefetchCapacity = prefetchCapacity;
+    }
+    if (2 * (prefetcher.prefetchCount + 1) > prefetcher.bucketCount) {
+        size_t bucketCount = prefetcher.bucketCount == 0 ? 128 : 2 * prefetcher.bucketCount;
+        Prefetch** ppBuckets = calloc(bucketCount, sizeof(Prefetch*));
+        if (ppBuckets == NULL)
+            throw(bucketsCallocError);
+        for (size_t i = 0; i < prefetcher.prefetchCount; i++) {
+            size_t j = prefetcher.ppPrefetches[i]->pathHash & (bucketCount - 1);
+            while (ppBuckets[j] != NULL)
+                j = (j + 1) & (bucketCount - 1);
+            ppBuckets[j] = prefetcher.ppPrefetches[i];
         }
-        for (size_t j = 0; j < matrix.destructorCount; j++) {
-            Destructor* pDestructor = &matrix.pDestructors[j];
-            if (pDestructor->depth == depth)
-                pDestructor->depth--;
+        free(prefetcher.ppBuckets);
+        prefetcher.ppBuckets = ppBuckets;
+        prefetcher.bucketCount = bucketCount;
+    }
+    size_t i = pPrefetch->pathHash & (prefetcher.bucketCount - 1);
+    while (prefetcher.ppBuckets[i] != NULL)
+        i = (i + 1) & (prefetcher.bucketCount - 1);
+    prefetcher.ppBuckets[i] = pPrefetch;
+    prefetcher.ppPrefetches[prefetcher.prefetchCount] = pPrefetch;
+    prefetcher.prefetchCount++;
+    return true;
+    
+bucketsCallocError:
+prefetchesReallocError:
+    return false;
+}
+bool prefetcher_request(String directoryPath, char const* pName, size_t nameLength) {
+    if (!prefetcher.isEnabled)
+        return true;
+    String name = {.length = nameLength, .pData = (char*) pName};
+    String nameCopy = {.length = 0, .pData = NULL};
+    if (!string_duplicate(name, &nameCopy))
+        throw(nameDuplicateError);
+    String path;
+    if (!directory_join((Directory) {.descriptor = -1, .path = directoryPath}, nameCopy.pData, &path))
+        throw(pathJoinError);
+    destroyString(nameCopy);
+    uint64_t pathHash = string_hash(path);
+    
+    pthread_mutex_lock(&prefetcher.mutex);
+    if (prefetcher_find(path, pathHash) != NULL) {
+        pthread_mutex_unlock(&prefetcher.mutex);
+        destroyString(path);
+        return true;
+    }
+    String directoryPathCopy;
+    if (!string_duplicate(directoryPath, &directoryPathCopy))
+        throw(directoryPathDuplicateError);
+    Prefetch* pPrefetch = malloc(sizeof(Prefetch));
+    if (pPrefetch == NULL)
+        throw(prefetchMallocError);
+    *pPrefetch = (Prefetch) {
+        .path = path,
+        .pathHash = pathHash,
+        .directoryPath = directoryPathCopy,
+        .state = PENDING_PREFETCH,
+        .pData = NULL,
+        .length = 0,
+        .isMapped = false
+    };
+    if (!prefetcher_insert(pPrefetch))
+        throw(prefetchInsertError);
+    pthread_cond_broadcast(&prefetcher.condition);
+    pthread_mutex_unlock(&prefetcher.mutex);
+    return true;
+    
+prefetchInsertError:
+    free(pPrefetch);
+prefetchMallocError:
+    destroyString(directoryPathCopy);
+directoryPathDuplicateError:
+    pthread_mutex_unlock(&prefetcher.mutex);
+    destroyString(path);
+    return false;
+    
+pathJoinError:
+    destroyString(nameCopy);
+nameDuplicateError:
+    return false;
+}
+bool prefetch_load(Prefetch* pPrefetch) {
+    int fileDescriptor = open(pPrefetch->path.pData, O_RDONLY | O_CLOEXEC);
+    if (fileDescriptor == -1)
+        goto fileOpenError;
+    if (fstat(fileDescriptor, &pPrefetch->fileStat) == -1)
+        goto fileStatError;
+    if (S_ISDIR(pPrefetch->fileStat.st_mode)) {
+        close(fileDescriptor);
+        char* pDirectoryName = realpath(pPrefetch->path.pData, NULL);
+        if (pDirectoryName != NULL) {
+            prefetcher_request(
+                (String) {.length = strlen(pDirectoryName), .pData = pDirectoryName},
+                MAIN_FILE_NAME, strlen(MAIN_FILE_NAME)
+            );
+            free(pDirectoryName);
         }
+        return false;
+    }
+    
+    size_t length = (size_t) pPrefetch->fileStat.st_size;
+    char* pData;
+    bool isMapped;
+    if (!file_load(fileDescriptor, length, &pData, &isMapped))
+        goto fileLoadError;
+    if (isMapped) {
+        volatile char const* pPages = pData;
+        for (size_t i = 0; i < length; i += PREFETCH_PAGE_SIZE)
+            (void) pPages[i];
     }
+    close(fileDescriptor);
+    
+    pPrefetch->pData = pData;
+    pPrefetch->length = length;
+    pPrefetch->isMapped = isMapped;
     return true;
     
-newNameDataMallocError:
+fileLoadError:
+fileStatError:
+    close(fileDescriptor);
+fileOpenError:
     return false;
 }
-bool module_validate(Module module, size_t depth) {
-    for (size_t i = 0; i < module.matrixCount; i++) {
-        Constructor typeConstructor = module.pMatrices[0].pConstructors[i];
-        Matrix matrix = module.pMatrices[i];
-        for (size_t j = 0; j < matrix.destructorCount; j++) {
-            Destructor destructor = matrix.pDestructors[j];
-            for (size_t k = 0; k < matrix.constructorCount; k++) {
-                Constructor constructor = matrix.pConstructors[k];
-                if (constructor.depth < depth)
-                    continue;
-                if (destructor.depth < depth)
-                    continue;
-                if (destructor.pRules[k].kind == UNSPECIFIED_EXPRESSION) {
-                    fprintf(
-                        stderr, "Unimplemented case found: %s [%s.%s]\n",
-                        typeConstructor.name.pData, constructor.name.pData, destructor.name.pData
-                    );
-                    return false;
-                }
-            }
+void prefetch_scan(Prefetch const* pPrefetch) {
+    char const* pData = pPrefetch->pData;
+    size_t length = pPrefetch->length;
+    size_t offset = 0;
+    while (offset < length) {
+        if (pData[offset] == '#') {
+            while (offset < length && pData[offset] != '\n')
+                offset++;
+            continue;
+        }
+        if (pData[offset] != '<') {
+            offset++;
+            continue;
         }
+        size_t start = offset + 1;
+        offset = start;
+        while (offset < length && pData[offset] != '<' && pData[offset] != '>')
+            offset++;
+        if (offset < length && pData[offset] == '>' && offset > start)
+            prefetcher_request(pPrefetch->directoryPath, &pData[start], offset - start);
+    }
+}
+void* prefetcher_work(void* pArgument) {
+    pthread_mutex_lock(&prefetcher.mutex);
+    while (true) {
+        while (!prefetcher.isStopping && prefetcher.nextIndex == prefetcher.prefetchCount)
+            pthread_cond_wait(&prefetcher.condition, &prefetcher.mutex);
+        if (prefetcher.isStopping)
+            break;
+        Prefetch* pPrefetch = prefetcher.ppPrefetches[prefetcher.nextIndex];
+        prefetcher.nextIndex++;
+        if (pPrefetch->state != PENDING_PREFETCH)
+            continue;
+        pPrefetch->state = LOADING_PREFETCH;
+        pthread_mutex_unlock(&prefetcher.mutex);
+        
+        bool isLoaded = prefetch_load(pPrefetch);
+        if (isLoaded)
+            prefetch_scan(pPrefetch);
+        
+        pthread_mutex_lock(&prefetcher.mutex);
+        pPrefetch->state = isLoaded ? LOADED_PREFETCH : FAILED_PREFETCH;
+        pthread_cond_broadcast(&prefetcher.condition);
+    }
+    pthread_mutex_unlock(&prefetcher.mutex);
+    return pArgument;
+}
+bool prefetch_isUnchanged(Prefetch const* pPrefetch, struct stat const* pFileStat) {
+#ifdef __APPLE__
+    struct timespec modified = pFileStat->st_mtimespec;
+    struct timespec prefetchModified = pPrefetch->fileStat.st_mtimespec;
+#else
+    struct timespec modified = pFileStat->st_mtim;
+    struct timespec prefetchModified = pPrefetch->fileStat.st_mtim;
+#endif
+    return pFileStat->st_dev == pPrefetch->fileStat.st_dev && pFileStat->st_ino == pPrefetch->fileStat.st_ino
+        && pFileStat->st_size == pPrefetch->fileStat.st_size
+        && modified.tv_sec == prefetchModified.tv_sec && modified.tv_nsec == prefetchModified.tv_nsec;
+}
+bool prefetcher_take(Directory directory, char const* pFileName, Parser* pParser, bool* pIsTaken) {
+    *pIsTaken = false;
+    if (!prefetcher.isEnabled)
+        return true;
+    String path;
+    if (!directory_join(directory, pFileName, &path))
+        throw(pathJoinError);
+    uint64_t pathHash = string_hash(path);
+    
+    pthread_mutex_lock(&prefetcher.mutex);
+    Prefetch* pPrefetch = prefetcher_find(path, pathHash);
+    destroyString(path);
+    if (pPrefetch == NULL) {
+        pthread_mutex_unlock(&prefetcher.mutex);
+        return true;
+    }
+    bool isClaimed = pPrefetch->state == PENDING_PREFETCH;
+    if (isClaimed) {
+        pPrefetch->state = LOADING_PREFETCH;
+        pthread_mutex_unlock(&prefetcher.mutex);
+        bool isLoaded = prefetch_load(pPrefetch);
+        if (isLoaded)
+            prefetch_scan(pPrefetch);
+        pthread_mutex_lock(&prefetcher.mutex);
+        pPrefetch->state = isLoaded ? LOADED_PREFETCH : FAILED_PREFETCH;
     }
+    while (pPrefetch->state == LOADING_PREFETCH)
+        pthread_cond_wait(&prefetcher.condition, &prefetcher.mutex);
+    if (pPrefetch->state != LOADED_PREFETCH) {
+        pthread_mutex_unlock(&prefetcher.mutex);
+        return true;
+    }
+    pPrefetch->state = TAKEN_PREFETCH;
+    pthread_mutex_unlock(&prefetcher.mutex);
+    
+    struct stat fileStat;
+    if (!isClaimed && (
+        fstatat(directory.descriptor, pFileName, &fileStat, 0) == -1
+        || !prefetch_isUnchanged(pPrefetch, &fileStat)
+    )) {
+        if (pPrefetch->isMapped)
+            munmap(pPrefetch->pData, pPrefetch->length);
+        else
+            free(pPrefetch->pData);
+        return true;
+    }
+    *pParser = (Parser) {
+        .pData = pPrefetch->pData,
+        .length = pPrefetch->length,
+        .isMapped = pPrefetch->isMapped,
+        .offset = 0,
+        .next = pPrefetch->length > 0 ? (unsigned char) pPrefetch->pData[0] : EOF,
+        .directory = directory
+    };
+    *pIsTaken = true;
     return true;
+    
+pathJoinError:
+    return false;
 }
-
-bool parseFile(char const* pFileName, Module* pModule, size_t depth) {
+bool parseFile(Directory directory, char const* pFileName, Module* pModule, size_t depth) {
     struct stat fileStat;
-    stat(pFileName, &fileStat);
+    fstatat(directory.descriptor, pFileName, &fileStat, 0);
     
     if (S_ISDIR(fileStat.st_mode)) {
-        char* pDirectoryName = getcwd(NULL, 0);
-        if (pDirectoryName == NULL)
-            throw(directoryGetError);
-        if (chdir(pFileName) == -1)
-            throw(directoryChangeError);
+        Directory subdirectory;
+        if (!createDirectory(directory, pFileName, &subdirectory))
+            throw(directoryCreateError);
         
-        if (!parseFile(MAIN_FILE_NAME, pModule, depth + 1))
+        if (!parseFile(subdirectory, MAIN_FILE_NAME, pModule, depth + 1))
             throw(fileParseError);
         
-        if (chdir(pDirectoryName) == -1)
-            throw(directoryRestoreError);
-        free(pDirectoryName);
+        destroyDirectory(subdirectory);
         return true;
     
-    directoryRestoreError:
     fileParseError:
-    directoryChangeError:
-        free(pDirectoryName);
-    directoryGetError:
+        destroyDirectory(subdirectory);
+    directoryCreateError:
         return false;
     } else {
-        char* pDirectoryName;
+        size_t lineNumber;
+        size_t columnNumber;
         
         Parser parser;
-        if (!createParserFromFile(pFileName, &parser))
+        bool isPrefetched;
+        if (!prefetcher_take(directory, pFileName, &parser, &isPrefetched))
             throw(parserCreateError);
+        if (!isPrefetched) {
+            if (!createParserFromFile(directory, pFileName, &parser))
+                throw(parserCreateError);
+        }
+        
+        uint64_t contentHash = 0;
+        size_t dependencyStart = includeCache.dependencyCount;
+        size_t operationStart = pModule->operationCount;
+        uint64_t fingerprint = pModule->fingerprint;
+        size_t printCount = includeCache.printCount;
+        size_t parentCheckpoint = watch.activeCheckpoint;
+        if (includeCache.pDirectoryName != NULL || watch.isEnabled)
+            contentHash = string_hash((String) {.length = parser.length, .pData = parser.pData});
+        if (watch.isEnabled) {
+            if (!watch_addCheckpoint(directory, pFileName, depth, *pModule, contentHash))
+                throw(checkpointAddError);
+            watch.activeCheckpoint = watch.checkpointCount - 1;
+        }
+        uint64_t pathHash = 0;
+        if (includeCache.pDirectoryName != NULL) {
+            char* pPath;
+            if (!directory_resolve(directory, pFileName, &pPath))
+                throw(cachePathResolveError);
+            String path = {.length = strlen(pPath), .pData = pPath};
+            pathHash = string_hash(path);
+            bool isHit;
+            if (!includeCache_replay(pModule, contentHash, pathHash, depth, &isHit)) {
+                destroyString(path);
+                throw(cacheReplayError);
+            }
+            if (isHit) {
+                destroyString(path);
+                for (size_t i = dependencyStart; i < includeCache.dependencyCount && watch.isEnabled; i++) {
+                    Dependency dependency = includeCache.pDependencies[i];
+                    String path;
+                    if (!string_duplicate(dependency.path, &path))
+                        throw(cacheReplayError);
+                    if (!watch_addFile(path, dependency.contentHash, watch.activeCheckpoint)) {
+                        destroyString(path);
+                        throw(cacheReplayError);
+                    }
+                }
+                watch.activeCheckpoint = parentCheckpoint;
+                destroyParser(parser);
+                return true;
+            }
+            if (!includeCache_appendDependency(path, contentHash)) {
+                destroyString(path);
+                throw(cacheDependencyAddError);
+            }
+        }
+        bool isCapturing = includeCache.pDirectoryName != NULL && includeCache.fileDepth > 0;
+        Output parentOutput = output;
+        String printed = {.length = 0, .pData = NULL};
+        if (isCapturing && !createMemoryOutput(&output))
+            throw(outputCreateError);
         parser_skipWhitespace(&parser);
     
+        includeCache.fileDepth++;
         while (parser.next != EOF) {
             if (!parser_parseStatement(&parser, pModule, depth))
                 throw(statementParseError);
         }
+        includeCache.fileDepth--;
     
+        if (isCapturing && !includeCache_endCapture(parentOutput, &printed))
+            throw(captureEndError);
+        if (includeCache.pDirectoryName != NULL && (isCapturing || includeCache.printCount == printCount))
+            includeCache_store(
+                *pModule, contentHash, pathHash, fingerprint, depth, operationStart, dependencyStart, printed
+            );
+        destroyString(printed);
+        watch.activeCheckpoint = parentCheckpoint;
         destroyParser(parser);
         return true;
 
     statementParseError:
-        pDirectoryName = getcwd(NULL, 0);
-        if (pDirectoryName != NULL) {
-            fprintf(stderr, "Error encountered at %s/%s:%lu:%lu\n", pDirectoryName, pFileName, parser.lineNumber, parser.columnNumber);
-            free(pDirectoryName);
-        }
+        includeCache.fileDepth--;
+        if (isCapturing && includeCache_endCapture(parentOutput, &printed))
+            destroyString(printed);
+        parser_seekFailure(&parser);
+        parser_getLocation(parser, &lineNumber, &columnNumber);
+        fprintf(stderr, "Error encountered at %s/%s:%lu:%lu\n", directory.path.pData, pFileName, lineNumber, columnNumber);
+    captureEndError:
+    outputCreateError:
+    cacheDependencyAddError:
+    cacheReplayError:
+    cachePathResolveError:
+    checkpointAddError:
+        watch.activeCheckpoint = parentCheckpoint;
         destroyParser(parser);
     parserCreateError:
         return false;